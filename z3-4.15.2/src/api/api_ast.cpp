@@ -25,6 +25,7 @@ Revision History:
 #include "ast/array_decl_plugin.h"
 #include "ast/pb_decl_plugin.h"
 #include "ast/ast_translation.h"
+#include "ast/ast_serialize.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt_pp.h"
@@ -1080,6 +1081,46 @@ extern "C" {
         Z3_CATCH_RETURN("");
     }
 
+    Z3_char_ptr Z3_API Z3_serialize_ast(Z3_context c, Z3_ast a, unsigned* length) {
+        Z3_TRY;
+        LOG_Z3_serialize_ast(c, a, length);
+        RESET_ERROR_CODE();
+        if (!length) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "length argument is null");
+            return "";
+        }
+        CHECK_VALID_AST(a, "");
+        std::string out;
+        ast* n = to_ast(a);
+        serialize_asts(mk_c(c)->m(), 1, &n, out);
+        auto& buffer = mk_c(c)->m_char_buffer;
+        buffer.reset();
+        buffer.append(static_cast<unsigned>(out.size()), out.data());
+        *length = buffer.size();
+        return buffer.data();
+        Z3_CATCH_RETURN("");
+    }
+
+    Z3_ast Z3_API Z3_deserialize_ast(Z3_context c, unsigned length, Z3_string data) {
+        Z3_TRY;
+        LOG_Z3_deserialize_ast(c, length, data);
+        RESET_ERROR_CODE();
+        if (!data && length > 0) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "data argument is null");
+            RETURN_Z3(nullptr);
+        }
+        ast_manager& m = mk_c(c)->m();
+        ast_ref_vector roots(m);
+        deserialize_asts(m, data, length, roots);
+        if (roots.size() != 1) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "expected a single serialized AST");
+            RETURN_Z3(nullptr);
+        }
+        mk_c(c)->save_ast_trail(roots.get(0));
+        RETURN_Z3(of_ast(roots.get(0)));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_decl_kind Z3_API Z3_get_decl_kind(Z3_context c, Z3_func_decl d) {
         Z3_TRY;
         LOG_Z3_get_decl_kind(c, d);
@@ -27,6 +27,7 @@ Revision History:
 #include "api/api_util.h"
 #include "ast/reg_decl_plugins.h"
 #include "math/realclosure/realclosure.h"
+#include "model/model_tape.h"
 
 
 // The install_tactics procedure is automatically generated
@@ -359,6 +360,18 @@ namespace api {
         return *(m_rcf_manager.get());
     }
 
+    // ------------------------
+    //
+    // Compiled model evaluation
+    //
+    // -----------------------
+    model_tape & context::get_model_tape() {
+        if (m_model_tape.get() == nullptr) {
+            m_model_tape = alloc(model_tape, m());
+        }
+        return *(m_model_tape.get());
+    }
+
 };
 
 
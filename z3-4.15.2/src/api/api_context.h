@@ -42,6 +42,8 @@ Revision History:
 #include "api/api_util.h"
 #include "api/api_polynomial.h"
 
+class model_tape;
+
 namespace smtlib {
     class parser;
 };
@@ -272,6 +274,16 @@ namespace api {
     public:
         realclosure::manager & rcfm();
 
+        // ------------------------
+        //
+        // Compiled model evaluation
+        //
+        // -----------------------
+    private:
+        scoped_ptr<model_tape>           m_model_tape;
+    public:
+        model_tape & get_model_tape();
+
         // ------------------------
         //
         // Solver interface for backward compatibility 
@@ -24,6 +24,7 @@ Revision History:
 #include "model/model.h"
 #include "model/model_v2_pp.h"
 #include "model/model_smt2_pp.h"
+#include "model/model_tape.h"
 #include "model/model_params.hpp"
 #include "model/model_evaluator_params.hpp"
 
@@ -172,6 +173,42 @@ extern "C" {
         Z3_CATCH_RETURN(false);
     }
 
+    bool Z3_API Z3_model_eval_batch(Z3_context c, Z3_model m, unsigned num_exprs, Z3_ast const ts[], bool model_completion, Z3_ast vs[]) {
+        Z3_TRY;
+        LOG_Z3_model_eval_batch(c, m, num_exprs, ts, model_completion, vs);
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, false);
+        for (unsigned i = 0; i < num_exprs; ++i) {
+            vs[i] = nullptr;
+            CHECK_IS_EXPR(ts[i], false);
+        }
+        model * _m = to_model_ref(m);
+        ast_manager& mgr = mk_c(c)->m();
+        expr * const * es = reinterpret_cast<expr * const *>(ts);
+        model_tape & tape = mk_c(c)->get_model_tape();
+        if (!tape.has_roots(num_exprs, es)) {
+            tape.reset();
+            for (unsigned i = 0; i < num_exprs; ++i)
+                tape.add(es[i]);
+        }
+        tape(*_m, model_completion);
+        mk_c(c)->reset_last_result();
+        expr_ref result(mgr);
+        for (unsigned i = 0; i < num_exprs; ++i) {
+            if (!tape.get_value(i, result)) {
+                params_ref p;
+                if (!_m->has_solver())
+                    _m->set_solver(alloc(api::seq_expr_solver, mgr, p));
+                model::scoped_model_completion _scm(*_m, model_completion);
+                result = (*_m)(es[i]);
+            }
+            mk_c(c)->save_multiple_ast_trail(result.get());
+            vs[i] = of_ast(result.get());
+        }
+        RETURN_Z3_model_eval_batch true;
+        Z3_CATCH_RETURN(false);
+    }
+
     unsigned Z3_API Z3_model_get_num_sorts(Z3_context c, Z3_model m) {
         Z3_TRY;
         LOG_Z3_model_get_num_sorts(c, m);
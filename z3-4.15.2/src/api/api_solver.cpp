@@ -45,6 +45,7 @@ Revision History:
 #include "sat/tactic/sat2goal.h"
 #include "cmd_context/extra_cmds/proof_cmds.h"
 #include "solver/simplifier_solver.h"
+#include "solver/cache_solver.h"
 
 
 extern "C" {
@@ -147,6 +148,7 @@ extern "C" {
         params_ref p = s->m_params;
         mk_c(c)->params().get_solver_params(p, proofs_enabled, models_enabled, unsat_core_enabled);
         s->m_solver = (*(s->m_solver_factory))(mk_c(c)->m(), p, proofs_enabled, models_enabled, unsat_core_enabled, s->m_logic);
+        s->m_solver = mk_cache_solver(s->m_solver.get());
         
         param_descrs r;
         s->m_solver->collect_param_descrs(r);
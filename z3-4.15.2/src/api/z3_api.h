@@ -5519,6 +5519,24 @@ extern "C" {
     */
     bool Z3_API Z3_model_eval(Z3_context c, Z3_model m, Z3_ast t, bool model_completion, Z3_ast * v);
 
+    /**
+       \brief Evaluate the AST nodes \c ts in the given model.
+       Return \c true if succeeded, and store the results in \c vs.
+
+       The result is the same as calling #Z3_model_eval on each of \c ts.
+       Terms over Booleans, arithmetic, bit-vectors of width at most 64,
+       uninterpreted functions and select on array constants are compiled
+       into an instruction sequence that is evaluated without rewriting.
+       The compiled form is kept in the context and reused when the same
+       sequence of terms is evaluated again, possibly in a different model.
+       Other terms are evaluated using #Z3_model_eval.
+
+       \sa Z3_model_eval
+
+       def_API('Z3_model_eval_batch', BOOL, (_in(CONTEXT), _in(MODEL), _in(UINT), _in_array(2, AST), _in(BOOL), _out_array(2, AST)))
+    */
+    bool Z3_API Z3_model_eval_batch(Z3_context c, Z3_model m, unsigned num_exprs, Z3_ast const ts[], bool model_completion, Z3_ast vs[]);
+
     /**
        \brief Return the interpretation (i.e., assignment) of constant \c a in the model \c m.
        Return \c NULL, if the model does not assign an interpretation for \c a.
@@ -5950,6 +5968,42 @@ extern "C" {
                                                    Z3_ast const assumptions[],
                                                    Z3_ast formula);
 
+    /**
+       \brief Serialize the given AST into a compact binary format.
+
+       Shared sub-terms, sorts and declarations are stored once.
+       The result can be read back using #Z3_deserialize_ast, also in
+       a different context or process. Theory sorts and operators are
+       stored by name, datatype declarations, polymorphic declarations
+       and algebraic numbers are not supported.
+
+       \warning The result buffer is statically allocated by Z3. It will
+       be automatically deallocated when #Z3_del_context is invoked.
+       So, the buffer is invalidated in the next call to \c Z3_serialize_ast.
+
+       \param c - context.
+       \param a - AST to serialize.
+       \param length - receives the length of the result in bytes. The result may contain null bytes.
+
+       \sa Z3_deserialize_ast
+
+       def_API('Z3_serialize_ast', CHAR_PTR, (_in(CONTEXT), _in(AST), _out(UINT)))
+    */
+    Z3_char_ptr Z3_API Z3_serialize_ast(Z3_context c, Z3_ast a, unsigned* length);
+
+    /**
+       \brief Reconstruct an AST from the output of #Z3_serialize_ast.
+
+       \param c - context.
+       \param length - length of \c data in bytes.
+       \param data - serialized AST.
+
+       \sa Z3_serialize_ast
+
+       def_API('Z3_deserialize_ast', AST, (_in(CONTEXT), _in(UINT), _in(STRING)))
+    */
+    Z3_ast Z3_API Z3_deserialize_ast(Z3_context c, unsigned length, Z3_string data);
+
     /**@}*/
 
     /** @name Parser interface */
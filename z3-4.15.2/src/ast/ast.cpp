@@ -30,6 +30,7 @@ Revision History:
 #include "ast/arith_decl_plugin.h"
 #include "ast/ast_translation.h"
 #include "util/z3_version.h"
+#include "util/mutex.h"
 #include <iostream>
 
 
@@ -1371,6 +1372,7 @@ static void mark_array_ref(ast_mark& mark, unsigned sz, parameter const * a) {
 
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
+    set_concurrent(false);
 
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
@@ -1455,6 +1457,8 @@ ast_manager::~ast_manager() {
 }
 
 void ast_manager::compact_memory() {
+    if (m_concurrent)
+        return;
     m_alloc.consolidate();
     unsigned capacity = m_ast_table.capacity();
     if (capacity > 4*m_ast_table.size()) {
@@ -1471,6 +1475,7 @@ void ast_manager::compact_memory() {
 }
 
 void ast_manager::compress_ids() {
+    SASSERT(!m_concurrent);
     ptr_vector<ast> asts;
     m_expr_id_gen.cleanup();
     m_decl_id_gen.cleanup(c_first_decl_id);
@@ -1688,6 +1693,8 @@ static void track_id(ast_manager& m, ast* n, unsigned id) {
 ast * ast_manager::register_node_core(ast * n) {
     unsigned h = get_node_hash(n);
     n->m_hash = h;
+    if (m_concurrent)
+        return concurrent_register_node(n);
 #ifdef Z3DEBUG
     bool contains = m_ast_table.contains(n);
     CASSERT("nondet_bug", contains || slow_not_contains(n));
@@ -1719,6 +1726,11 @@ ast * ast_manager::register_node_core(ast * n) {
     
 //    TRACE(ast, tout << (s_count++) << " Object " << n->m_id << " was created.\n";);
     TRACE(mk_var_bug, tout << "mk_ast: " << n->m_id << "\n";);
+    init_node(n);
+    return n;
+}
+
+void ast_manager::init_node(ast * n) {
     // increment reference counters
     switch (n->get_kind()) {
     case AST_SORT:
@@ -1799,7 +1811,6 @@ ast * ast_manager::register_node_core(ast * n) {
     default:
         break;
     }
-    return n;
 }
 
 
@@ -1808,8 +1819,12 @@ void ast_manager::delete_node(ast * n) {
 
     SASSERT(m_ast_table.contains(n));
     m_ast_table.push_erase(n);
+    delete_erased_nodes();
+}
 
-    while ((n = m_ast_table.pop_erase())) {
+void ast_manager::delete_erased_nodes() {
+    ast * n;
+    while ((n = m_concurrent ? concurrent_pop_erase() : m_ast_table.pop_erase())) {
 
         CTRACE(del_quantifier, is_quantifier(n), tout << "deleting quantifier " << n->m_id << " " << n << "\n";);
         TRACE(mk_var_bug, tout << "del_ast: " << " " << n->m_ref_count << "\n";);
@@ -1879,8 +1894,156 @@ void ast_manager::delete_node(ast * n) {
 }
 
 
+// -----------------------------------
+//
+// concurrent mode
+//
+// -----------------------------------
+
+struct ast_manager::concurrent_state {
+    static const unsigned c_log_num_shards = 6;
+    struct shard {
+        mutex     m_mux;
+        ast_table m_table;
+        // nodes of this shard whose reference count dropped to zero.
+        obj_hashtable<ast> m_dead;
+        shard(): m_table(16 * 1024, 1024) {}
+    };
+    shard           m_shards[1 << c_log_num_shards];
+    mutex           m_alloc_mux;
+    mutex           m_id_mux;
+    ptr_vector<ast> m_erased;
+#ifdef SINGLE_THREAD
+    mutex           m_plugin_mux;
+#else
+    std::recursive_mutex m_plugin_mux;
+#endif
+
+    // chashtable selects slots by the low bits of the hash, so shards use the high bits.
+    shard & get_shard(unsigned h) { return m_shards[h >> (32 - c_log_num_shards)]; }
+};
+
+void ast_manager::set_concurrent(bool f) {
+    if (f == is_concurrent())
+        return;
+    if (f) {
+#ifdef SINGLE_THREAD
+        throw default_exception("concurrent ast manager is not available in single threaded builds");
+#endif
+        m_concurrent = alloc(concurrent_state);
+        for (ast * n : m_ast_table)
+            m_concurrent->get_shard(n->hash()).m_table.insert(n);
+        m_ast_table.reset();
+        m_alloc.set_mutex(&m_concurrent->m_alloc_mux);
+        return;
+    }
+    reclaim_dead_nodes();
+    concurrent_state * st = m_concurrent;
+    m_concurrent = nullptr;
+    m_alloc.set_mutex(nullptr);
+    for (auto & sh : st->m_shards)
+        for (ast * n : sh.m_table)
+            m_ast_table.insert(n);
+    dealloc(st);
+}
+
+void ast_manager::reclaim_dead_nodes() {
+    if (!m_concurrent)
+        return;
+    // A listed node may have been revived after its count dropped to zero.
+    // Pin the nodes that are still unreferenced before deleting any of
+    // them, so that deleting one does not free a listed node that is
+    // visited later.
+    ptr_vector<ast> dead;
+    for (auto & sh : m_concurrent->m_shards) {
+        for (ast * n : sh.m_dead) {
+            if (n->get_ref_count() == 0) {
+                n->inc_ref();
+                dead.push_back(n);
+            }
+        }
+        sh.m_dead.reset();
+    }
+    for (ast * n : dead)
+        push_dec_ref(n);
+    delete_erased_nodes();
+}
+
+void ast_manager::concurrent_push_erase(ast * n) {
+    m_concurrent->get_shard(n->hash()).m_table.erase(n);
+    m_concurrent->m_erased.push_back(n);
+}
+
+ast * ast_manager::concurrent_pop_erase() {
+    auto & erased = m_concurrent->m_erased;
+    if (erased.empty())
+        return nullptr;
+    ast * n = erased.back();
+    erased.pop_back();
+    return n;
+}
+
+ast * ast_manager::concurrent_register_node(ast * n) {
+    auto & sh = m_concurrent->get_shard(n->hash());
+    // the shard stays locked until n is initialized, so other threads
+    // only find it once its id and children references are set.
+    lock_guard lock(sh.m_mux);
+    ast * r = sh.m_table.insert_if_not_there(n);
+    if (r != n) {
+        if (is_func_decl(r) && to_func_decl(r)->get_range() != to_func_decl(n)->get_range()) {
+            std::ostringstream buffer;
+            buffer << "Recycling of declaration for the same name '" << to_func_decl(r)->get_name().str()
+                   << "' and domain, but different range type is not permitted";
+            throw ast_exception(buffer.str());
+        }
+        deallocate_node(n, ::get_node_size(n));
+        return r;
+    }
+    {
+        lock_guard id_lock(m_concurrent->m_id_mux);
+        n->m_id = is_decl(n) ? m_decl_id_gen.mk() : m_expr_id_gen.mk();
+    }
+    init_node(n);
+    return n;
+}
+
+void ast_manager::concurrent_dec_ref(ast * n) {
+    SASSERT(n->get_ref_count() > 0);
+    if (std::atomic_ref<unsigned>(n->m_ref_count).fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+    // n stays in the table and can be revived by a thread that hash-conses
+    // the same term. It is reclaimed by reclaim_dead_nodes.
+    auto & sh = m_concurrent->get_shard(n->hash());
+    lock_guard lock(sh.m_mux);
+    sh.m_dead.insert(n);
+}
+
+bool ast_manager::concurrent_contains(ast * n) const {
+    auto & sh = m_concurrent->get_shard(n->hash());
+    lock_guard lock(sh.m_mux);
+    return sh.m_table.contains(n);
+}
+
+unsigned ast_manager::concurrent_num_asts() const {
+    unsigned sz = 0;
+    for (auto & sh : m_concurrent->m_shards) {
+        lock_guard lock(sh.m_mux);
+        sz += sh.m_table.size();
+    }
+    return sz;
+}
+
+void ast_manager::lock_plugins() {
+    m_concurrent->m_plugin_mux.lock();
+}
+
+void ast_manager::unlock_plugins() {
+    m_concurrent->m_plugin_mux.unlock();
+}
+
 sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters) {
     decl_plugin * p = get_plugin(fid);
+    plugin_lock lock(*this);
     if (p)
         return p->mk_sort(k, num_parameters, parameters);
     return nullptr;
@@ -1889,6 +2052,7 @@ sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters,
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned arity, sort * const * domain, sort * range) {
     decl_plugin * p = get_plugin(fid);
+    plugin_lock lock(*this);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, arity, domain, range);
     return nullptr;
@@ -1897,6 +2061,7 @@ func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_p
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned num_args, expr * const * args, sort * range) {
     decl_plugin * p = get_plugin(fid);
+    plugin_lock lock(*this);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, num_args, args, range);
     return nullptr;
@@ -2276,8 +2441,9 @@ func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const
     SASSERT(skolem == info.is_skolem());
     func_decl_info* infop = skolem ? &info : nullptr;
     func_decl * d;
+    unsigned id = next_fresh_id();
     if (prefix == symbol::null && suffix == symbol::null) {
-        d = mk_func_decl(symbol(m_fresh_id), arity, domain, range, infop);
+        d = mk_func_decl(symbol(id), arity, domain, range, infop);
     }
     else {
         string_buffer<64> buffer;
@@ -2288,10 +2454,9 @@ func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const
         buffer << "!";
         if (suffix != symbol::null)
             buffer << suffix << "!";
-        buffer << m_fresh_id;
+        buffer << id;
         d = mk_func_decl(symbol(buffer.c_str()), arity, domain, range, infop);
     }
-    m_fresh_id++;
     SASSERT(!skolem || d->get_info());
     SASSERT(skolem == d->is_skolem());
     return d;
@@ -47,6 +47,7 @@ Revision History:
 #include "util/z3_exception.h"
 #include "util/dependency.h"
 #include "util/rlimit.h"
+#include <atomic>
 #include <variant>
 
 #define RECYCLE_FREE_AST_INDICES
@@ -993,7 +994,7 @@ class ast_translation;
 
 class ast_table : public chashtable<ast*, obj_ptr_hash<ast>, ast_eq_proc> {
 public:
-    ast_table() : chashtable({}, {}, 512 * 1024, 8 * 1024) {}
+    ast_table(unsigned init_slots = 512 * 1024, unsigned init_cellar = 8 * 1024) : chashtable({}, {}, init_slots, init_cellar) {}
     void push_erase(ast * n);
     ast* pop_erase();
 };
@@ -1497,7 +1498,7 @@ public:
 
     void update_fresh_id(ast_manager const& other);
 
-    unsigned mk_fresh_id() { return ++m_fresh_id; }
+    unsigned mk_fresh_id() { return next_fresh_id() + 1; }
 
 protected:
     reslimit                  m_limit;
@@ -1528,6 +1529,12 @@ protected:
     bool slow_not_contains(ast const * n);
 #endif
     ast_manager *             m_format_manager; // hack for isolating format objects in a different manager.
+    struct concurrent_state;
+    concurrent_state *        m_concurrent = nullptr;
+
+    unsigned next_fresh_id() {
+        return m_concurrent ? std::atomic_ref<unsigned>(m_fresh_id).fetch_add(1, std::memory_order_relaxed) : m_fresh_id++;
+    }
     symbol                    m_lambda_def = symbol(":lambda-def");
     obj_map<func_decl, func_decl*> m_poly_roots;
 
@@ -1639,7 +1646,7 @@ public:
 
     bool are_distinct(expr * a, expr * b) const;
 
-    bool contains(ast * a) const { return m_ast_table.contains(a); }
+    bool contains(ast * a) const { return m_concurrent ? concurrent_contains(a) : m_ast_table.contains(a); }
     
     bool is_lambda_def(quantifier* q) const { return q->get_qid() == m_lambda_def; }
     void add_lambda_def(func_decl* f, quantifier* q);
@@ -1649,17 +1656,72 @@ public:
 
     symbol const& lambda_def_qid() const { return m_lambda_def; }
 
-    unsigned get_num_asts() const { return m_ast_table.size(); }
+    unsigned get_num_asts() const { return m_concurrent ? concurrent_num_asts() : m_ast_table.size(); }
+
+    /**
+       \brief Enable or disable concurrent mode.
+
+       In concurrent mode several threads may create terms and update
+       reference counts of terms in this manager at the same time.
+       Hash-consing goes through a table that is sharded by node hash
+       with one lock per shard, reference counts are updated atomically,
+       and the node allocator and id generators are serialized.
+
+       Declarations made through the plugins (mk_sort, mk_func_decl and
+       mk_app with a family id, numerals) all go through one lock, so
+       threads that build many built-in terms contend on it.  Applying a
+       func_decl that was created up front only takes a shard lock.
+
+       Nodes whose reference count drops to zero stay in the table and
+       are deleted by reclaim_dead_nodes or when the manager leaves
+       concurrent mode.
+
+       Marks stored in nodes (ast_fast_mark, shared_occs) are not
+       protected and must not be used on shared nodes concurrently.
+       The solvers do not use this mode; it only covers term creation
+       and reference counting.  The mode must be switched while no
+       other thread uses the manager.
+    */
+    void set_concurrent(bool f);
+
+    /**
+       \brief Delete the nodes whose reference count dropped to zero in
+       concurrent mode. It is a safe point: no other thread may use the
+       manager during the call.
+    */
+    void reclaim_dead_nodes();
+
+    bool is_concurrent() const { return m_concurrent != nullptr; }
+
+    /**
+       \brief Serialize access to lazily populated plugin state when the
+       manager is in concurrent mode. No-op otherwise.
+    */
+    class plugin_lock {
+        ast_manager & m;
+        bool          m_locked;
+    public:
+        plugin_lock(ast_manager & m): m(m), m_locked(m.m_concurrent != nullptr) { if (m_locked) m.lock_plugins(); }
+        ~plugin_lock() { if (m_locked) m.unlock_plugins(); }
+    };
 
     void debug_ref_count() { m_debug_ref_count = true; }
 
     void inc_ref(ast* n) {
-        if (n) 
+        if (!n)
+            return;
+        if (m_concurrent)
+            std::atomic_ref<unsigned>(n->m_ref_count).fetch_add(1, std::memory_order_relaxed);
+        else
             n->inc_ref();
     }
     
     void dec_ref(ast* n) {
-        if (n) {
+        if (!n)
+            return;
+        if (m_concurrent)
+            concurrent_dec_ref(n);
+        else {
             n->dec_ref();
             if (n->get_ref_count() == 0)
                 delete_node(n);
@@ -1691,6 +1753,26 @@ public:
 protected:
     ast * register_node_core(ast * n);
 
+    ast * concurrent_register_node(ast * n);
+
+    void init_node(ast * n);
+
+    void concurrent_dec_ref(ast * n);
+
+    void concurrent_push_erase(ast * n);
+
+    ast * concurrent_pop_erase();
+
+    void delete_erased_nodes();
+
+    bool concurrent_contains(ast * n) const;
+
+    unsigned concurrent_num_asts() const;
+
+    void lock_plugins();
+
+    void unlock_plugins();
+
     template<typename T>
     T * register_node(T * n) {
         return static_cast<T *>(register_node_core(n));
@@ -2400,7 +2482,10 @@ private:
     void push_dec_ref(ast * n) {
         n->dec_ref();
         if (n->get_ref_count() == 0) {
-            m_ast_table.push_erase(n);
+            if (m_concurrent)
+                concurrent_push_erase(n);
+            else
+                m_ast_table.push_erase(n);
         }
     }
 
@@ -0,0 +1,704 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.cpp
+
+Abstract:
+
+    Compact binary serialization of ASTs.
+
+    header:     "Z3AB" version
+    record:     SORT name family kind size private params
+              | USORT name params
+              | DECL name arity domain* range flags [family kind params]
+              | APP decl num_args arg*
+              | VAR idx sort
+              | QUANT kind num_decls (sort name)* body weight qid skid
+                      num_patterns pattern* num_no_patterns no_pattern*
+    trailer:    END num_roots root*
+
+    References to nodes are indices into the record sequence.
+    Symbol references are 0 for the null symbol, 1 and 2 for a new
+    string or numerical symbol that follows inline, and 3 + i for the
+    i'th symbol introduced so far.
+
+--*/
+#include <cstring>
+#include "ast/ast_serialize.h"
+#include "util/map.h"
+#include "util/zstring.h"
+
+namespace {
+
+    const char     ser_magic[4] = { 'Z', '3', 'A', 'B' };
+    const unsigned ser_version  = 1;
+
+    enum record_kind {
+        R_END = 0,
+        R_SORT,
+        R_USORT,
+        R_DECL,
+        R_APP,
+        R_VAR,
+        R_QUANT
+    };
+
+    enum symbol_ref {
+        S_NULL = 0,
+        S_NEW_STRING,
+        S_NEW_NUM,
+        S_BASE
+    };
+
+    enum decl_flags {
+        D_INFO         = 1 << 0,
+        D_LEFT_ASSOC   = 1 << 1,
+        D_RIGHT_ASSOC  = 1 << 2,
+        D_FLAT_ASSOC   = 1 << 3,
+        D_COMMUTATIVE  = 1 << 4,
+        D_CHAINABLE    = 1 << 5,
+        D_PAIRWISE     = 1 << 6,
+        D_INJECTIVE    = 1 << 7,
+        D_IDEMPOTENT   = 1 << 8,
+        D_SKOLEM       = 1 << 9
+    };
+
+    enum sort_size_kind {
+        Z_FINITE = 0,
+        Z_VERY_BIG,
+        Z_INFINITE
+    };
+
+    class writer {
+        ast_manager &                 m;
+        std::string &                 m_out;
+        obj_map<ast, unsigned>        m_ids;
+        map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> m_symbols;
+        svector<std::pair<ast*, bool>> m_todo;
+
+        void write_byte(unsigned b) { m_out.push_back(static_cast<char>(b)); }
+
+        void write_uint(uint64_t v) {
+            while (v >= 0x80) {
+                m_out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+                v >>= 7;
+            }
+            m_out.push_back(static_cast<char>(v));
+        }
+
+        void write_int(int64_t v) {
+            write_uint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+        }
+
+        void write_ref(ast * n) { write_uint(m_ids[n]); }
+
+        void write_symbol(symbol const & s) {
+            unsigned idx;
+            if (s.is_null())
+                write_uint(S_NULL);
+            else if (m_symbols.find(s, idx))
+                write_uint(S_BASE + idx);
+            else {
+                m_symbols.insert(s, m_symbols.size());
+                if (s.is_numerical()) {
+                    write_uint(S_NEW_NUM);
+                    write_uint(s.get_num());
+                }
+                else {
+                    size_t len = strlen(s.bare_str());
+                    write_uint(S_NEW_STRING);
+                    write_uint(len);
+                    m_out.append(s.bare_str(), len);
+                }
+            }
+        }
+
+        // natural numbers below 2^63 are written as 2n,
+        // others as 2k+1 followed by k 64-bit limbs, least significant first.
+        void write_nat(rational const & n) {
+            SASSERT(!n.is_neg());
+            if (n.is_uint64() && n.get_uint64() < (1ull << 63)) {
+                write_uint(n.get_uint64() << 1);
+                return;
+            }
+            svector<uint64_t> limbs;
+            rational r(n), base = rational::power_of_two(64);
+            while (!r.is_zero()) {
+                limbs.push_back(mod(r, base).get_uint64());
+                r = div(r, base);
+            }
+            write_uint((static_cast<uint64_t>(limbs.size()) << 1) | 1);
+            for (uint64_t l : limbs)
+                write_uint(l);
+        }
+
+        void write_rational(rational const & r) {
+            write_byte(r.is_neg() ? 1 : 0);
+            write_nat(abs(numerator(r)));
+            write_nat(denominator(r));
+        }
+
+        void write_params(decl * d) {
+            write_uint(d->get_num_parameters());
+            for (parameter const & p : d->parameters()) {
+                write_byte(p.get_kind());
+                switch (p.get_kind()) {
+                case parameter::PARAM_INT:
+                    write_int(p.get_int());
+                    break;
+                case parameter::PARAM_AST:
+                    write_ref(p.get_ast());
+                    break;
+                case parameter::PARAM_SYMBOL:
+                    write_symbol(p.get_symbol());
+                    break;
+                case parameter::PARAM_ZSTRING: {
+                    zstring const & s = p.get_zstring();
+                    write_uint(s.length());
+                    for (unsigned i = 0; i < s.length(); ++i)
+                        write_uint(s[i]);
+                    break;
+                }
+                case parameter::PARAM_RATIONAL:
+                    write_rational(p.get_rational());
+                    break;
+                case parameter::PARAM_DOUBLE: {
+                    double d = p.get_double();
+                    uint64_t bits;
+                    memcpy(&bits, &d, sizeof(bits));
+                    for (unsigned i = 0; i < 8; ++i)
+                        write_byte(static_cast<unsigned>((bits >> (8 * i)) & 0xff));
+                    break;
+                }
+                default:
+                    throw default_exception("cannot serialize " + d->get_name().str() + ": unsupported parameter");
+                }
+            }
+        }
+
+        void push_params(decl * d) {
+            for (parameter const & p : d->parameters())
+                if (p.is_ast())
+                    m_todo.push_back({ p.get_ast(), false });
+        }
+
+        void push_children(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT:
+                push_params(to_sort(n));
+                break;
+            case AST_FUNC_DECL: {
+                func_decl * f = to_func_decl(n);
+                push_params(f);
+                m_todo.push_back({ f->get_range(), false });
+                for (unsigned i = f->get_arity(); i-- > 0; )
+                    m_todo.push_back({ f->get_domain(i), false });
+                break;
+            }
+            case AST_APP: {
+                app * a = to_app(n);
+                for (unsigned i = a->get_num_args(); i-- > 0; )
+                    m_todo.push_back({ a->get_arg(i), false });
+                m_todo.push_back({ a->get_decl(), false });
+                break;
+            }
+            case AST_VAR:
+                m_todo.push_back({ to_var(n)->get_sort(), false });
+                break;
+            case AST_QUANTIFIER: {
+                quantifier * q = to_quantifier(n);
+                for (unsigned i = q->get_num_no_patterns(); i-- > 0; )
+                    m_todo.push_back({ q->get_no_pattern(i), false });
+                for (unsigned i = q->get_num_patterns(); i-- > 0; )
+                    m_todo.push_back({ q->get_pattern(i), false });
+                m_todo.push_back({ q->get_expr(), false });
+                for (unsigned i = q->get_num_decls(); i-- > 0; )
+                    m_todo.push_back({ q->get_decl_sort(i), false });
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+        void write_sort(sort * s) {
+            sort_info * si = s->get_info();
+            if (!si || m.is_uninterp(s)) {
+                write_byte(R_USORT);
+                write_symbol(s->get_name());
+                write_params(s);
+                return;
+            }
+            write_byte(R_SORT);
+            write_symbol(s->get_name());
+            write_symbol(m.get_family_name(si->get_family_id()));
+            write_int(si->get_decl_kind());
+            sort_size const & sz = si->get_num_elements();
+            if (sz.is_finite()) {
+                write_byte(Z_FINITE);
+                write_uint(sz.size());
+            }
+            else
+                write_byte(sz.is_very_big() ? Z_VERY_BIG : Z_INFINITE);
+            write_byte(si->private_parameters() ? 1 : 0);
+            write_params(s);
+        }
+
+        void write_func_decl(func_decl * f) {
+            func_decl_info * fi = f->get_info();
+            if (fi && (fi->is_polymorphic() || fi->is_lambda() || fi->private_parameters()))
+                throw default_exception("cannot serialize " + f->get_name().str() + ": unsupported declaration");
+            write_byte(R_DECL);
+            write_symbol(f->get_name());
+            write_uint(f->get_arity());
+            for (sort * s : *f)
+                write_ref(s);
+            write_ref(f->get_range());
+            if (!fi) {
+                write_uint(0);
+                return;
+            }
+            unsigned flags = D_INFO;
+            if (fi->is_left_associative())  flags |= D_LEFT_ASSOC;
+            if (fi->is_right_associative()) flags |= D_RIGHT_ASSOC;
+            if (fi->is_flat_associative())  flags |= D_FLAT_ASSOC;
+            if (fi->is_commutative())       flags |= D_COMMUTATIVE;
+            if (fi->is_chainable())         flags |= D_CHAINABLE;
+            if (fi->is_pairwise())          flags |= D_PAIRWISE;
+            if (fi->is_injective())         flags |= D_INJECTIVE;
+            if (fi->is_idempotent())        flags |= D_IDEMPOTENT;
+            if (fi->is_skolem())            flags |= D_SKOLEM;
+            write_uint(flags);
+            write_symbol(fi->get_family_id() == null_family_id ? symbol::null : m.get_family_name(fi->get_family_id()));
+            write_int(fi->get_decl_kind());
+            write_params(f);
+        }
+
+        void write_node(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT:
+                write_sort(to_sort(n));
+                break;
+            case AST_FUNC_DECL:
+                write_func_decl(to_func_decl(n));
+                break;
+            case AST_APP: {
+                app * a = to_app(n);
+                write_byte(R_APP);
+                write_ref(a->get_decl());
+                write_uint(a->get_num_args());
+                for (expr * arg : *a)
+                    write_ref(arg);
+                break;
+            }
+            case AST_VAR:
+                write_byte(R_VAR);
+                write_uint(to_var(n)->get_idx());
+                write_ref(to_var(n)->get_sort());
+                break;
+            case AST_QUANTIFIER: {
+                quantifier * q = to_quantifier(n);
+                write_byte(R_QUANT);
+                write_byte(q->get_kind());
+                write_uint(q->get_num_decls());
+                for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                    write_ref(q->get_decl_sort(i));
+                    write_symbol(q->get_decl_name(i));
+                }
+                write_ref(q->get_expr());
+                write_int(q->get_weight());
+                write_symbol(q->get_qid());
+                write_symbol(q->get_skid());
+                write_uint(q->get_num_patterns());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    write_ref(q->get_pattern(i));
+                write_uint(q->get_num_no_patterns());
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    write_ref(q->get_no_pattern(i));
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+        void visit(ast * root) {
+            m_todo.push_back({ root, false });
+            while (!m_todo.empty()) {
+                auto [n, children_done] = m_todo.back();
+                m_todo.pop_back();
+                if (m_ids.contains(n))
+                    continue;
+                if (children_done) {
+                    write_node(n);
+                    m_ids.insert(n, m_ids.size());
+                }
+                else {
+                    m_todo.push_back({ n, true });
+                    push_children(n);
+                }
+            }
+        }
+
+    public:
+        writer(ast_manager & m, std::string & out): m(m), m_out(out) {}
+
+        void operator()(unsigned num_roots, ast * const * roots) {
+            m_out.append(ser_magic, sizeof(ser_magic));
+            write_uint(ser_version);
+            for (unsigned i = 0; i < num_roots; ++i)
+                visit(roots[i]);
+            write_byte(R_END);
+            write_uint(num_roots);
+            for (unsigned i = 0; i < num_roots; ++i)
+                write_ref(roots[i]);
+        }
+    };
+
+    class reader {
+        ast_manager &     m;
+        char const *      m_curr;
+        char const *      m_end;
+        ast_ref_vector    m_asts;
+        svector<symbol>   m_symbols;
+
+        [[noreturn]] void fail(char const * msg) {
+            throw default_exception(std::string("invalid serialized ast: ") + msg);
+        }
+
+        size_t remaining() const { return static_cast<size_t>(m_end - m_curr); }
+
+        unsigned read_byte() {
+            if (m_curr == m_end)
+                fail("unexpected end of input");
+            return static_cast<unsigned char>(*m_curr++);
+        }
+
+        uint64_t read_uint() {
+            uint64_t r = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                unsigned b = read_byte();
+                r |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if ((b & 0x80) == 0)
+                    return r;
+            }
+            fail("integer overflow");
+        }
+
+        unsigned read_unsigned() {
+            uint64_t r = read_uint();
+            if (r > UINT_MAX)
+                fail("integer overflow");
+            return static_cast<unsigned>(r);
+        }
+
+        // a count of items that each occupy at least one byte
+        unsigned read_count() {
+            unsigned n = read_unsigned();
+            if (n > remaining())
+                fail("unexpected end of input");
+            return n;
+        }
+
+        int64_t read_int() {
+            uint64_t v = read_uint();
+            return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+        }
+
+        int read_int32() {
+            int64_t v = read_int();
+            if (v < INT_MIN || v > INT_MAX)
+                fail("integer overflow");
+            return static_cast<int>(v);
+        }
+
+        ast * read_ref() {
+            uint64_t idx = read_uint();
+            if (idx >= m_asts.size())
+                fail("node reference out of range");
+            return m_asts.get(static_cast<unsigned>(idx));
+        }
+
+        sort * read_sort() {
+            ast * n = read_ref();
+            if (!is_sort(n))
+                fail("sort expected");
+            return to_sort(n);
+        }
+
+        expr * read_expr() {
+            ast * n = read_ref();
+            if (!is_expr(n))
+                fail("expression expected");
+            return to_expr(n);
+        }
+
+        symbol read_symbol() {
+            uint64_t k = read_uint();
+            switch (k) {
+            case S_NULL:
+                return symbol::null;
+            case S_NEW_STRING: {
+                unsigned len = read_count();
+                std::string s(m_curr, len);
+                m_curr += len;
+                m_symbols.push_back(symbol(s));
+                return m_symbols.back();
+            }
+            case S_NEW_NUM:
+                m_symbols.push_back(symbol(read_unsigned()));
+                return m_symbols.back();
+            default:
+                k -= S_BASE;
+                if (k >= m_symbols.size())
+                    fail("symbol reference out of range");
+                return m_symbols[static_cast<unsigned>(k)];
+            }
+        }
+
+        family_id read_family() {
+            symbol s = read_symbol();
+            if (s.is_null())
+                return null_family_id;
+            family_id fid = m.get_family_id(s);
+            if (fid == null_family_id || !m.has_plugin(fid))
+                fail("unknown theory");
+            return fid;
+        }
+
+        rational read_nat() {
+            uint64_t h = read_uint();
+            if ((h & 1) == 0)
+                return rational(h >> 1, rational::ui64());
+            rational r, base(1), two64 = rational::power_of_two(64);
+            for (uint64_t i = h >> 1; i > 0; --i) {
+                r += rational(read_uint(), rational::ui64()) * base;
+                base *= two64;
+            }
+            return r;
+        }
+
+        rational read_rational() {
+            bool neg = read_byte() != 0;
+            rational n = read_nat();
+            rational d = read_nat();
+            if (d.is_zero())
+                fail("zero denominator");
+            n /= d;
+            return neg ? -n : n;
+        }
+
+        void read_params(vector<parameter> & ps) {
+            ps.reset();
+            unsigned n = read_count();
+            for (unsigned i = 0; i < n; ++i) {
+                switch (read_byte()) {
+                case parameter::PARAM_INT:
+                    ps.push_back(parameter(read_int32()));
+                    break;
+                case parameter::PARAM_AST:
+                    ps.push_back(parameter(read_ref()));
+                    break;
+                case parameter::PARAM_SYMBOL:
+                    ps.push_back(parameter(read_symbol()));
+                    break;
+                case parameter::PARAM_ZSTRING: {
+                    unsigned len = read_count();
+                    unsigned_vector chars;
+                    for (unsigned j = 0; j < len; ++j) {
+                        unsigned ch = read_unsigned();
+                        if (ch > zstring::unicode_max_char())
+                            fail("invalid character");
+                        chars.push_back(ch);
+                    }
+                    ps.push_back(parameter(zstring(chars.size(), chars.data())));
+                    break;
+                }
+                case parameter::PARAM_RATIONAL:
+                    ps.push_back(parameter(read_rational()));
+                    break;
+                case parameter::PARAM_DOUBLE: {
+                    uint64_t bits = 0;
+                    for (unsigned j = 0; j < 8; ++j)
+                        bits |= static_cast<uint64_t>(read_byte()) << (8 * j);
+                    double d;
+                    memcpy(&d, &bits, sizeof(d));
+                    ps.push_back(parameter(d));
+                    break;
+                }
+                default:
+                    fail("invalid parameter");
+                }
+            }
+        }
+
+        ast * read_sort_record(bool uninterpreted) {
+            vector<parameter> ps;
+            symbol name = read_symbol();
+            if (uninterpreted) {
+                read_params(ps);
+                return m.mk_uninterpreted_sort(name, ps.size(), ps.data());
+            }
+            family_id fid = read_family();
+            if (fid == null_family_id)
+                fail("unknown theory");
+            decl_kind k = read_int32();
+            sort_size sz;
+            switch (read_byte()) {
+            case Z_FINITE:   sz = sort_size::mk_finite(read_uint()); break;
+            case Z_VERY_BIG: sz = sort_size::mk_very_big(); break;
+            case Z_INFINITE: sz = sort_size::mk_infinite(); break;
+            default: fail("invalid sort size");
+            }
+            bool priv = read_byte() != 0;
+            read_params(ps);
+            return m.mk_sort(name, sort_info(fid, k, sz, ps.size(), ps.data(), priv));
+        }
+
+        ast * read_decl_record() {
+            vector<parameter> ps;
+            ptr_buffer<sort> domain;
+            symbol name = read_symbol();
+            unsigned arity = read_count();
+            for (unsigned i = 0; i < arity; ++i)
+                domain.push_back(read_sort());
+            sort * range = read_sort();
+            uint64_t flags = read_uint();
+            if ((flags & D_INFO) == 0)
+                return m.mk_func_decl(name, arity, domain.data(), range);
+            family_id fid = read_family();
+            decl_kind k = read_int32();
+            read_params(ps);
+            func_decl_info info(fid, k, ps.size(), ps.data());
+            info.set_left_associative((flags & D_LEFT_ASSOC) != 0);
+            info.set_right_associative((flags & D_RIGHT_ASSOC) != 0);
+            info.set_flat_associative((flags & D_FLAT_ASSOC) != 0);
+            info.set_commutative((flags & D_COMMUTATIVE) != 0);
+            info.set_chainable((flags & D_CHAINABLE) != 0);
+            info.set_pairwise((flags & D_PAIRWISE) != 0);
+            info.set_injective((flags & D_INJECTIVE) != 0);
+            info.set_idempotent((flags & D_IDEMPOTENT) != 0);
+            info.set_skolem((flags & D_SKOLEM) != 0);
+            if (info.is_associative() && arity == 0)
+                fail("associative declaration without arguments");
+            return m.mk_func_decl(name, arity, domain.data(), range, info);
+        }
+
+        ast * read_app_record() {
+            ast * d = read_ref();
+            if (!is_func_decl(d))
+                fail("declaration expected");
+            func_decl * f = to_func_decl(d);
+            unsigned n = read_count();
+            if (n != f->get_arity() && !f->is_associative())
+                fail("wrong number of arguments");
+            ptr_buffer<expr> args;
+            for (unsigned i = 0; i < n; ++i)
+                args.push_back(read_expr());
+            return m.mk_app(f, n, args.data());
+        }
+
+        ast * read_quantifier_record() {
+            unsigned k = read_byte();
+            if (k != forall_k && k != exists_k && k != lambda_k)
+                fail("invalid quantifier kind");
+            unsigned n = read_count();
+            if (n == 0)
+                fail("quantifier without bound variables");
+            ptr_buffer<sort> sorts;
+            buffer<symbol> names;
+            for (unsigned i = 0; i < n; ++i) {
+                sorts.push_back(read_sort());
+                names.push_back(read_symbol());
+            }
+            expr * body = read_expr();
+            int weight = read_int32();
+            symbol qid = read_symbol();
+            symbol skid = read_symbol();
+            ptr_buffer<expr> patterns, no_patterns;
+            unsigned np = read_count();
+            for (unsigned i = 0; i < np; ++i)
+                patterns.push_back(read_pattern());
+            unsigned nnp = read_count();
+            for (unsigned i = 0; i < nnp; ++i)
+                no_patterns.push_back(read_pattern());
+            if (k == lambda_k)
+                return m.mk_lambda(n, sorts.data(), names.data(), body);
+            if (!m.is_bool(body))
+                fail("quantifier body must be Boolean");
+            return m.mk_quantifier(static_cast<quantifier_kind>(k), n, sorts.data(), names.data(), body, weight, qid, skid,
+                                   np, patterns.data(), nnp, no_patterns.data());
+        }
+
+        expr * read_pattern() {
+            expr * p = read_expr();
+            if (!m.is_pattern(p))
+                fail("pattern expected");
+            return p;
+        }
+
+    public:
+        reader(ast_manager & m, char const * data, size_t size):
+            m(m), m_curr(data), m_end(data + size), m_asts(m) {}
+
+        void operator()(ast_ref_vector & roots) {
+            if (!is_serialized_ast(m_curr, remaining()))
+                fail("bad header");
+            m_curr += sizeof(ser_magic);
+            if (read_uint() != ser_version)
+                fail("unsupported version");
+            while (true) {
+                ast * n = nullptr;
+                switch (read_byte()) {
+                case R_END: {
+                    unsigned num_roots = read_count();
+                    for (unsigned i = 0; i < num_roots; ++i)
+                        roots.push_back(read_ref());
+                    if (m_curr != m_end)
+                        fail("trailing data");
+                    return;
+                }
+                case R_SORT:
+                    n = read_sort_record(false);
+                    break;
+                case R_USORT:
+                    n = read_sort_record(true);
+                    break;
+                case R_DECL:
+                    n = read_decl_record();
+                    break;
+                case R_APP:
+                    n = read_app_record();
+                    break;
+                case R_VAR: {
+                    unsigned idx = read_unsigned();
+                    n = m.mk_var(idx, read_sort());
+                    break;
+                }
+                case R_QUANT:
+                    n = read_quantifier_record();
+                    break;
+                default:
+                    fail("invalid record");
+                }
+                m_asts.push_back(n);
+            }
+        }
+    };
+}
+
+void serialize_asts(ast_manager & m, unsigned num_roots, ast * const * roots, std::string & out) {
+    writer w(m, out);
+    w(num_roots, roots);
+}
+
+void deserialize_asts(ast_manager & m, char const * data, size_t size, ast_ref_vector & roots) {
+    reader r(m, data, size);
+    r(roots);
+}
+
+bool is_serialized_ast(char const * data, size_t size) {
+    return size >= sizeof(ser_magic) && memcmp(data, ser_magic, sizeof(ser_magic)) == 0;
+}
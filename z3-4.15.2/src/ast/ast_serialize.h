@@ -0,0 +1,46 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.h
+
+Abstract:
+
+    Compact binary serialization of ASTs.
+
+    The format is a sequence of records, one for each sort, function
+    declaration and expression reachable from the roots, in post-order.
+    Shared nodes are written once and referenced by their position in
+    the sequence. Symbols are interned on first use. Integers, node
+    references and numerals use a variable length (LEB128) encoding.
+
+    Theory sorts and declarations are identified by family name and
+    decl kind, so the reading manager must have the same plugins
+    installed. Datatype definitions are not serialized and must be
+    present in the reading manager. Polymorphic declarations, lambda
+    definitions and plugin specific (external) parameters, such as
+    algebraic numbers, are not supported.
+
+--*/
+#pragma once
+
+#include <string>
+#include "ast/ast.h"
+
+/**
+   \brief append the serialization of the given roots to out.
+   Throws default_exception if a node cannot be serialized.
+*/
+void serialize_asts(ast_manager & m, unsigned num_roots, ast * const * roots, std::string & out);
+
+/**
+   \brief append the roots serialized in [data, data + size) to roots.
+   Throws default_exception if the input is malformed.
+*/
+void deserialize_asts(ast_manager & m, char const * data, size_t size, ast_ref_vector & roots);
+
+/**
+   \brief return true if data starts with the header of a serialization.
+*/
+bool is_serialized_ast(char const * data, size_t size);
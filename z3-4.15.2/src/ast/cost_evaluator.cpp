@@ -96,5 +96,156 @@ float cost_evaluator::operator()(expr * f, unsigned num_args, float const * args
     return eval(f);
 }
 
+unsigned compiled_cost_function::emit(opcode op, unsigned arg, float val) {
+    m_code.push_back({ op, arg, val });
+    return m_code.size() - 1;
+}
 
+void compiled_cost_function::compile(ast_manager & m, expr * f) {
+    arith_util a(m);
+    m_code.reset();
+    compile(m, a, f);
+    // each instruction pushes at most one value.
+    m_stack.resize(m_code.size() + 1, 0.0f);
+}
 
+void compiled_cost_function::compile(ast_manager & m, arith_util & a, expr * f) {
+    auto binary = [&](opcode op) {
+        compile(m, a, to_app(f)->get_arg(0));
+        compile(m, a, to_app(f)->get_arg(1));
+        emit(op);
+    };
+    auto nary = [&](opcode op) {
+        compile(m, a, to_app(f)->get_arg(0));
+        for (unsigned i = 1; i < to_app(f)->get_num_args(); ++i) {
+            compile(m, a, to_app(f)->get_arg(i));
+            emit(op);
+        }
+    };
+    if (is_app(f) && to_app(f)->get_family_id() == m.get_basic_family_id()) {
+        switch (to_app(f)->get_decl_kind()) {
+        case OP_TRUE:  emit(PUSH, 0, 1.0f); return;
+        case OP_FALSE: emit(PUSH, 0, 0.0f); return;
+        case OP_NOT:   
+            compile(m, a, to_app(f)->get_arg(0)); 
+            emit(NOT); 
+            return;
+        case OP_AND: 
+        case OP_OR: {
+            // short-circuit: jump to the end on the first false (true) argument.
+            bool is_and = m.is_and(f);
+            unsigned_vector jumps;
+            for (expr* arg : *to_app(f)) {
+                compile(m, a, arg);
+                jumps.push_back(emit(is_and ? JZ : JNZ));
+            }
+            emit(PUSH, 0, is_and ? 1.0f : 0.0f);
+            unsigned end = emit(JMP);
+            for (unsigned pc : jumps)
+                patch(pc);
+            emit(PUSH, 0, is_and ? 0.0f : 1.0f);
+            patch(end);
+            return;
+        }
+        case OP_ITE: {
+            compile(m, a, to_app(f)->get_arg(0));
+            unsigned else_pc = emit(JZ);
+            compile(m, a, to_app(f)->get_arg(1));
+            unsigned end = emit(JMP);
+            patch(else_pc);
+            compile(m, a, to_app(f)->get_arg(2));
+            patch(end);
+            return;
+        }
+        case OP_EQ:  binary(EQ); return;
+        case OP_XOR: binary(XOR); return;
+        case OP_IMPLIES: {
+            compile(m, a, to_app(f)->get_arg(0));
+            unsigned true_pc = emit(JZ);
+            compile(m, a, to_app(f)->get_arg(1));
+            emit(BOOL);
+            unsigned end = emit(JMP);
+            patch(true_pc);
+            emit(PUSH, 0, 1.0f);
+            patch(end);
+            return;
+        }
+        default:
+            break;
+        }
+    }
+    else if (is_app(f) && to_app(f)->get_family_id() == a.get_family_id()) {
+        switch (to_app(f)->get_decl_kind()) {
+        case OP_NUM: {
+            rational r = to_app(f)->get_decl()->get_parameter(0).get_rational();
+            emit(PUSH, 0, static_cast<float>(numerator(r).get_int64())/static_cast<float>(denominator(r).get_int64()));
+            return;
+        }
+        case OP_LE:     binary(LE); return;
+        case OP_GE:     binary(GE); return;
+        case OP_LT:     binary(LT); return;
+        case OP_GT:     binary(GT); return;
+        case OP_ADD:    nary(ADD); return;
+        case OP_SUB:    nary(SUB); return;
+        case OP_MUL:    nary(MUL); return;
+        case OP_DIV:    binary(DIV); return;
+        case OP_UMINUS: 
+            compile(m, a, to_app(f)->get_arg(0)); 
+            emit(NEG); 
+            return;
+        default:
+            break;
+        }
+    }
+    else if (is_var(f)) {
+        emit(ARG, to_var(f)->get_idx());
+        return;
+    }
+    emit(ERROR);
+}
+
+float compiled_cost_function::operator()(unsigned num_args, float const * args) {
+    float * sp = m_stack.data();
+    unsigned pc = 0, sz = m_code.size();
+    while (pc < sz) {
+        instr const & i = m_code[pc++];
+        switch (i.m_op) {
+        case PUSH: *sp++ = i.m_val; break;
+        case ARG:
+            if (i.m_arg < num_args) {
+                *sp++ = args[num_args - i.m_arg - 1];
+                break;
+            }
+            Z3_fallthrough;
+        case ERROR:
+            warning_msg("cost function evaluation error");
+            *sp++ = 1.0f;
+            break;
+        case NOT:  sp[-1] = sp[-1] == 0.0f ? 1.0f : 0.0f; break;
+        case BOOL: sp[-1] = sp[-1] != 0.0f ? 1.0f : 0.0f; break;
+        case EQ:   --sp; sp[-1] = sp[-1] == sp[0] ? 1.0f : 0.0f; break;
+        case XOR:  --sp; sp[-1] = sp[-1] != sp[0] ? 1.0f : 0.0f; break;
+        case LE:   --sp; sp[-1] = sp[-1] <= sp[0] ? 1.0f : 0.0f; break;
+        case GE:   --sp; sp[-1] = sp[-1] >= sp[0] ? 1.0f : 0.0f; break;
+        case LT:   --sp; sp[-1] = sp[-1] <  sp[0] ? 1.0f : 0.0f; break;
+        case GT:   --sp; sp[-1] = sp[-1] >  sp[0] ? 1.0f : 0.0f; break;
+        case ADD:  --sp; sp[-1] += sp[0]; break;
+        case SUB:  --sp; sp[-1] -= sp[0]; break;
+        case MUL:  --sp; sp[-1] *= sp[0]; break;
+        case NEG:  sp[-1] = -sp[-1]; break;
+        case DIV:
+            --sp;
+            if (sp[0] == 0.0f) {
+                warning_msg("cost function division by zero");
+                sp[-1] = 1.0f;
+            }
+            else 
+                sp[-1] /= sp[0];
+            break;
+        case JMP:  pc = i.m_arg; break;
+        case JZ:   if (*--sp == 0.0f) pc = i.m_arg; break;
+        case JNZ:  if (*--sp != 0.0f) pc = i.m_arg; break;
+        }
+    }
+    return m_stack[0];
+}
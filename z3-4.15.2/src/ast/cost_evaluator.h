@@ -38,4 +38,24 @@ public:
     float operator()(expr * f, unsigned num_args, float const * args);
 };
 
-
+/**
+   \brief Cost function compiled once into a small stack program.
+   It computes the same value as cost_evaluator without walking the expression.
+   The arguments are passed as for cost_evaluator.
+*/
+class compiled_cost_function {
+    enum opcode { PUSH, ARG, ERROR, NOT, BOOL, EQ, XOR, LE, GE, LT, GT, ADD, SUB, NEG, MUL, DIV, JMP, JZ, JNZ };
+    struct instr {
+        opcode   m_op;
+        unsigned m_arg;   // variable index or jump target
+        float    m_val;
+    };
+    svector<instr> m_code;
+    svector<float> m_stack;
+    unsigned emit(opcode op, unsigned arg = 0, float val = 0.0f);
+    void patch(unsigned pc) { m_code[pc].m_arg = m_code.size(); }
+    void compile(ast_manager & m, arith_util & a, expr * f);
+public:
+    void compile(ast_manager & m, expr * f);
+    float operator()(unsigned num_args, float const * args);
+};
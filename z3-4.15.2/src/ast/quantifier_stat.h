@@ -42,6 +42,7 @@ namespace q {
         unsigned m_num_instances_curr_branch; //!< only updated if QI_TRACK_INSTANCES is true
         unsigned m_max_generation; //!< max. generation of an instance
         float    m_max_cost;
+        double   m_cost_time = 0; //!< seconds spent evaluating the cost function, only updated if qi.profile is true
 
         friend class quantifier_stat_gen;
 
@@ -124,6 +125,14 @@ namespace q {
         float get_max_cost() const {
             return m_max_cost;
         }
+
+        void add_cost_time(double t) {
+            m_cost_time += t;
+        }
+
+        double get_cost_time() const {
+            return m_cost_time;
+        }
     };
 
     /**
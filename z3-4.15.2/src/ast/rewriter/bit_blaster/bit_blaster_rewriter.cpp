@@ -25,12 +25,191 @@ Notes:
 #include "util/ref_util.h"
 #include "ast/ast_smt2_pp.h"
 
+/**
+   \brief And-inverter graph construction for the gates of the blaster.
+
+   Conjunctions are binary and-gates with arguments ordered by id and
+   disjunctions are negated conjunctions of negated arguments, so equal
+   sub-circuits are shared by hash-consing. Before a gate is created,
+   the two-level rules of Brummayer and Biere (contradiction, idempotence,
+   subsumption, substitution and resolution) are applied to the arguments
+   and their immediate children, so redundant gates are never built.
+   Exclusive-or, equivalence and multiplexers are kept as native gates,
+   which goal2sat encodes with fewer clauses than their AIG expansions.
+*/
+struct aig_gates {
+    ast_manager & m;
+    bool          m_enabled = false;
+    aig_gates(ast_manager & m):m(m) {}
+
+    bool is_and(expr * e, expr * & a, expr * & b) const {
+        if (!m.is_and(e) || to_app(e)->get_num_args() != 2)
+            return false;
+        a = to_app(e)->get_arg(0);
+        b = to_app(e)->get_arg(1);
+        return true;
+    }
+
+    bool is_nand(expr * e, expr * & a, expr * & b) const {
+        expr * x;
+        return m.is_not(e, x) && is_and(x, a, b);
+    }
+
+    bool is_compl(expr * a, expr * b) const { return m.is_complement(a, b); }
+
+    void mk_not(expr * a, expr_ref & r) {
+        expr * x;
+        if (m.is_not(a, x))
+            r = x;
+        else if (m.is_true(a))
+            r = m.mk_false();
+        else if (m.is_false(a))
+            r = m.mk_true();
+        else
+            r = m.mk_not(a);
+    }
+
+    // two-level rules where a is a (negated) and-gate.
+    bool simplify_and(expr * a, expr * b, expr_ref & r) {
+        expr * a1, * a2, * b1, * b2;
+        expr_ref n(m);
+        if (is_and(a, a1, a2)) {
+            // contradiction
+            if (is_compl(a1, b) || is_compl(a2, b)) {
+                r = m.mk_false();
+                return true;
+            }
+            // idempotence
+            if (a1 == b || a2 == b) {
+                r = a;
+                return true;
+            }
+            if (is_and(b, b1, b2) && (is_compl(a1, b1) || is_compl(a1, b2) || is_compl(a2, b1) || is_compl(a2, b2))) {
+                r = m.mk_false();
+                return true;
+            }
+            if (is_nand(b, b1, b2)) {
+                // subsumption
+                if (is_compl(a1, b1) || is_compl(a1, b2) || is_compl(a2, b1) || is_compl(a2, b2)) {
+                    r = a;
+                    return true;
+                }
+                // substitution
+                if (b1 == a1 || b1 == a2) {
+                    mk_not(b2, n);
+                    mk_and(a, n, r);
+                    return true;
+                }
+                if (b2 == a1 || b2 == a2) {
+                    mk_not(b1, n);
+                    mk_and(a, n, r);
+                    return true;
+                }
+            }
+        }
+        else if (is_nand(a, a1, a2)) {
+            // subsumption
+            if (is_compl(a1, b) || is_compl(a2, b)) {
+                r = b;
+                return true;
+            }
+            // substitution
+            if (a1 == b || a2 == b) {
+                mk_not(a1 == b ? a2 : a1, n);
+                mk_and(b, n, r);
+                return true;
+            }
+            // resolution
+            if (is_nand(b, b1, b2)) {
+                if ((a1 == b1 && is_compl(a2, b2)) || (a1 == b2 && is_compl(a2, b1))) {
+                    mk_not(a1, r);
+                    return true;
+                }
+                if ((a2 == b1 && is_compl(a1, b2)) || (a2 == b2 && is_compl(a1, b1))) {
+                    mk_not(a2, r);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void mk_and(expr * a, expr * b, expr_ref & r) {
+        if (m.is_false(a) || m.is_false(b) || is_compl(a, b))
+            r = m.mk_false();
+        else if (m.is_true(a) || a == b)
+            r = b;
+        else if (m.is_true(b))
+            r = a;
+        else if (simplify_and(a, b, r) || simplify_and(b, a, r))
+            return;
+        else {
+            if (a->get_id() > b->get_id())
+                std::swap(a, b);
+            r = m.mk_and(a, b);
+        }
+    }
+
+    void mk_or(expr * a, expr * b, expr_ref & r) {
+        expr_ref na(m), nb(m);
+        mk_not(a, na);
+        mk_not(b, nb);
+        mk_and(na, nb, r);
+        mk_not(r, r);
+    }
+
+    void mk_and(unsigned sz, expr * const * args, expr_ref & r) {
+        r = m.mk_true();
+        for (unsigned i = 0; i < sz; ++i)
+            mk_and(r, args[i], r);
+    }
+
+    void mk_or(unsigned sz, expr * const * args, expr_ref & r) {
+        r = m.mk_false();
+        for (unsigned i = 0; i < sz; ++i)
+            mk_or(r, args[i], r);
+    }
+
+    // majority: (a & b) | (c & (a | b))
+    void mk_maj(expr * a, expr * b, expr * c, expr_ref & r) {
+        expr_ref t1(m), t2(m);
+        mk_and(a, b, t1);
+        mk_or(a, b, t2);
+        mk_and(c, t2, t2);
+        mk_or(t1, t2, r);
+    }
+
+    bool mk_ite(expr * c, expr * t, expr * e, expr_ref & r) {
+        expr_ref n(m);
+        if (m.is_true(c) || t == e)
+            r = t;
+        else if (m.is_false(c))
+            r = e;
+        else if (m.is_true(t))
+            mk_or(c, e, r);
+        else if (m.is_false(t)) {
+            mk_not(c, n);
+            mk_and(n, e, r);
+        }
+        else if (m.is_true(e)) {
+            mk_not(c, n);
+            mk_or(n, t, r);
+        }
+        else if (m.is_false(e))
+            mk_and(c, t, r);
+        else
+            return false;
+        return true;
+    }
+};
+
 struct blaster_cfg {
     typedef rational numeral;
 
     bool_rewriter & m_rewriter;
+    aig_gates &     m_aig;
     bv_util &       m_util;
-    blaster_cfg(bool_rewriter & r, bv_util & u):m_rewriter(r), m_util(u) {}
+    blaster_cfg(bool_rewriter & r, aig_gates & g, bv_util & u):m_rewriter(r), m_aig(g), m_util(u) {}
 
     ast_manager & m() const { return m_util.get_manager(); }
     numeral power(unsigned n) const { return rational::power_of_two(n); }
@@ -41,14 +220,37 @@ struct blaster_cfg {
         mk_xor(a, tmp, r);
     }
     void mk_iff(expr * a, expr * b, expr_ref & r) { m_rewriter.mk_iff(a, b, r); }
-    void mk_and(expr * a, expr * b, expr_ref & r) { m_rewriter.mk_and(a, b, r); }
-    void mk_and(expr * a, expr * b, expr * c, expr_ref & r) { m_rewriter.mk_and(a, b, c, r); }
-    void mk_and(unsigned sz, expr * const * args, expr_ref & r) { m_rewriter.mk_and(sz, args, r); }
-    void mk_or(expr * a, expr * b, expr_ref & r) { m_rewriter.mk_or(a, b, r); }
-    void mk_or(expr * a, expr * b, expr * c, expr_ref & r) { m_rewriter.mk_or(a, b, c, r); }
-    void mk_or(unsigned sz, expr * const * args, expr_ref & r) { m_rewriter.mk_or(sz, args, r); }
-    void mk_not(expr * a, expr_ref & r) { m_rewriter.mk_not(a, r); }
+    void mk_and(expr * a, expr * b, expr_ref & r) {
+        if (m_aig.m_enabled) m_aig.mk_and(a, b, r); else m_rewriter.mk_and(a, b, r);
+    }
+    void mk_and(expr * a, expr * b, expr * c, expr_ref & r) {
+        if (m_aig.m_enabled) { m_aig.mk_and(a, b, r); m_aig.mk_and(r, c, r); } else m_rewriter.mk_and(a, b, c, r);
+    }
+    void mk_and(unsigned sz, expr * const * args, expr_ref & r) {
+        if (m_aig.m_enabled) m_aig.mk_and(sz, args, r); else m_rewriter.mk_and(sz, args, r);
+    }
+    void mk_or(expr * a, expr * b, expr_ref & r) {
+        if (m_aig.m_enabled) m_aig.mk_or(a, b, r); else m_rewriter.mk_or(a, b, r);
+    }
+    void mk_or(expr * a, expr * b, expr * c, expr_ref & r) {
+        if (m_aig.m_enabled) { m_aig.mk_or(a, b, r); m_aig.mk_or(r, c, r); } else m_rewriter.mk_or(a, b, c, r);
+    }
+    void mk_or(unsigned sz, expr * const * args, expr_ref & r) {
+        if (m_aig.m_enabled) m_aig.mk_or(sz, args, r); else m_rewriter.mk_or(sz, args, r);
+    }
+    void mk_not(expr * a, expr_ref & r) {
+        if (m_aig.m_enabled) m_aig.mk_not(a, r); else m_rewriter.mk_not(a, r);
+    }
     void mk_carry(expr * a, expr * b, expr * c, expr_ref & r) {
+        if (m_aig.m_enabled) {
+            // (b & c) | (a & (b ^ c)) shares b ^ c with the sum bit built by mk_xor3.
+            expr_ref t(m()), bc(m()), at(m());
+            mk_xor(b, c, t);
+            m_aig.mk_and(b, c, bc);
+            m_aig.mk_and(a, t, at);
+            m_aig.mk_or(bc, at, r);
+            return;
+        }
         expr_ref t1(m()), t2(m()), t3(m());
 #if 1
         mk_and(a, b, t1);
@@ -62,25 +264,37 @@ struct blaster_cfg {
         mk_and(t1, t2, t3, r);
 #endif
     }
-    void mk_ite(expr * c, expr * t, expr * e, expr_ref & r) { m_rewriter.mk_ite(c, t, e, r); }
-    void mk_nand(expr * a, expr * b, expr_ref & r) { m_rewriter.mk_nand(a, b, r); }
-    void mk_nor(expr * a, expr * b, expr_ref & r) { m_rewriter.mk_nor(a, b, r); }
-    void mk_ge2(expr * a, expr * b, expr * c, expr_ref& r) { m_rewriter.mk_ge2(a, b, c, r); }
+    void mk_ite(expr * c, expr * t, expr * e, expr_ref & r) {
+        if (!m_aig.m_enabled || !m_aig.mk_ite(c, t, e, r))
+            m_rewriter.mk_ite(c, t, e, r);
+    }
+    void mk_nand(expr * a, expr * b, expr_ref & r) {
+        if (m_aig.m_enabled) { m_aig.mk_and(a, b, r); m_aig.mk_not(r, r); } else m_rewriter.mk_nand(a, b, r);
+    }
+    void mk_nor(expr * a, expr * b, expr_ref & r) {
+        if (m_aig.m_enabled) { m_aig.mk_or(a, b, r); m_aig.mk_not(r, r); } else m_rewriter.mk_nor(a, b, r);
+    }
+    void mk_ge2(expr * a, expr * b, expr * c, expr_ref& r) {
+        if (m_aig.m_enabled) m_aig.mk_maj(a, b, c, r); else m_rewriter.mk_ge2(a, b, c, r);
+    }
 };
 
 class blaster : public bit_blaster_tpl<blaster_cfg> {
     bool_rewriter           m_rewriter;
+    aig_gates               m_aig;
     bv_util                 m_util;
 public:
     blaster(ast_manager & m):
-        bit_blaster_tpl<blaster_cfg>(blaster_cfg(m_rewriter, m_util)),
+        bit_blaster_tpl<blaster_cfg>(blaster_cfg(m_rewriter, m_aig, m_util)),
         m_rewriter(m),
+        m_aig(m),
         m_util(m) {
         m_rewriter.set_flat_and_or(false);
         m_rewriter.set_elim_and(true);
     }
 
     bv_util & butil() { return m_util; }
+    void set_aig(bool f) { m_aig.m_enabled = f; }
 };
 
 struct blaster_rewriter_cfg : public default_rewriter_cfg {
@@ -136,6 +350,7 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
         m_blast_full     = p.get_bool("blast_full", false);
         m_blast_quant    = p.get_bool("blast_quant", false);
         m_blaster.set_max_memory(m_max_memory);
+        m_blaster.set_aig(p.get_bool("blast_aig", false));
     }
 
     bool rewrite_patterns() const { return true; }
@@ -313,8 +313,10 @@ protected:
     template<bool ProofGen>
     void cache_result(expr * t, expr * new_t, proof * pr, bool c) {
         if (c) {
-            if (!ProofGen)
+            if (!ProofGen) {
                 rewriter_core::cache_result(t, new_t);
+                m_cfg.cache_result_eh(t, new_t);
+            }
             else
                 rewriter_core::cache_result(t, new_t, pr);
         }
@@ -394,6 +396,8 @@ struct default_rewriter_cfg {
     bool get_macro(func_decl * d, expr * & def, quantifier * & q, proof * & def_pr) { return false; }
     bool reduce_macro() { return false; }
     bool get_subst(expr * s, expr * & t, proof * & t_pr) { return false; }
+    // Invoked when the result of rewriting t is added to the cache (only without proof generation).
+    void cache_result_eh(expr * t, expr * new_t) {}
     void reset() {}
     void cleanup() {}
 };
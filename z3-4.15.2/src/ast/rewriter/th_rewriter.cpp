@@ -41,6 +41,142 @@ Notes:
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
 #include "ast/array_peq.h"
+#include "util/gparams.h"
+
+/**
+   \brief Ground rewrite results kept across calls to the rewriter.
+
+   Entries are keyed on the term and a fingerprint of the rewriter
+   configuration, so results computed under different parameters are
+   never mixed. The table holds at most a given number of entries; when
+   it is full the least recently used entry is evicted. Keys and values
+   are pinned while they are in the table, so the memory used by the
+   cache includes the terms it keeps alive and is not bounded by the
+   number of entries alone.
+*/
+class rewrite_cache {
+    struct entry {
+        expr *   m_key;
+        expr *   m_value;
+        unsigned m_fp;
+        unsigned m_prev;
+        unsigned m_next;
+    };
+    struct key {
+        expr *   m_expr = nullptr;
+        unsigned m_fp = 0;
+    };
+    struct key_hash {
+        unsigned operator()(key const & k) const { return combine_hash(k.m_expr->hash(), k.m_fp); }
+    };
+    struct key_eq {
+        bool operator()(key const & a, key const & b) const { return a.m_expr == b.m_expr && a.m_fp == b.m_fp; }
+    };
+    ast_manager &                        m;
+    map<key, unsigned, key_hash, key_eq> m_index;
+    svector<entry>                       m_entries;
+    unsigned_vector                      m_free;
+    unsigned                             m_head = UINT_MAX; // most recently used
+    unsigned                             m_tail = UINT_MAX; // least recently used
+    unsigned                             m_max_size = 0;
+    unsigned                             m_hits = 0;
+    unsigned                             m_misses = 0;
+    unsigned                             m_evictions = 0;
+
+    void unlink(unsigned i) {
+        entry & e = m_entries[i];
+        if (e.m_prev == UINT_MAX) m_head = e.m_next; else m_entries[e.m_prev].m_next = e.m_next;
+        if (e.m_next == UINT_MAX) m_tail = e.m_prev; else m_entries[e.m_next].m_prev = e.m_prev;
+    }
+
+    void push_front(unsigned i) {
+        entry & e = m_entries[i];
+        e.m_prev = UINT_MAX;
+        e.m_next = m_head;
+        if (m_head != UINT_MAX) m_entries[m_head].m_prev = i;
+        m_head = i;
+        if (m_tail == UINT_MAX) m_tail = i;
+    }
+
+    void evict() {
+        unsigned i = m_tail;
+        SASSERT(i != UINT_MAX);
+        entry & e = m_entries[i];
+        unlink(i);
+        m_index.erase(key{ e.m_key, e.m_fp });
+        m.dec_ref(e.m_key);
+        m.dec_ref(e.m_value);
+        m_free.push_back(i);
+        ++m_evictions;
+    }
+
+public:
+    rewrite_cache(ast_manager & m): m(m) {}
+
+    ~rewrite_cache() { reset(); }
+
+    void set_max_size(unsigned n) {
+        m_max_size = n;
+        while (m_index.size() > m_max_size)
+            evict();
+    }
+
+    expr * find(expr * t, unsigned fp) {
+        unsigned i;
+        if (!m_index.find(key{ t, fp }, i)) {
+            ++m_misses;
+            return nullptr;
+        }
+        ++m_hits;
+        if (m_head != i) {
+            unlink(i);
+            push_front(i);
+        }
+        return m_entries[i].m_value;
+    }
+
+    void insert(expr * t, unsigned fp, expr * r) {
+        if (m_max_size == 0 || m_index.contains(key{ t, fp }))
+            return;
+        if (m_index.size() >= m_max_size)
+            evict();
+        unsigned i;
+        if (m_free.empty()) {
+            i = m_entries.size();
+            m_entries.push_back(entry());
+        }
+        else {
+            i = m_free.back();
+            m_free.pop_back();
+        }
+        entry & e = m_entries[i];
+        e.m_key = t;
+        e.m_value = r;
+        e.m_fp = fp;
+        m.inc_ref(t);
+        m.inc_ref(r);
+        push_front(i);
+        m_index.insert(key{ t, fp }, i);
+    }
+
+    void reset() {
+        for (unsigned i = m_head; i != UINT_MAX; i = m_entries[i].m_next) {
+            m.dec_ref(m_entries[i].m_key);
+            m.dec_ref(m_entries[i].m_value);
+        }
+        m_index.reset();
+        m_entries.reset();
+        m_free.reset();
+        m_head = m_tail = UINT_MAX;
+    }
+
+    void collect_statistics(statistics & st) const {
+        st.update("rewriter cache hits", m_hits);
+        st.update("rewriter cache misses", m_misses);
+        st.update("rewriter cache evictions", m_evictions);
+        st.update("rewriter cache size", m_index.size());
+    }
+};
 
 namespace {
 struct th_rewriter_cfg : public default_rewriter_cfg {
@@ -64,6 +200,8 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
       // substitution support
     expr_dependency_ref m_used_dependencies; // set of dependencies of used substitutions
     expr_substitution * m_subst = nullptr;
+    rewrite_cache *     m_cache = nullptr;
+    unsigned            m_cache_fp = 0;
     unsigned long long  m_max_memory; // in bytes
     bool                m_new_subst = false;
     expr_fast_mark1     m_visited;
@@ -905,8 +1043,13 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
     }
 
     bool get_subst(expr * s, expr * & t, proof * & pr) {
-        if (m_subst == nullptr)
-            return false;
+        if (m_subst == nullptr) {
+            if (!m_cache || !is_ground(s) || to_app(s)->get_num_args() == 0)
+                return false;
+            t = m_cache->find(s, m_cache_fp);
+            pr = nullptr;
+            return t != nullptr;
+        }
         expr_dependency * d = nullptr;
         if (m_subst->find(s, t, pr, d)) {
             m_used_dependencies = m().mk_join(m_used_dependencies, d);
@@ -915,6 +1058,10 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         return false;
     }
 
+    void cache_result_eh(expr * t, expr * r) {
+        if (m_cache && m_subst == nullptr && is_ground(t))
+            m_cache->insert(t, m_cache_fp, r);
+    }
 
 };
 }
@@ -941,6 +1088,30 @@ struct th_rewriter::imp : public rewriter_tpl<th_rewriter_cfg> {
 th_rewriter::th_rewriter(ast_manager & m, params_ref const & p):
     m_params(p) {
     m_imp = alloc(imp, m, p);
+    updt_cache();
+}
+
+void th_rewriter::updt_cache() {
+    ast_manager & m = m_imp->m();
+    unsigned max_size = rewriter_params(m_params).persistent_cache();
+    if (max_size == 0 || m.proofs_enabled()) {
+        dealloc(m_cache);
+        m_cache = nullptr;
+    }
+    else {
+        if (!m_cache)
+            m_cache = alloc(rewrite_cache, m);
+        m_cache->set_max_size(max_size);
+    }
+    // the rewriters read parameters that are not set locally from the global rewriter module.
+    std::ostringstream strm;
+    m_params.display(strm);
+    gparams::get_module("rewriter").display(strm);
+    std::string s = strm.str();
+    unsigned fp = string_hash(s.c_str(), static_cast<unsigned>(s.size()), 17);
+    fp = combine_hash(fp, hash_u_u(m_flat_and_or, m_order_eq));
+    m_imp->cfg().m_cache = m_cache;
+    m_imp->cfg().m_cache_fp = fp;
 }
 
 ast_manager & th_rewriter::m() const {
@@ -950,6 +1121,7 @@ ast_manager & th_rewriter::m() const {
 void th_rewriter::updt_params(params_ref const & p) {
     m_params.append(p);
     m_imp->cfg().updt_params(m_params);
+    updt_cache();
 }
 
 void th_rewriter::get_param_descrs(param_descrs & r) {
@@ -962,14 +1134,19 @@ void th_rewriter::get_param_descrs(param_descrs & r) {
 
 void th_rewriter::set_flat_and_or(bool f) {
     m_imp->cfg().m_b_rw.set_flat_and_or(f);
+    m_flat_and_or = to_lbool(f);
+    updt_cache();
 }
 
 void th_rewriter::set_order_eq(bool f) {
     m_imp->cfg().m_b_rw.set_order_eq(f);
+    m_order_eq = to_lbool(f);
+    updt_cache();
 }
 
 th_rewriter::~th_rewriter() {
     dealloc(m_imp);
+    dealloc(m_cache);
 }
 
 unsigned th_rewriter::get_cache_size() const {
@@ -984,6 +1161,10 @@ void th_rewriter::cleanup() {
     ast_manager & m = m_imp->m();
     m_imp->~imp();
     new (m_imp) imp(m, m_params);
+    if (m_cache)
+        m_cache->reset();
+    m_flat_and_or = m_order_eq = l_undef;
+    updt_cache();
 }
 
 void th_rewriter::reset() {
@@ -995,6 +1176,7 @@ void th_rewriter::operator()(expr_ref & term) {
     expr_ref result(term.get_manager());    
     try {
         m_imp->operator()(term, result);
+        m_imp->cfg().cache_result_eh(term, result);
         term = std::move(result);
     }
     catch (...) {
@@ -1007,6 +1189,7 @@ void th_rewriter::operator()(expr_ref & term) {
 void th_rewriter::operator()(expr * t, expr_ref & result) {
     try {
         m_imp->operator()(t, result);
+        m_imp->cfg().cache_result_eh(t, result);
     }
     catch (...) {
         result = t;
@@ -1059,6 +1242,14 @@ expr_ref th_rewriter::mk_eq(expr* a, expr* b) {
 
 void th_rewriter::set_solver(expr_solver* solver) {
     m_imp->set_solver(solver);
+    // results may depend on the solver
+    if (m_cache)
+        m_cache->reset();
+}
+
+void th_rewriter::collect_statistics(statistics & st) const {
+    if (m_cache)
+        m_cache->collect_statistics(st);
 }
 
 
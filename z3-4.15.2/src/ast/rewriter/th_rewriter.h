@@ -21,15 +21,23 @@ Notes:
 #include "ast/ast.h"
 #include "ast/rewriter/rewriter_types.h"
 #include "util/params.h"
+#include "util/statistics.h"
+#include "util/lbool.h"
 
 class expr_substitution;
 
+class rewrite_cache;
+
 class expr_solver;
 
 class th_rewriter {
     struct     imp;
     imp *      m_imp;
     params_ref m_params;
+    rewrite_cache * m_cache = nullptr;
+    lbool      m_flat_and_or = l_undef;
+    lbool      m_order_eq = l_undef;
+    void updt_cache();
 public:
     th_rewriter(ast_manager & m, params_ref const & p = params_ref());
     ~th_rewriter();
@@ -76,5 +84,11 @@ public:
 
     void set_solver(expr_solver* solver);
 
+    /**
+       \brief Report hits and misses of the rewrite cache that is kept
+       across calls when rewriter.persistent_cache is set.
+    */
+    void collect_statistics(statistics & st) const;
+
 };
 
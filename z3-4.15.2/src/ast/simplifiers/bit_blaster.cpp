@@ -29,6 +29,7 @@ void bit_blaster_simplifier::collect_param_descrs(param_descrs & r) {
     r.insert("blast_mul", CPK_BOOL, "(default: true) bit-blast multipliers (and dividers, remainders).");
     r.insert("blast_add", CPK_BOOL, "(default: true) bit-blast adders.");
     r.insert("blast_quant", CPK_BOOL, "(default: false) bit-blast quantified variables.");
+    r.insert("blast_aig", CPK_BOOL, "(default: false) build and/or gates as a structurally hashed and-inverter graph with two-level rewriting.");
     r.insert("blast_full", CPK_BOOL, "(default: false) bit-blast any term with bit-vector sort, this option will make E-matching ineffective in any pattern containing bit-vector terms.");
 }
 
@@ -76,11 +76,7 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
         // and their removed formulas are added to the resulting constraints.
 
         if (t->is_loose_subst()) {                
-            for (auto const& [k, v] : t->m_subst->sub()) {
-                add_vars(v, free_vars);
-                st.add(dependent_expr(m, m.mk_eq(k, v), nullptr, nullptr));
-            }
-            t->m_active = false;
+            replay_subst(*t, free_vars, st);
             continue;
         }
         
@@ -90,7 +86,7 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
                 TRACE(simplifier, tout << "replay removed " << r << "\n");
                 st.add(r);
             }
-            t->m_active = false;
+            deactivate(*t);
             continue;
         }
 
@@ -192,6 +188,57 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
     TRACE(simplifier, st.display(tout));
 }
 
+/**
+* Replay the eliminated variables of a loose substitution that occur in new formulas
+* by adding their defining equations. In incremental mode the remaining variables
+* stay eliminated. The change is recorded on the trail stack, so popping the scope
+* of the new formulas restores the substitution.
+*/
+void model_reconstruction_trail::replay_subst(entry& e, ast_mark& free_vars, dependent_expr_state& st) {
+    ptr_vector<expr> replayed;
+    ast_mark visited;
+    bool change = true;
+    while (change) {
+        change = false;
+        for (auto const& [k, v] : e.m_subst->sub()) {
+            if (visited.is_marked(k))
+                continue;
+            if (m_incremental && !free_vars.is_marked(to_app(k)->get_decl()))
+                continue;
+            visited.mark(k, true);
+            replayed.push_back(k);
+            add_vars(v, free_vars);
+            change = true;
+        }
+    }
+    for (expr* k : replayed) {
+        expr* v = nullptr;
+        proof* pr = nullptr;
+        expr_dependency* dep = nullptr;
+        e.m_subst->find(k, v, pr, dep);
+        TRACE(simplifier, tout << "replay " << mk_pp(k, m) << " := " << mk_pp(v, m) << "\n");
+        st.add(dependent_expr(m, m.mk_eq(k, v), nullptr, dep));
+    }
+    m_num_replayed += replayed.size();
+    if (replayed.size() == e.m_subst->size()) {
+        deactivate(e);
+        return;
+    }
+    expr_substitution* rest = alloc(expr_substitution, m, e.m_subst->unsat_core_enabled(), e.m_subst->proofs_enabled());
+    for (auto const& [k, v] : e.m_subst->sub()) {
+        if (visited.is_marked(k))
+            continue;
+        proof* pr = nullptr;
+        expr_dependency* dep = nullptr;
+        expr* def = nullptr;
+        e.m_subst->find(k, def, pr, dep);
+        rest->insert(k, def, pr, dep);
+    }
+    m_replaced.push_back(e.m_subst.detach());
+    m_trail_stack.push(undo_subst(*this, e));
+    e.m_subst = rest;
+}
+
 /**
  * retrieve the current model converter corresponding to chaining substitutions from the trail.
  */
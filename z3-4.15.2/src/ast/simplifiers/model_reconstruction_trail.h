@@ -25,6 +25,7 @@ Author:
 
 #include "util/scoped_ptr_vector.h"
 #include "util/trail.h"
+#include "util/statistics.h"
 #include "ast/for_each_expr.h"
 #include "ast/rewriter/expr_replacer.h"
 #include "ast/simplifiers/dependent_expr.h"
@@ -93,6 +94,33 @@ class model_reconstruction_trail {
     func_decl_ref_vector     m_model_vars_trail;
     ast_mark                 m_model_vars;
     bool                     m_intersects_with_model = false;
+    bool                     m_incremental = true;
+    unsigned                 m_num_replayed = 0;
+    scoped_ptr_vector<expr_substitution> m_replaced;
+
+    /**
+    * restore the substitution of an entry that was partially replayed.
+    */
+    struct undo_subst : public trail {
+        model_reconstruction_trail& s;
+        entry& e;
+        undo_subst(model_reconstruction_trail& s, entry& e) : s(s), e(e) {}
+        void undo() override { 
+            e.m_subst = s.m_replaced.detach_back();
+            s.m_replaced.pop_back();
+        }
+    };
+
+    /**
+    * deactivate an entry whose removed formulas are replayed.
+    * The entry is re-activated when the scope of the replay is popped.
+    */
+    void deactivate(entry& e) {
+        m_trail_stack.push(value_trail(e.m_active));
+        e.m_active = false;
+    }
+
+    void replay_subst(entry& e, ast_mark& free_vars, dependent_expr_state& st);
 
     struct undo_model_var : public trail {
         model_reconstruction_trail& s;
@@ -187,6 +215,14 @@ public:
     * by removing substitutions that are not equivalence preserving.
     */
     void replay(unsigned qhead, expr_ref_vector& assumptions, dependent_expr_state& fmls);
+
+    /**
+    * when incremental, only the eliminated variables that occur in new formulas are replayed,
+    * otherwise substitutions are replayed as a whole.
+    */
+    void set_incremental(bool f) { m_incremental = f; }
+
+    void collect_statistics(statistics& st) const { st.update("preprocess replayed eliminations", m_num_replayed); }
     
 
     /**
@@ -48,7 +48,7 @@ public:
         }
     }
     bool supports_proofs() const override { return true; }
-    void collect_statistics(statistics& st) const override { st.update("simplifier-steps", m_num_steps); }
+    void collect_statistics(statistics& st) const override { st.update("simplifier-steps", m_num_steps); m_rewriter.collect_statistics(st); }
     void reset_statistics() override { m_num_steps = 0; }
     void updt_params(params_ref const& p) override { m_params.append(p); m_rewriter.updt_params(m_params); }
     void collect_param_descrs(param_descrs& r) override { th_rewriter::get_param_descrs(r); }
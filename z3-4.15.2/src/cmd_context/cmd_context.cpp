@@ -52,6 +52,7 @@ Notes:
 #include "cmd_context/basic_cmds.h"
 #include "cmd_context/cmd_context.h"
 #include "solver/slice_solver.h"
+#include "solver/cache_solver.h"
 #include <iostream>
 
 func_decls::func_decls(ast_manager & m, func_decl * f):
@@ -2261,6 +2262,7 @@ void cmd_context::mk_solver() {
     m_params.get_solver_params(p, proofs_enabled, models_enabled, unsat_core_enabled);
     m_solver = (*m_solver_factory)(m(), p, proofs_enabled, models_enabled, unsat_core_enabled, m_logic);
     m_solver = mk_slice_solver(m_solver.get());
+    m_solver = mk_cache_solver(m_solver.get());
     if (m_simplifier_factory) 
         m_solver = mk_simplifier_solver(m_solver.get(), &m_simplifier_factory);
 }
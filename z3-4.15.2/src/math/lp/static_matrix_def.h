@@ -27,8 +27,33 @@
 namespace lp {
 // each assignment for this matrix should be issued only once!!!
 
+    // true if a is an integer stored inline, that is, it fits in an int.
+    inline bool is_small_int(mpq const& a) {
+        auto const& q = a.to_mpq();
+        return q.numerator().is_small() && q.denominator().is_small() && q.denominator().value() == 1;
+    }
+
     inline void addmul(double& r, double a, double b) { r += a*b; }
-    inline void addmul(mpq& r, mpq const& a, mpq const& b) { r.addmul(a, b); }
+
+    // r += a*b. Small integers are combined in machine arithmetic: the
+    // product of two ints and its sum with a third fit in 64 bits.
+    inline void addmul(mpq& r, mpq const& a, mpq const& b) {
+        if (is_small_int(r) && is_small_int(a) && is_small_int(b)) {
+            int64_t v = static_cast<int64_t>(r.to_mpq().numerator().value()) +
+                static_cast<int64_t>(a.to_mpq().numerator().value()) * b.to_mpq().numerator().value();
+            r = mpq(v, mpq::i64());
+        }
+        else
+            r.addmul(a, b);
+    }
+
+    inline double mul(double a, double b) { return a*b; }
+
+    inline mpq mul(mpq const& a, mpq const& b) {
+        if (is_small_int(a) && is_small_int(b))
+            return mpq(static_cast<int64_t>(a.to_mpq().numerator().value()) * b.to_mpq().numerator().value(), mpq::i64());
+        return a * b;
+    }
 
     template <typename T, typename X>
     void  static_matrix<T, X>::init_row_columns(unsigned m, unsigned n) {
@@ -65,7 +90,7 @@ namespace lp {
             SASSERT(!is_zero(iv.coeff()));
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
-                T alv = alpha * iv.coeff();
+                T alv = mul(alpha, iv.coeff());
                 add_new_element(ii, j, alv);
             }
             else {
@@ -96,7 +121,7 @@ namespace lp {
             unsigned j = iv.var();
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
-                T alv = alpha * iv.coeff();
+                T alv = mul(alpha, iv.coeff());
                 add_new_element(k, j, alv);
             }
             else {
@@ -134,7 +159,7 @@ namespace lp {
             SASSERT(!is_zero(iv.coeff()));
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
-                T alv = alpha * iv.coeff();
+                T alv = mul(alpha, iv.coeff());
                 add_new_element(ii, j, alv);
             }
             else {
@@ -167,7 +192,7 @@ namespace lp {
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
                 add_columns_up_to(j);
-                T alv = alpha * iv.coeff();
+                T alv = mul(alpha, iv.coeff());
                 add_new_element(ii, j, alv);
             }
             else {
@@ -203,7 +228,7 @@ namespace lp {
             SASSERT(!is_zero(iv.coeff()));
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
-                T alv = alpha * iv.coeff();
+                T alv = mul(alpha, iv.coeff());
                 add_new_element(ii, j, alv);
             }
             else {
@@ -0,0 +1,665 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    model_tape.cpp
+
+Abstract:
+
+    Compiled evaluation of terms in models.
+
+--*/
+#include "model/model_tape.h"
+
+static inline uint64_t bv_mask(unsigned w) {
+    return w >= 64 ? ~0ull : (1ull << w) - 1;
+}
+
+static inline int64_t bv_sext(uint64_t x, unsigned w) {
+    return w >= 64 ? static_cast<int64_t>(x) : static_cast<int64_t>(x << (64 - w)) >> (64 - w);
+}
+
+model_tape::model_tape(ast_manager & m):
+    m(m),
+    m_arith(m),
+    m_bv(m),
+    m_array(m),
+    m_pinned(m) {
+}
+
+void model_tape::reset() {
+    m_instrs.reset();
+    m_args.reset();
+    m_values.reset();
+    m_roots.reset();
+    m_root_exprs.reset();
+    m_slot.reset();
+    m_decls.reset();
+    m_loads.reset();
+    m_tables.reset();
+    m_decl2table.reset();
+    m_pinned.reset();
+}
+
+bool model_tape::get_kind(sort * s, kind & k) const {
+    if (m.is_bool(s))
+        k = k_bool;
+    else if (m_arith.is_int_real(s))
+        k = k_arith;
+    else if (m_bv.is_bv_sort(s) && m_bv.get_bv_size(s) <= 64)
+        k = k_bv;
+    else
+        return false;
+    return true;
+}
+
+bool model_tape::to_cell(expr * v, kind k, cell & c) const {
+    rational r;
+    switch (k) {
+    case k_bool:
+        if (!m.is_true(v) && !m.is_false(v))
+            return false;
+        c.m_bits = m.is_true(v);
+        break;
+    case k_bv:
+        if (!m_bv.is_numeral(v, r))
+            return false;
+        c.m_bits = r.get_uint64();
+        break;
+    case k_arith:
+        if (!m_arith.is_numeral(v, r))
+            return false;
+        c.m_num = r;
+        break;
+    }
+    c.m_undef = false;
+    return true;
+}
+
+expr_ref model_tape::to_expr(cell const & c, sort * s) const {
+    if (m.is_bool(s))
+        return expr_ref(m.mk_bool_val(c.m_bits != 0), m);
+    if (m_bv.is_bv_sort(s))
+        return expr_ref(m_bv.mk_numeral(rational(c.m_bits, rational::ui64()), s), m);
+    return expr_ref(m_arith.mk_numeral(c.m_num, m_arith.is_int(s)), m);
+}
+
+bool model_tape::add(expr * e) {
+    unsigned slot = compile(e);
+    m_roots.push_back(slot);
+    m_root_exprs.push_back(e);
+    m_pinned.push_back(e);
+    return slot != UINT_MAX;
+}
+
+bool model_tape::has_roots(unsigned n, expr * const * es) const {
+    if (n != m_root_exprs.size())
+        return false;
+    for (unsigned i = 0; i < n; ++i)
+        if (es[i] != m_root_exprs[i])
+            return false;
+    return true;
+}
+
+unsigned model_tape::compile(expr * e) {
+    unsigned slot;
+    if (m_slot.find(e, slot))
+        return slot;
+    ptr_buffer<expr> todo;
+    todo.push_back(e);
+    while (!todo.empty()) {
+        expr * t = todo.back();
+        if (m_slot.contains(t)) {
+            todo.pop_back();
+            continue;
+        }
+        bool visited = true;
+        if (is_app(t)) {
+            for (expr * arg : *to_app(t)) {
+                if (!m_slot.contains(arg)) {
+                    todo.push_back(arg);
+                    visited = false;
+                }
+            }
+        }
+        if (!visited)
+            continue;
+        todo.pop_back();
+        m_pinned.push_back(t);
+        m_slot.insert(t, is_app(t) ? compile_app(to_app(t)) : UINT_MAX);
+    }
+    return m_slot[e];
+}
+
+unsigned model_tape::emit(opcode op, kind k, sort * s, unsigned num_args, unsigned const * args, unsigned aux) {
+    instr i;
+    i.m_op       = op;
+    i.m_kind     = k;
+    i.m_arg      = m_args.size();
+    i.m_num_args = num_args;
+    i.m_aux      = aux;
+    i.m_width    = k == k_bv ? m_bv.get_bv_size(s) : 0;
+    i.m_sort     = s;
+    m_args.append(num_args, args);
+    m_instrs.push_back(i);
+    m_values.push_back(cell());
+    return m_instrs.size() - 1;
+}
+
+unsigned model_tape::mk_table(func_decl * f, bool is_select) {
+    unsigned idx;
+    if (m_decl2table.find(f, idx))
+        return idx;
+    table t;
+    t.m_decl   = f;
+    t.m_select = is_select;
+    sort * s = f->get_range();
+    ptr_buffer<sort> domain;
+    if (is_select) {
+        for (unsigned i = 0; i < get_array_arity(s); ++i)
+            domain.push_back(get_array_domain(s, i));
+        s = get_array_range(s);
+    }
+    else
+        domain.append(f->get_arity(), f->get_domain());
+    t.m_arity = domain.size();
+    for (sort * d : domain) {
+        kind k;
+        VERIFY(get_kind(d, k));
+        t.m_domain.push_back(k);
+    }
+    VERIFY(get_kind(s, t.m_range));
+    idx = m_tables.size();
+    m_tables.push_back(t);
+    m_decl2table.insert(f, idx);
+    return idx;
+}
+
+unsigned model_tape::compile_app(app * a) {
+    kind k;
+    sort * s = a->get_sort();
+    if (!get_kind(s, k))
+        return UINT_MAX;
+    func_decl * f = a->get_decl();
+    unsigned n = a->get_num_args();
+    buffer<unsigned> args;
+
+    // select over an array constant reads the interpretation of the constant as a table.
+    if (m_array.is_select(a) && is_uninterp_const(a->get_arg(0))) {
+        for (unsigned i = 1; i < n; ++i) {
+            unsigned slot = m_slot[a->get_arg(i)];
+            if (slot == UINT_MAX)
+                return UINT_MAX;
+            args.push_back(slot);
+        }
+        return emit(op_select, k, s, args.size(), args.data(), mk_table(to_app(a->get_arg(0))->get_decl(), true));
+    }
+
+    for (expr * arg : *a) {
+        unsigned slot = m_slot[arg];
+        if (slot == UINT_MAX)
+            return UINT_MAX;
+        args.push_back(slot);
+    }
+
+    family_id fid = f->get_family_id();
+    if (fid == null_family_id) {
+        if (f->is_polymorphic())
+            return UINT_MAX;
+        if (n == 0) {
+            unsigned slot = emit(op_load, k, s, 0, nullptr, m_decls.size());
+            m_decls.push_back(f);
+            m_loads.push_back(slot);
+            return slot;
+        }
+        return emit(op_apply, k, s, n, args.data(), mk_table(f, false));
+    }
+
+    if (n == 0) {
+        cell c;
+        if (!to_cell(a, k, c))
+            return UINT_MAX;
+        unsigned slot = emit(op_const, k, s, 0, nullptr);
+        m_values[slot] = c;
+        return slot;
+    }
+
+    auto emit_swap = [&](opcode op) {
+        std::swap(args[0], args[1]);
+        return emit(op, k, s, n, args.data());
+    };
+
+    decl_kind dk = f->get_decl_kind();
+    if (fid == m.get_basic_family_id()) {
+        switch (dk) {
+        case OP_NOT:      return emit(op_not, k, s, n, args.data());
+        case OP_AND:      return emit(op_and, k, s, n, args.data());
+        case OP_OR:       return emit(op_or, k, s, n, args.data());
+        case OP_XOR:      return emit(op_xor, k, s, n, args.data());
+        case OP_IMPLIES:  return n == 2 ? emit(op_implies, k, s, n, args.data()) : UINT_MAX;
+        case OP_ITE:      return emit(op_ite, k, s, n, args.data());
+        case OP_EQ:       return emit(op_eq, k, s, n, args.data());
+        case OP_DISTINCT: return emit(op_distinct, k, s, n, args.data());
+        default:          return UINT_MAX;
+        }
+    }
+    if (fid == m_arith.get_family_id()) {
+        switch (dk) {
+        case OP_ADD:      return emit(op_add, k, s, n, args.data());
+        case OP_SUB:      return emit(op_sub, k, s, n, args.data());
+        case OP_UMINUS:   return emit(op_uminus, k, s, n, args.data());
+        case OP_MUL:      return emit(op_mul, k, s, n, args.data());
+        case OP_DIV:      return emit(op_div, k, s, n, args.data());
+        case OP_IDIV:     return emit(op_idiv, k, s, n, args.data());
+        case OP_MOD:      return emit(op_mod, k, s, n, args.data());
+        case OP_REM:      return emit(op_rem, k, s, n, args.data());
+        case OP_LE:       return emit(op_le, k, s, n, args.data());
+        case OP_LT:       return emit(op_lt, k, s, n, args.data());
+        case OP_GE:       return emit_swap(op_le);
+        case OP_GT:       return emit_swap(op_lt);
+        case OP_TO_REAL:  return emit(op_to_real, k, s, n, args.data());
+        case OP_TO_INT:   return emit(op_to_int, k, s, n, args.data());
+        case OP_IS_INT:   return emit(op_is_int, k, s, n, args.data());
+        case OP_ABS:      return emit(op_abs, k, s, n, args.data());
+        default:          return UINT_MAX;
+        }
+    }
+    if (fid == m_bv.get_family_id()) {
+        switch (dk) {
+        case OP_BADD:     return emit(op_bv_add, k, s, n, args.data());
+        case OP_BSUB:     return emit(op_bv_sub, k, s, n, args.data());
+        case OP_BMUL:     return emit(op_bv_mul, k, s, n, args.data());
+        case OP_BNEG:     return emit(op_bv_neg, k, s, n, args.data());
+        case OP_BAND:     return emit(op_bv_and, k, s, n, args.data());
+        case OP_BOR:      return emit(op_bv_or, k, s, n, args.data());
+        case OP_BXOR:     return emit(op_bv_xor, k, s, n, args.data());
+        case OP_BNOT:     return emit(op_bv_not, k, s, n, args.data());
+        case OP_ULEQ:     return emit(op_bv_ule, k, s, n, args.data());
+        case OP_ULT:      return emit(op_bv_ult, k, s, n, args.data());
+        case OP_SLEQ:     return emit(op_bv_sle, k, s, n, args.data());
+        case OP_SLT:      return emit(op_bv_slt, k, s, n, args.data());
+        case OP_UGEQ:     return emit_swap(op_bv_ule);
+        case OP_UGT:      return emit_swap(op_bv_ult);
+        case OP_SGEQ:     return emit_swap(op_bv_sle);
+        case OP_SGT:      return emit_swap(op_bv_slt);
+        case OP_BUDIV:    return emit(op_bv_udiv, k, s, n, args.data());
+        case OP_BUDIV_I:  return emit(op_bv_udiv_i, k, s, n, args.data());
+        case OP_BUREM:    return emit(op_bv_urem, k, s, n, args.data());
+        case OP_BUREM_I:  return emit(op_bv_urem_i, k, s, n, args.data());
+        case OP_BSHL:     return emit(op_bv_shl, k, s, n, args.data());
+        case OP_BLSHR:    return emit(op_bv_lshr, k, s, n, args.data());
+        case OP_BASHR:    return emit(op_bv_ashr, k, s, n, args.data());
+        case OP_CONCAT:   return emit(op_bv_concat, k, s, n, args.data());
+        case OP_EXTRACT:  return emit(op_bv_extract, k, s, n, args.data(), m_bv.get_extract_low(a));
+        case OP_ZERO_EXT: return emit(op_bv_zero_ext, k, s, n, args.data());
+        case OP_SIGN_EXT: return emit(op_bv_sign_ext, k, s, n, args.data());
+        case OP_UBV2INT:  return emit(op_bv2int, k, s, n, args.data());
+        default:          return UINT_MAX;
+        }
+    }
+    return UINT_MAX;
+}
+
+void model_tape::load_const(model_core & mdl, bool model_completion, func_decl * f, kind k, cell & c) {
+    expr * v = mdl.get_const_interp(f);
+    if (!v && model_completion) {
+        v = mdl.get_some_value(f->get_range());
+        mdl.register_decl(f, v);
+    }
+    c.m_undef = !v || !to_cell(v, k, c);
+}
+
+bool model_tape::add_entry(table & t, expr * const * args, expr * result) {
+    unsigned sz = t.m_cells.size();
+    t.m_cells.resize(sz + t.m_arity + 1);
+    for (unsigned i = 0; i < t.m_arity; ++i)
+        if (!to_cell(args[i], t.m_domain[i], t.m_cells[sz + i]))
+            return false;
+    if (!to_cell(result, t.m_range, t.m_cells[sz + t.m_arity]))
+        return false;
+    ++t.m_num_entries;
+    return true;
+}
+
+void model_tape::load_table(model_core & mdl, bool model_completion, table & t) {
+    t.m_cells.reset();
+    t.m_num_entries = 0;
+    t.m_else.m_undef = true;
+    func_decl * f = t.m_decl;
+    func_interp * fi = nullptr;
+    bool ok = true;
+    if (t.m_select) {
+        expr * v = mdl.get_const_interp(f);
+        if (!v && model_completion) {
+            v = mdl.get_some_value(f->get_range());
+            mdl.register_decl(f, v);
+        }
+        if (!v)
+            return;
+        // the outermost store is the most recent update, so it is
+        // added first and found first by lookup.
+        while (ok && m_array.is_store(v)) {
+            app * st = to_app(v);
+            ok = add_entry(t, st->get_args() + 1, array_store_elem(st));
+            v = st->get_arg(0);
+        }
+        func_decl * g = nullptr;
+        if (m_array.is_const(v))
+            to_cell(to_app(v)->get_arg(0), t.m_range, t.m_else);
+        else if (m_array.is_as_array(v, g))
+            fi = mdl.get_func_interp(g);
+    }
+    else {
+        fi = mdl.get_func_interp(f);
+        if (!fi && model_completion) {
+            fi = alloc(func_interp, m, f->get_arity());
+            fi->set_else(mdl.get_some_value(f->get_range()));
+            mdl.register_decl(f, fi);
+        }
+        if (fi && fi->is_partial() && model_completion)
+            fi->set_else(mdl.get_some_value(f->get_range()));
+    }
+    if (fi) {
+        for (unsigned i = 0; ok && i < fi->num_entries(); ++i) {
+            func_entry const * e = fi->get_entry(i);
+            ok = add_entry(t, e->get_args(), e->get_result());
+        }
+        // an else that is not a value, such as an expression over
+        // the arguments, leaves entries that are not listed undefined.
+        if (fi->get_else())
+            to_cell(fi->get_else(), t.m_range, t.m_else);
+    }
+    if (!ok) {
+        // entries that are not values cannot be matched against
+        // argument values, so no application is determined.
+        t.m_cells.reset();
+        t.m_num_entries = 0;
+        t.m_else.m_undef = true;
+    }
+}
+
+void model_tape::lookup(table const & t, unsigned const * args, cell & c) const {
+    unsigned stride = t.m_arity + 1;
+    cell const * row = t.m_cells.data();
+    for (unsigned e = 0; e < t.m_num_entries; ++e, row += stride) {
+        unsigned j = 0;
+        for (; j < t.m_arity && equal(row[j], m_values[args[j]], t.m_domain[j]); ++j)
+            ;
+        if (j == t.m_arity) {
+            c = row[j];
+            return;
+        }
+    }
+    c = t.m_else;
+}
+
+void model_tape::step(instr const & i, cell & c) {
+    unsigned const * args = m_args.data() + i.m_arg;
+    unsigned n = i.m_num_args;
+    auto arg = [&](unsigned j) -> cell const & { return m_values[args[j]]; };
+    auto width = [&](unsigned j) { return m_instrs[args[j]].m_width; };
+
+    // Boolean connectives and if-then-else can be determined
+    // even if some of their arguments are undefined.
+    switch (i.m_op) {
+    case op_const:
+    case op_load:
+        return;
+    case op_and:
+    case op_or: {
+        bool absorb = i.m_op == op_or;
+        bool undef = false;
+        for (unsigned j = 0; j < n; ++j) {
+            cell const & a = arg(j);
+            if (a.m_undef)
+                undef = true;
+            else if ((a.m_bits != 0) == absorb) {
+                c.m_bits = absorb;
+                c.m_undef = false;
+                return;
+            }
+        }
+        c.m_bits = !absorb;
+        c.m_undef = undef;
+        return;
+    }
+    case op_implies: {
+        cell const & a = arg(0), & b = arg(1);
+        if ((!a.m_undef && !a.m_bits) || (!b.m_undef && b.m_bits)) {
+            c.m_bits = 1;
+            c.m_undef = false;
+        }
+        else {
+            c.m_bits = 0;
+            c.m_undef = a.m_undef || b.m_undef;
+        }
+        return;
+    }
+    case op_ite:
+        if (arg(0).m_undef)
+            c.m_undef = true;
+        else
+            c = arg(arg(0).m_bits ? 1 : 2);
+        return;
+    default:
+        break;
+    }
+
+    for (unsigned j = 0; j < n; ++j) {
+        if (arg(j).m_undef) {
+            c.m_undef = true;
+            return;
+        }
+    }
+    c.m_undef = false;
+    uint64_t mask = bv_mask(i.m_width);
+
+    switch (i.m_op) {
+    case op_apply:
+    case op_select:
+        lookup(m_tables[i.m_aux], args, c);
+        break;
+    case op_not:
+        c.m_bits = !arg(0).m_bits;
+        break;
+    case op_xor:
+        c.m_bits = 0;
+        for (unsigned j = 0; j < n; ++j)
+            c.m_bits ^= (arg(j).m_bits != 0);
+        break;
+    case op_eq: {
+        kind k = m_instrs[args[0]].m_kind;
+        bool eq = true;
+        for (unsigned j = 1; eq && j < n; ++j)
+            eq = equal(arg(0), arg(j), k);
+        c.m_bits = eq;
+        break;
+    }
+    case op_distinct: {
+        kind k = m_instrs[args[0]].m_kind;
+        bool distinct = true;
+        for (unsigned j = 0; distinct && j < n; ++j)
+            for (unsigned l = j + 1; distinct && l < n; ++l)
+                distinct = !equal(arg(j), arg(l), k);
+        c.m_bits = distinct;
+        break;
+    }
+    case op_add:
+        c.m_num = arg(0).m_num;
+        for (unsigned j = 1; j < n; ++j)
+            c.m_num += arg(j).m_num;
+        break;
+    case op_sub:
+        c.m_num = arg(0).m_num;
+        for (unsigned j = 1; j < n; ++j)
+            c.m_num -= arg(j).m_num;
+        break;
+    case op_uminus:
+        c.m_num = -arg(0).m_num;
+        break;
+    case op_mul:
+        c.m_num = arg(0).m_num;
+        for (unsigned j = 1; j < n; ++j)
+            c.m_num *= arg(j).m_num;
+        break;
+    case op_div:
+    case op_idiv:
+    case op_mod:
+    case op_rem: {
+        // division by zero is uninterpreted; the model evaluator decides.
+        rational const & a = arg(0).m_num, & b = arg(1).m_num;
+        if (b.is_zero()) {
+            c.m_undef = true;
+            break;
+        }
+        switch (i.m_op) {
+        case op_div:  c.m_num = a / b; break;
+        case op_idiv: c.m_num = div(a, b); break;
+        case op_mod:  c.m_num = mod(a, b); break;
+        default:
+            c.m_num = mod(a, b);
+            if (b.is_neg())
+                c.m_num.neg();
+            break;
+        }
+        break;
+    }
+    case op_le:
+        c.m_bits = arg(0).m_num <= arg(1).m_num;
+        break;
+    case op_lt:
+        c.m_bits = arg(0).m_num < arg(1).m_num;
+        break;
+    case op_to_real:
+        c.m_num = arg(0).m_num;
+        break;
+    case op_to_int:
+        c.m_num = floor(arg(0).m_num);
+        break;
+    case op_is_int:
+        c.m_bits = arg(0).m_num.is_int();
+        break;
+    case op_abs:
+        c.m_num = abs(arg(0).m_num);
+        break;
+    case op_bv_add:
+        c.m_bits = arg(0).m_bits;
+        for (unsigned j = 1; j < n; ++j)
+            c.m_bits += arg(j).m_bits;
+        c.m_bits &= mask;
+        break;
+    case op_bv_sub:
+        c.m_bits = (arg(0).m_bits - arg(1).m_bits) & mask;
+        break;
+    case op_bv_mul:
+        c.m_bits = arg(0).m_bits;
+        for (unsigned j = 1; j < n; ++j)
+            c.m_bits *= arg(j).m_bits;
+        c.m_bits &= mask;
+        break;
+    case op_bv_neg:
+        c.m_bits = (0 - arg(0).m_bits) & mask;
+        break;
+    case op_bv_and:
+        c.m_bits = arg(0).m_bits;
+        for (unsigned j = 1; j < n; ++j)
+            c.m_bits &= arg(j).m_bits;
+        break;
+    case op_bv_or:
+        c.m_bits = arg(0).m_bits;
+        for (unsigned j = 1; j < n; ++j)
+            c.m_bits |= arg(j).m_bits;
+        break;
+    case op_bv_xor:
+        c.m_bits = arg(0).m_bits;
+        for (unsigned j = 1; j < n; ++j)
+            c.m_bits ^= arg(j).m_bits;
+        break;
+    case op_bv_not:
+        c.m_bits = ~arg(0).m_bits & mask;
+        break;
+    case op_bv_ule:
+        c.m_bits = arg(0).m_bits <= arg(1).m_bits;
+        break;
+    case op_bv_ult:
+        c.m_bits = arg(0).m_bits < arg(1).m_bits;
+        break;
+    case op_bv_sle:
+        c.m_bits = bv_sext(arg(0).m_bits, width(0)) <= bv_sext(arg(1).m_bits, width(0));
+        break;
+    case op_bv_slt:
+        c.m_bits = bv_sext(arg(0).m_bits, width(0)) < bv_sext(arg(1).m_bits, width(0));
+        break;
+    case op_bv_udiv:
+    case op_bv_urem:
+        // bvudiv and bvurem by zero are decided by the model
+        if (arg(1).m_bits == 0)
+            c.m_undef = true;
+        else if (i.m_op == op_bv_udiv)
+            c.m_bits = arg(0).m_bits / arg(1).m_bits;
+        else
+            c.m_bits = arg(0).m_bits % arg(1).m_bits;
+        break;
+    case op_bv_udiv_i:
+        c.m_bits = arg(1).m_bits == 0 ? mask : arg(0).m_bits / arg(1).m_bits;
+        break;
+    case op_bv_urem_i:
+        c.m_bits = arg(1).m_bits == 0 ? arg(0).m_bits : arg(0).m_bits % arg(1).m_bits;
+        break;
+    case op_bv_shl:
+        c.m_bits = arg(1).m_bits >= i.m_width ? 0 : (arg(0).m_bits << arg(1).m_bits) & mask;
+        break;
+    case op_bv_lshr:
+        c.m_bits = arg(1).m_bits >= i.m_width ? 0 : arg(0).m_bits >> arg(1).m_bits;
+        break;
+    case op_bv_ashr: {
+        int64_t a = bv_sext(arg(0).m_bits, i.m_width);
+        if (arg(1).m_bits >= i.m_width)
+            c.m_bits = a < 0 ? mask : 0;
+        else
+            c.m_bits = static_cast<uint64_t>(a >> arg(1).m_bits) & mask;
+        break;
+    }
+    case op_bv_concat:
+        c.m_bits = 0;
+        for (unsigned j = 0; j < n; ++j)
+            c.m_bits = (width(j) >= 64 ? 0 : c.m_bits << width(j)) | arg(j).m_bits;
+        break;
+    case op_bv_extract:
+        c.m_bits = (arg(0).m_bits >> i.m_aux) & mask;
+        break;
+    case op_bv_zero_ext:
+        c.m_bits = arg(0).m_bits;
+        break;
+    case op_bv_sign_ext:
+        c.m_bits = static_cast<uint64_t>(bv_sext(arg(0).m_bits, width(0))) & mask;
+        break;
+    case op_bv2int:
+        c.m_num = rational(arg(0).m_bits, rational::ui64());
+        break;
+    default:
+        UNREACHABLE();
+        break;
+    }
+}
+
+void model_tape::operator()(model_core & mdl, bool model_completion) {
+    for (unsigned slot : m_loads) {
+        instr const & i = m_instrs[slot];
+        load_const(mdl, model_completion, m_decls[i.m_aux], i.m_kind, m_values[slot]);
+    }
+    for (table & t : m_tables)
+        load_table(mdl, model_completion, t);
+    unsigned sz = m_instrs.size();
+    for (unsigned slot = 0; slot < sz; ++slot)
+        step(m_instrs[slot], m_values[slot]);
+}
+
+bool model_tape::get_value(unsigned i, expr_ref & r) const {
+    unsigned slot = m_roots[i];
+    if (slot == UINT_MAX || m_values[slot].m_undef)
+        return false;
+    r = to_expr(m_values[slot], m_instrs[slot].m_sort);
+    return true;
+}
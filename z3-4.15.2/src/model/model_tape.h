@@ -0,0 +1,139 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    model_tape.h
+
+Abstract:
+
+    Compiled evaluation of terms in models.
+
+    Terms are compiled once into a flat, topologically ordered
+    instruction tape. Evaluating the tape against a model is a single
+    pass over the instructions: there is no rewriting and the values
+    of Booleans and bit-vectors live in machine words.
+
+    The tape covers Booleans, integer and real arithmetic, bit-vectors
+    of width at most 64, uninterpreted functions and select over array
+    constants. Terms outside of this fragment are not compiled, and
+    values the tape cannot determine (division by zero, irrational
+    model values, function interpretations that are not tables) are
+    reported as undefined. In both cases the caller falls back to
+    model_evaluator.
+
+--*/
+#pragma once
+
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/array_decl_plugin.h"
+#include "model/model_core.h"
+
+class model_tape {
+    enum kind { k_bool, k_bv, k_arith };
+
+    enum opcode {
+        op_const, op_load, op_apply, op_select,
+        op_not, op_and, op_or, op_xor, op_implies, op_ite, op_eq, op_distinct,
+        op_add, op_sub, op_uminus, op_mul, op_div, op_idiv, op_mod, op_rem,
+        op_le, op_lt, op_to_real, op_to_int, op_is_int, op_abs,
+        op_bv_add, op_bv_sub, op_bv_mul, op_bv_neg, op_bv_and, op_bv_or, op_bv_xor, op_bv_not,
+        op_bv_ule, op_bv_ult, op_bv_sle, op_bv_slt,
+        op_bv_udiv, op_bv_udiv_i, op_bv_urem, op_bv_urem_i,
+        op_bv_shl, op_bv_lshr, op_bv_ashr,
+        op_bv_concat, op_bv_extract, op_bv_zero_ext, op_bv_sign_ext, op_bv2int
+    };
+
+    struct instr {
+        opcode   m_op;
+        kind     m_kind;
+        unsigned m_arg;       // first argument slot in m_args
+        unsigned m_num_args;
+        unsigned m_aux;       // low bit of extract, or index into m_decls/m_tables
+        unsigned m_width;     // bit-width of bit-vector results
+        sort *   m_sort;
+    };
+
+    struct cell {
+        uint64_t m_bits = 0;  // Booleans and bit-vectors
+        rational m_num;       // arithmetic
+        bool     m_undef = false;
+    };
+
+    // interpretation of an uninterpreted function or array constant
+    // as a table of entries followed by an optional else value.
+    struct table {
+        func_decl *  m_decl;
+        bool         m_select;
+        unsigned     m_arity;
+        svector<kind> m_domain;
+        kind         m_range;
+        vector<cell> m_cells;    // m_arity + 1 cells per entry
+        cell         m_else;
+        unsigned     m_num_entries = 0;
+    };
+
+    ast_manager &        m;
+    arith_util           m_arith;
+    bv_util              m_bv;
+    array_util           m_array;
+    expr_ref_vector      m_pinned;
+    svector<instr>       m_instrs;
+    unsigned_vector      m_args;
+    vector<cell>         m_values;
+    unsigned_vector      m_roots;
+    ptr_vector<expr>     m_root_exprs;
+    obj_map<expr, unsigned> m_slot;
+    ptr_vector<func_decl> m_decls;     // uninterpreted constants loaded by op_load
+    unsigned_vector      m_loads;
+    vector<table>        m_tables;
+    obj_map<func_decl, unsigned> m_decl2table;
+
+    bool get_kind(sort * s, kind & k) const;
+    bool to_cell(expr * v, kind k, cell & c) const;
+    expr_ref to_expr(cell const & c, sort * s) const;
+    bool equal(cell const & a, cell const & b, kind k) const { return k == k_arith ? a.m_num == b.m_num : a.m_bits == b.m_bits; }
+    unsigned compile(expr * e);
+    unsigned compile_app(app * a);
+    unsigned emit(opcode op, kind k, sort * s, unsigned num_args, unsigned const * args, unsigned aux = 0);
+    unsigned mk_table(func_decl * f, bool is_select);
+    void load_const(model_core & mdl, bool model_completion, func_decl * f, kind k, cell & c);
+    void load_table(model_core & mdl, bool model_completion, table & t);
+    bool add_entry(table & t, expr * const * args, expr * result);
+    void lookup(table const & t, unsigned const * args, cell & c) const;
+    void step(instr const & i, cell & c);
+
+public:
+    model_tape(ast_manager & m);
+
+    /**
+       \brief Compile \c e and add it as the next root.
+       Return false if \c e is outside of the compiled fragment;
+       the root is recorded either way so that root indices follow
+       the order of the calls.
+    */
+    bool add(expr * e);
+
+    unsigned num_roots() const { return m_roots.size(); }
+
+    /**
+       \brief Return true if the roots are exactly \c es.
+    */
+    bool has_roots(unsigned n, expr * const * es) const;
+
+    void reset();
+
+    /**
+       \brief Evaluate all roots in \c mdl.
+       With model completion, missing interpretations are added to the
+       model the same way model_evaluator adds them.
+    */
+    void operator()(model_core & mdl, bool model_completion);
+
+    /**
+       \brief Retrieve the value of the i-th root after evaluation.
+       Return false if the root was not compiled or its value is undefined.
+    */
+    bool get_value(unsigned i, expr_ref & r) const;
+};
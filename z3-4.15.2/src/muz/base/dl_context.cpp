@@ -286,6 +286,8 @@ namespace datalog {
     bool context::unbound_compressor() const { return m_unbound_compressor; }
     void context::set_unbound_compressor(bool f) { m_unbound_compressor = f; }
     unsigned context::soft_timeout() const { return m_params->datalog_timeout(); }
+    unsigned context::threads() const { return m_params->datalog_threads(); }
+    symbol context::columnar_relations() const { return m_params->datalog_columnar_relations(); }
     bool context::similarity_compressor() const { return m_params->datalog_similarity_compressor(); }
     unsigned context::similarity_compressor_threshold() const { return m_params->datalog_similarity_compressor_threshold(); }
     unsigned context::initial_restart_timeout() const { return m_params->datalog_initial_restart_timeout(); }
@@ -258,6 +258,8 @@ namespace datalog {
         symbol tab_selection() const;
         unsigned similarity_compressor_threshold() const;
         unsigned soft_timeout() const;
+        unsigned threads() const;
+        symbol columnar_relations() const;
         unsigned initial_restart_timeout() const;
         bool generate_explanations() const;
         bool explanations_on_relation_level() const;
@@ -0,0 +1,825 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    dl_columnar_table.cpp
+
+Abstract:
+
+    Table that stores each column in a separate array.
+
+--*/
+
+#include<algorithm>
+#include "muz/base/dl_util.h"
+#include "muz/rel/dl_columnar_table.h"
+
+namespace datalog {
+
+    typedef svector<table_element> column;
+
+    // sequences shorter than this are sorted by comparison instead of radix sort
+    static const unsigned min_radix_sort_rows = 256;
+    // contains_fact scans at most this many pending rows before it normalizes the table
+    static const unsigned max_scanned_rows = 64;
+    // add_fact normalizes the table when there are more pending rows than sorted ones and this bound
+    static const unsigned max_pending_rows = 4096;
+
+    static bool is_prefix(const unsigned_vector & cols) {
+        for (unsigned i = 0; i < cols.size(); ++i) {
+            if (cols[i] != i) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+       \brief Stable LSD radix sort of \c rows by the values of \c key, one byte per pass.
+       Passes over bytes that are equal in all values are skipped.
+    */
+    static void radix_sort(const column & key, unsigned_vector & rows, unsigned_vector & tmp) {
+        unsigned n = rows.size();
+        const table_element * k = key.data();
+        table_element first = k[rows[0]];
+        table_element diff = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            diff |= k[rows[i]] ^ first;
+        }
+        unsigned counts[256];
+        tmp.resize(n);
+        for (unsigned shift = 0; shift < 64; shift += 8) {
+            if (((diff >> shift) & 0xFF) == 0) {
+                continue;
+            }
+            std::fill(counts, counts + 256, 0);
+            for (unsigned i = 0; i < n; ++i) {
+                ++counts[(k[rows[i]] >> shift) & 0xFF];
+            }
+            unsigned sum = 0;
+            for (unsigned d = 0; d < 256; ++d) {
+                unsigned c = counts[d];
+                counts[d] = sum;
+                sum += c;
+            }
+            for (unsigned i = 0; i < n; ++i) {
+                unsigned r = rows[i];
+                tmp[counts[(k[r] >> shift) & 0xFF]++] = r;
+            }
+            rows.swap(tmp);
+        }
+    }
+
+    /**
+       \brief Append the values of \c src in the rows \c rows to \c dst.
+    */
+    static void gather(const column & src, const unsigned_vector & rows, column & dst) {
+        unsigned n = rows.size();
+        unsigned base = dst.size();
+        dst.resize(base + n);
+        table_element * d = dst.data() + base;
+        const table_element * s = src.data();
+        const unsigned * r = rows.data();
+        for (unsigned i = 0; i < n; ++i) {
+            d[i] = s[r[i]];
+        }
+    }
+
+    /**
+       \brief Store into \c rows the rows in which \c c has the value \c v.
+    */
+    static void select_equal(const column & c, table_element v, unsigned_vector & rows) {
+        unsigned n = c.size();
+        rows.resize(n);
+        const table_element * d = c.data();
+        unsigned * out = rows.data();
+        unsigned k = 0;
+        for (unsigned r = 0; r < n; ++r) {
+            out[k] = r;
+            k += d[r] == v;
+        }
+        rows.shrink(k);
+    }
+
+    /**
+       \brief Store into \c rows the rows in which \c marks has the value \c v.
+    */
+    static void select_marked(const bool_vector & marks, bool v, unsigned_vector & rows) {
+        unsigned n = marks.size();
+        rows.resize(n);
+        unsigned * out = rows.data();
+        unsigned k = 0;
+        for (unsigned r = 0; r < n; ++r) {
+            out[k] = r;
+            k += marks[r] == v;
+        }
+        rows.shrink(k);
+    }
+
+    // -----------------------------------
+    //
+    // columnar_table
+    //
+    // -----------------------------------
+
+    columnar_table::columnar_table(columnar_table_plugin & plugin, const table_signature & sig)
+        : table_base(plugin, sig) {
+        m_columns.resize(sig.size());
+    }
+
+    void columnar_table::append_row(const table_element * f) {
+        for (unsigned i = 0; i < m_columns.size(); ++i) {
+            m_columns[i].push_back(f[i]);
+        }
+    }
+
+    void columnar_table::get_row(unsigned r, table_fact & f) const {
+        f.resize(m_columns.size());
+        for (unsigned i = 0; i < m_columns.size(); ++i) {
+            f[i] = m_columns[i][r];
+        }
+    }
+
+    int columnar_table::compare_rows(unsigned r1, unsigned r2) const {
+        for (const column & c : m_columns) {
+            if (c[r1] != c[r2]) {
+                return c[r1] < c[r2] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    int columnar_table::compare_row(unsigned r, const table_element * f) const {
+        for (unsigned i = 0; i < m_columns.size(); ++i) {
+            table_element v = m_columns[i][r];
+            if (v != f[i]) {
+                return v < f[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    int columnar_table::compare_keys(const columnar_table & t1, unsigned r1, const unsigned_vector & cols1,
+                                     const columnar_table & t2, unsigned r2, const unsigned_vector & cols2) {
+        for (unsigned i = 0; i < cols1.size(); ++i) {
+            table_element v1 = t1.m_columns[cols1[i]][r1];
+            table_element v2 = t2.m_columns[cols2[i]][r2];
+            if (v1 != v2) {
+                return v1 < v2 ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    unsigned columnar_table::lower_bound(const table_element * f, unsigned lo) const {
+        // gallop from lo to bracket the position, then bisect
+        unsigned step = 1;
+        unsigned hi = lo;
+        while (hi < m_sorted && compare_row(hi, f) < 0) {
+            lo = hi + 1;
+            hi = lo + step;
+            step *= 2;
+        }
+        hi = std::min(hi, m_sorted);
+        while (lo < hi) {
+            unsigned mid = lo + (hi - lo) / 2;
+            if (compare_row(mid, f) < 0) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    void columnar_table::sort_rows(const unsigned_vector & cols, unsigned_vector & rows) const {
+        if (rows.size() < min_radix_sort_rows) {
+            std::sort(rows.begin(), rows.end(), [&](unsigned r1, unsigned r2) {
+                return compare_keys(*this, r1, cols, *this, r2, cols) < 0;
+            });
+            return;
+        }
+        unsigned_vector tmp;
+        for (unsigned i = cols.size(); i-- > 0; ) {
+            radix_sort(m_columns[cols[i]], rows, tmp);
+        }
+    }
+
+    void columnar_table::sorted_by(const unsigned_vector & cols, unsigned_vector & rows) const {
+        SASSERT(num_pending() == 0);
+        unsigned n = num_rows();
+        rows.resize(n);
+        for (unsigned r = 0; r < n; ++r) {
+            rows[r] = r;
+        }
+        if (!is_prefix(cols)) {
+            sort_rows(cols, rows);
+        }
+    }
+
+    void columnar_table::normalize() const {
+        unsigned n = num_rows();
+        if (m_sorted == n) {
+            return;
+        }
+        unsigned_vector all_cols, pending, order;
+        for (unsigned i = 0; i < m_columns.size(); ++i) {
+            all_cols.push_back(i);
+        }
+        for (unsigned r = m_sorted; r < n; ++r) {
+            pending.push_back(r);
+        }
+        sort_rows(all_cols, pending);
+
+        // merge the sorted pending rows into the sorted rows, dropping duplicates
+        unsigned i = 0;
+        for (unsigned p : pending) {
+            while (i < m_sorted && compare_rows(i, p) < 0) {
+                order.push_back(i++);
+            }
+            if (i < m_sorted && compare_rows(i, p) == 0) {
+                continue;
+            }
+            if (!order.empty() && compare_rows(order.back(), p) == 0) {
+                continue;
+            }
+            order.push_back(p);
+        }
+        while (i < m_sorted) {
+            order.push_back(i++);
+        }
+
+        for (column & c : m_columns) {
+            column sorted;
+            gather(c, order, sorted);
+            c.swap(sorted);
+        }
+        m_sorted = order.size();
+    }
+
+    void columnar_table::select(const unsigned_vector & rows) {
+        unsigned n = rows.size();
+        // the selected rows keep their order, so the selected sorted rows stay in front
+        unsigned sorted = static_cast<unsigned>(std::lower_bound(rows.begin(), rows.end(), m_sorted) - rows.begin());
+        const unsigned * sel = rows.data();
+        for (column & c : m_columns) {
+            table_element * d = c.data();
+            for (unsigned k = 0; k < n; ++k) {
+                d[k] = d[sel[k]];
+            }
+            c.shrink(n);
+        }
+        m_sorted = sorted;
+    }
+
+    void columnar_table::remove_rows(const bool_vector & removed) {
+        unsigned_vector rows;
+        select_marked(removed, false, rows);
+        if (rows.size() < num_rows()) {
+            select(rows);
+        }
+    }
+
+    void columnar_table::add_fact(const table_fact & f) {
+        append_row(f.data());
+        if (num_pending() > std::max(m_sorted, max_pending_rows)) {
+            normalize();
+        }
+    }
+
+    void columnar_table::remove_fact(const table_element * fact) {
+        remove_facts(1, fact);
+    }
+
+    void columnar_table::remove_facts(unsigned fact_cnt, const table_fact * facts) {
+        normalize();
+        bool_vector removed(num_rows(), false);
+        for (unsigned i = 0; i < fact_cnt; ++i) {
+            unsigned r = lower_bound(facts[i].data(), 0);
+            if (r < m_sorted && compare_row(r, facts[i].data()) == 0) {
+                removed[r] = true;
+            }
+        }
+        remove_rows(removed);
+    }
+
+    void columnar_table::remove_facts(unsigned fact_cnt, const table_element * facts) {
+        normalize();
+        unsigned fact_size = m_columns.size();
+        bool_vector removed(num_rows(), false);
+        for (unsigned i = 0; i < fact_cnt; ++i) {
+            const table_element * f = facts + i * fact_size;
+            unsigned r = lower_bound(f, 0);
+            if (r < m_sorted && compare_row(r, f) == 0) {
+                removed[r] = true;
+            }
+        }
+        remove_rows(removed);
+    }
+
+    bool columnar_table::contains_fact(const table_fact & fact) const {
+        if (num_pending() > max_scanned_rows) {
+            normalize();
+        }
+        const table_element * f = fact.data();
+        unsigned r = lower_bound(f, 0);
+        if (r < m_sorted && compare_row(r, f) == 0) {
+            return true;
+        }
+        for (r = m_sorted; r < num_rows(); ++r) {
+            if (compare_row(r, f) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void columnar_table::reset() {
+        for (column & c : m_columns) {
+            c.reset();
+        }
+        m_sorted = 0;
+    }
+
+    table_base * columnar_table::clone() const {
+        columnar_table * res = columnar_table_plugin::get(get_plugin().mk_empty(get_signature()));
+        res->m_columns = m_columns;
+        res->m_sorted = m_sorted;
+        return res;
+    }
+
+    class columnar_table::our_iterator_core : public iterator_core {
+        const columnar_table & m_parent;
+        unsigned m_row;
+
+        class our_row : public row_interface {
+            const our_iterator_core & m_parent;
+        public:
+            our_row(const our_iterator_core & parent) : row_interface(parent.m_parent), m_parent(parent) {}
+
+            void get_fact(table_fact & result) const override {
+                m_parent.m_parent.get_row(m_parent.m_row, result);
+            }
+            table_element operator[](unsigned col) const override {
+                return m_parent.m_parent.m_columns[col][m_parent.m_row];
+            }
+        };
+
+        our_row m_row_obj;
+
+    public:
+        our_iterator_core(const columnar_table & t, bool finished) :
+            m_parent(t), m_row(finished ? t.num_rows() : 0), m_row_obj(*this) {}
+
+        bool is_finished() const override {
+            return m_row >= m_parent.num_rows();
+        }
+
+        row_interface & operator*() override {
+            SASSERT(!is_finished());
+            return m_row_obj;
+        }
+        void operator++() override {
+            SASSERT(!is_finished());
+            ++m_row;
+        }
+    };
+
+    table_base::iterator columnar_table::begin() const {
+        normalize();
+        return mk_iterator(alloc(our_iterator_core, *this, false));
+    }
+
+    table_base::iterator columnar_table::end() const {
+        return mk_iterator(alloc(our_iterator_core, *this, true));
+    }
+
+    // -----------------------------------
+    //
+    // columnar_table_plugin
+    //
+    // -----------------------------------
+
+    columnar_table const& columnar_table_plugin::get(table_base const& t) { return dynamic_cast<columnar_table const&>(t); }
+    columnar_table& columnar_table_plugin::get(table_base& t) { return dynamic_cast<columnar_table&>(t); }
+    columnar_table* columnar_table_plugin::get(table_base* t) { return dynamic_cast<columnar_table*>(t); }
+
+    table_base * columnar_table_plugin::mk_empty(const table_signature & s) {
+        SASSERT(can_handle_signature(s));
+        return alloc(columnar_table, *this, s);
+    }
+
+    /**
+       Both tables are sorted by their join columns and merged. Each pair of
+       rows with equal keys contributes a row of the result, whose columns are
+       then gathered column by column.
+    */
+    class columnar_table_plugin::join_project_fn : public convenient_table_join_project_fn {
+        unsigned        m_t1_cols;
+        unsigned_vector m_result_cols;  // columns of the concatenated rows that are kept
+        bool            m_sorted_result;
+    public:
+        join_project_fn(const table_signature & t1_sig, const table_signature & t2_sig, unsigned col_cnt,
+                const unsigned * cols1, const unsigned * cols2, unsigned removed_col_cnt,
+                const unsigned * removed_cols)
+            : convenient_table_join_project_fn(t1_sig, t2_sig, col_cnt, cols1, cols2,
+                removed_col_cnt, removed_cols),
+              m_t1_cols(t1_sig.size()) {
+            unsigned n = t1_sig.size() + t2_sig.size();
+            bool_vector removed(n, false);
+            for (unsigned i = 0; i < removed_col_cnt; ++i) {
+                removed[removed_cols[i]] = true;
+            }
+            for (unsigned i = 0; i < n; ++i) {
+                if (!removed[i]) {
+                    m_result_cols.push_back(i);
+                }
+            }
+            // when both tables are joined on a prefix of their columns, the merge
+            // produces the concatenated rows in lexicographic order
+            m_sorted_result = removed_col_cnt == 0 && is_prefix(m_cols1) && is_prefix(m_cols2);
+        }
+
+        table_base * operator()(const table_base & tb1, const table_base & tb2) override {
+            verbose_action  _va("join_project");
+            const columnar_table & t1 = get(tb1);
+            const columnar_table & t2 = get(tb2);
+            columnar_table * res = get(t1.get_plugin().mk_empty(get_result_signature()));
+            t1.normalize();
+            t2.normalize();
+            if (t1.empty() || t2.empty()) {
+                return res;
+            }
+
+            unsigned_vector rows1, rows2, sel1, sel2;
+            t1.sorted_by(m_cols1, rows1);
+            t2.sorted_by(m_cols2, rows2);
+            unsigned n1 = rows1.size(), n2 = rows2.size();
+            unsigned i = 0, j = 0;
+            while (i < n1 && j < n2) {
+                int c = columnar_table::compare_keys(t1, rows1[i], m_cols1, t2, rows2[j], m_cols2);
+                if (c < 0) {
+                    ++i;
+                    continue;
+                }
+                if (c > 0) {
+                    ++j;
+                    continue;
+                }
+                unsigned i_end = i + 1, j_end = j + 1;
+                while (i_end < n1 && columnar_table::compare_keys(t1, rows1[i], m_cols1, t1, rows1[i_end], m_cols1) == 0) {
+                    ++i_end;
+                }
+                while (j_end < n2 && columnar_table::compare_keys(t2, rows2[j], m_cols2, t2, rows2[j_end], m_cols2) == 0) {
+                    ++j_end;
+                }
+                for (unsigned x = i; x < i_end; ++x) {
+                    for (unsigned y = j; y < j_end; ++y) {
+                        sel1.push_back(rows1[x]);
+                        sel2.push_back(rows2[y]);
+                    }
+                }
+                i = i_end;
+                j = j_end;
+            }
+
+            for (unsigned k = 0; k < m_result_cols.size(); ++k) {
+                unsigned c = m_result_cols[k];
+                if (c < m_t1_cols) {
+                    gather(t1.m_columns[c], sel1, res->m_columns[k]);
+                }
+                else {
+                    gather(t2.m_columns[c - m_t1_cols], sel2, res->m_columns[k]);
+                }
+            }
+            if (m_sorted_result) {
+                res->m_sorted = res->num_rows();
+            }
+            return res;
+        }
+    };
+
+    table_join_fn * columnar_table_plugin::mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) {
+        if (!check_kind(t1) || !check_kind(t2)) {
+            return nullptr;
+        }
+        return alloc(join_project_fn, t1.get_signature(), t2.get_signature(), col_cnt, cols1, cols2, 0, nullptr);
+    }
+
+    table_join_fn * columnar_table_plugin::mk_join_project_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2, unsigned removed_col_cnt,
+            const unsigned * removed_cols) {
+        if (!check_kind(t1) || !check_kind(t2)
+            || removed_col_cnt == t1.get_signature().size() + t2.get_signature().size()) {
+            return nullptr;
+        }
+        return alloc(join_project_fn, t1.get_signature(), t2.get_signature(), col_cnt, cols1, cols2,
+            removed_col_cnt, removed_cols);
+    }
+
+    /**
+       The rows of the source that are not in the target are appended to the
+       target as pending rows. Both tables are sorted, so the search for each
+       source row starts where the search for the previous one ended.
+    */
+    class columnar_table_plugin::union_fn : public table_union_fn {
+    public:
+        void operator()(table_base & tgt0, const table_base & src0, table_base * delta0) override {
+            verbose_action  _va("union");
+            columnar_table & tgt = get(tgt0);
+            const columnar_table & src = get(src0);
+            columnar_table * delta = get(delta0);
+            if (&tgt == &src) {
+                return;
+            }
+            tgt.normalize();
+            src.normalize();
+
+            unsigned_vector added;
+            table_fact f;
+            unsigned lo = 0;
+            bool after_last = false;
+            for (unsigned r = 0; r < src.num_rows(); ++r) {
+                src.get_row(r, f);
+                lo = tgt.lower_bound(f.data(), lo);
+                if (lo < tgt.m_sorted && tgt.compare_row(lo, f.data()) == 0) {
+                    continue;
+                }
+                if (added.empty()) {
+                    after_last = lo == tgt.m_sorted;
+                }
+                added.push_back(r);
+            }
+            if (added.empty()) {
+                return;
+            }
+            for (unsigned k = 0; k < tgt.m_columns.size(); ++k) {
+                gather(src.m_columns[k], added, tgt.m_columns[k]);
+            }
+            if (after_last) {
+                tgt.m_sorted = tgt.num_rows();
+            }
+            if (delta) {
+                bool was_empty = delta->empty();
+                for (unsigned k = 0; k < delta->m_columns.size(); ++k) {
+                    gather(src.m_columns[k], added, delta->m_columns[k]);
+                }
+                if (was_empty) {
+                    delta->m_sorted = delta->num_rows();
+                }
+            }
+        }
+    };
+
+    table_union_fn * columnar_table_plugin::mk_union_fn(const table_base & tgt, const table_base & src,
+            const table_base * delta) {
+        if (!check_kind(tgt) || !check_kind(src) || (delta && !check_kind(*delta))
+            || tgt.get_signature() != src.get_signature()
+            || (delta && delta->get_signature() != tgt.get_signature())) {
+            return nullptr;
+        }
+        return alloc(union_fn);
+    }
+
+    class columnar_table_plugin::project_fn : public convenient_table_project_fn {
+        unsigned_vector m_result_cols;
+        bool            m_keeps_prefix;
+    public:
+        project_fn(const table_signature & orig_sig, unsigned removed_col_cnt, const unsigned * removed_cols)
+            : convenient_table_project_fn(orig_sig, removed_col_cnt, removed_cols) {
+            bool_vector removed(orig_sig.size(), false);
+            for (unsigned i = 0; i < removed_col_cnt; ++i) {
+                removed[removed_cols[i]] = true;
+            }
+            for (unsigned i = 0; i < orig_sig.size(); ++i) {
+                if (!removed[i]) {
+                    m_result_cols.push_back(i);
+                }
+            }
+            m_keeps_prefix = is_prefix(m_result_cols);
+        }
+
+        table_base * operator()(const table_base & tb) override {
+            verbose_action  _va("project");
+            const columnar_table & t = get(tb);
+            columnar_table * res = get(t.get_plugin().mk_empty(get_result_signature()));
+            t.normalize();
+            for (unsigned k = 0; k < m_result_cols.size(); ++k) {
+                res->m_columns[k] = t.m_columns[m_result_cols[k]];
+            }
+            if (m_keeps_prefix) {
+                // the rows are still sorted, so duplicates are adjacent
+                unsigned n = res->num_rows();
+                bool_vector duplicate(n, true);
+                if (n > 0) {
+                    duplicate[0] = false;
+                }
+                for (const column & c : res->m_columns) {
+                    const table_element * d = c.data();
+                    for (unsigned r = 1; r < n; ++r) {
+                        duplicate[r] = duplicate[r] & (d[r] == d[r - 1]);
+                    }
+                }
+                res->m_sorted = n;
+                res->remove_rows(duplicate);
+            }
+            return res;
+        }
+    };
+
+    table_transformer_fn * columnar_table_plugin::mk_project_fn(const table_base & t, unsigned col_cnt,
+            const unsigned * removed_cols) {
+        if (!check_kind(t) || col_cnt == t.get_signature().size()) {
+            return nullptr;
+        }
+        return alloc(project_fn, t.get_signature(), col_cnt, removed_cols);
+    }
+
+    class columnar_table_plugin::rename_fn : public convenient_table_rename_fn {
+    public:
+        rename_fn(const table_signature & orig_sig, unsigned permutation_cycle_len, const unsigned * permutation_cycle)
+            : convenient_table_rename_fn(orig_sig, permutation_cycle_len, permutation_cycle) {}
+
+        table_base * operator()(const table_base & tb) override {
+            verbose_action  _va("rename");
+            const columnar_table & t = get(tb);
+            columnar_table * res = get(t.get_plugin().mk_empty(get_result_signature()));
+            res->m_columns = t.m_columns;
+            for (unsigned i = 1; i < m_cycle.size(); ++i) {
+                res->m_columns[m_cycle[i - 1]].swap(res->m_columns[m_cycle[i]]);
+            }
+            return res;
+        }
+    };
+
+    table_transformer_fn * columnar_table_plugin::mk_rename_fn(const table_base & t, unsigned permutation_cycle_len,
+            const unsigned * permutation_cycle) {
+        if (!check_kind(t)) {
+            return nullptr;
+        }
+        return alloc(rename_fn, t.get_signature(), permutation_cycle_len, permutation_cycle);
+    }
+
+    class columnar_table_plugin::filter_equal_fn : public table_mutator_fn {
+        const table_element m_value;
+        const unsigned      m_col;
+        unsigned_vector     m_rows;
+    public:
+        filter_equal_fn(const table_element & value, unsigned col) : m_value(value), m_col(col) {}
+
+        void operator()(table_base & tb) override {
+            verbose_action  _va("filter_equal");
+            columnar_table & t = get(tb);
+            select_equal(t.m_columns[m_col], m_value, m_rows);
+            if (m_rows.size() < t.num_rows()) {
+                t.select(m_rows);
+            }
+        }
+    };
+
+    table_mutator_fn * columnar_table_plugin::mk_filter_equal_fn(const table_base & t, const table_element & value,
+            unsigned col) {
+        if (!check_kind(t)) {
+            return nullptr;
+        }
+        return alloc(filter_equal_fn, value, col);
+    }
+
+    class columnar_table_plugin::filter_identical_fn : public table_mutator_fn {
+        const unsigned_vector m_cols;
+        bool_vector           m_equal;
+        unsigned_vector       m_rows;
+    public:
+        filter_identical_fn(unsigned col_cnt, const unsigned * identical_cols)
+            : m_cols(col_cnt, identical_cols) {}
+
+        void operator()(table_base & tb) override {
+            verbose_action  _va("filter_identical");
+            columnar_table & t = get(tb);
+            unsigned n = t.num_rows();
+            m_equal.reset();
+            m_equal.resize(n, true);
+            const table_element * c0 = t.m_columns[m_cols[0]].data();
+            for (unsigned i = 1; i < m_cols.size(); ++i) {
+                const table_element * ci = t.m_columns[m_cols[i]].data();
+                for (unsigned r = 0; r < n; ++r) {
+                    m_equal[r] = m_equal[r] & (c0[r] == ci[r]);
+                }
+            }
+            select_marked(m_equal, true, m_rows);
+            if (m_rows.size() < n) {
+                t.select(m_rows);
+            }
+        }
+    };
+
+    table_mutator_fn * columnar_table_plugin::mk_filter_identical_fn(const table_base & t, unsigned col_cnt,
+            const unsigned * identical_cols) {
+        if (!check_kind(t) || col_cnt == 0) {
+            return nullptr;
+        }
+        return alloc(filter_identical_fn, col_cnt, identical_cols);
+    }
+
+    class columnar_table_plugin::select_equal_and_project_fn : public convenient_table_transformer_fn {
+        const table_element m_value;
+        const unsigned      m_col;
+    public:
+        select_equal_and_project_fn(const table_signature & orig_sig, table_element value, unsigned col)
+            : m_value(value), m_col(col) {
+            table_signature::from_project(orig_sig, 1, &col, get_result_signature());
+        }
+
+        table_base * operator()(const table_base & tb) override {
+            verbose_action  _va("select_equal_and_project");
+            const columnar_table & t = get(tb);
+            columnar_table * res = get(t.get_plugin().mk_empty(get_result_signature()));
+            t.normalize();
+            unsigned_vector rows;
+            if (m_col == 0) {
+                // the first column of a normalized table is sorted
+                const column & c = t.m_columns[0];
+                const table_element * lo = std::lower_bound(c.begin(), c.end(), m_value);
+                const table_element * hi = std::upper_bound(lo, c.end(), m_value);
+                for (unsigned r = static_cast<unsigned>(lo - c.begin()); r < static_cast<unsigned>(hi - c.begin()); ++r) {
+                    rows.push_back(r);
+                }
+            }
+            else {
+                select_equal(t.m_columns[m_col], m_value, rows);
+            }
+            unsigned k = 0;
+            for (unsigned i = 0; i < t.m_columns.size(); ++i) {
+                if (i != m_col) {
+                    gather(t.m_columns[i], rows, res->m_columns[k++]);
+                }
+            }
+            // dropping a column with a single value keeps the rows sorted and distinct
+            res->m_sorted = res->num_rows();
+            return res;
+        }
+    };
+
+    table_transformer_fn * columnar_table_plugin::mk_select_equal_and_project_fn(const table_base & t,
+            const table_element & value, unsigned col) {
+        if (!check_kind(t) || t.get_signature().size() == 1) {
+            return nullptr;
+        }
+        return alloc(select_equal_and_project_fn, t.get_signature(), value, col);
+    }
+
+    /**
+       Both tables are sorted by their joined columns and merged. Rows of the
+       target whose key occurs in the negated table are removed.
+    */
+    class columnar_table_plugin::negation_filter_fn : public convenient_table_negation_filter_fn {
+    public:
+        negation_filter_fn(const table_base & tgt, const table_base & neg,
+                unsigned joined_col_cnt, const unsigned * t_cols, const unsigned * negated_cols)
+            : convenient_table_negation_filter_fn(tgt, neg, joined_col_cnt, t_cols, negated_cols) {}
+
+        void operator()(table_base & tgt0, const table_base & neg0) override {
+            verbose_action  _va("filter_by_negation");
+            columnar_table & t = get(tgt0);
+            const columnar_table & neg = get(neg0);
+            if (t.empty() || neg.empty()) {
+                return;
+            }
+            t.normalize();
+            neg.normalize();
+            unsigned_vector rows1, rows2;
+            t.sorted_by(m_cols1, rows1);
+            neg.sorted_by(m_cols2, rows2);
+            bool_vector removed(t.num_rows(), false);
+            unsigned n1 = rows1.size(), n2 = rows2.size();
+            unsigned i = 0, j = 0;
+            while (i < n1 && j < n2) {
+                int c = columnar_table::compare_keys(t, rows1[i], m_cols1, neg, rows2[j], m_cols2);
+                if (c < 0) {
+                    ++i;
+                }
+                else if (c > 0) {
+                    ++j;
+                }
+                else {
+                    removed[rows1[i++]] = true;
+                }
+            }
+            t.remove_rows(removed);
+        }
+    };
+
+    table_intersection_filter_fn * columnar_table_plugin::mk_filter_by_negation_fn(const table_base & t,
+            const table_base & negated_obj, unsigned joined_col_cnt,
+            const unsigned * t_cols, const unsigned * negated_cols) {
+        if (!check_kind(t) || !check_kind(negated_obj)) {
+            return nullptr;
+        }
+        return alloc(negation_filter_fn, t, negated_obj, joined_col_cnt, t_cols, negated_cols);
+    }
+
+};
+
@@ -0,0 +1,170 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    dl_columnar_table.h
+
+Abstract:
+
+    Table that stores each column in a separate array.
+
+    The rows of a normalized table are sorted lexicographically and
+    distinct. Added rows are appended unsorted and merged into the
+    sorted rows, using a radix sort, before the table is read again.
+    Joins and negation filters merge the two tables on their sorted keys
+    and filters select rows with branch free loops over single columns,
+    which compilers can vectorize.
+
+--*/
+
+#pragma once
+
+#include "util/vector.h"
+#include "muz/rel/dl_base.h"
+
+
+namespace datalog {
+
+    class columnar_table;
+
+    class columnar_table_plugin : public table_plugin {
+        friend class columnar_table;
+    protected:
+        class join_project_fn;
+        class union_fn;
+        class project_fn;
+        class rename_fn;
+        class filter_equal_fn;
+        class filter_identical_fn;
+        class select_equal_and_project_fn;
+        class negation_filter_fn;
+
+    public:
+        typedef columnar_table table;
+
+        columnar_table_plugin(relation_manager & manager)
+            : table_plugin(symbol("columnar"), manager) {}
+
+        bool can_handle_signature(const table_signature & s) override
+        { return !s.empty() && s.functional_columns() == 0; }
+
+        table_base * mk_empty(const table_signature & s) override;
+
+    protected:
+        table_join_fn * mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) override;
+        table_join_fn * mk_join_project_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2, unsigned removed_col_cnt,
+            const unsigned * removed_cols) override;
+        table_union_fn * mk_union_fn(const table_base & tgt, const table_base & src,
+            const table_base * delta) override;
+        table_transformer_fn * mk_project_fn(const table_base & t, unsigned col_cnt,
+            const unsigned * removed_cols) override;
+        table_transformer_fn * mk_rename_fn(const table_base & t, unsigned permutation_cycle_len,
+            const unsigned * permutation_cycle) override;
+        table_mutator_fn * mk_filter_equal_fn(const table_base & t, const table_element & value,
+            unsigned col) override;
+        table_mutator_fn * mk_filter_identical_fn(const table_base & t, unsigned col_cnt,
+            const unsigned * identical_cols) override;
+        table_transformer_fn * mk_select_equal_and_project_fn(const table_base & t,
+            const table_element & value, unsigned col) override;
+        table_intersection_filter_fn * mk_filter_by_negation_fn(const table_base & t,
+            const table_base & negated_obj, unsigned joined_col_cnt,
+            const unsigned * t_cols, const unsigned * negated_cols) override;
+
+        static columnar_table const& get(table_base const&);
+        static columnar_table& get(table_base&);
+        static columnar_table* get(table_base*);
+    };
+
+    class columnar_table : public table_base {
+        friend class columnar_table_plugin;
+        friend class columnar_table_plugin::join_project_fn;
+        friend class columnar_table_plugin::union_fn;
+        friend class columnar_table_plugin::project_fn;
+        friend class columnar_table_plugin::rename_fn;
+        friend class columnar_table_plugin::filter_equal_fn;
+        friend class columnar_table_plugin::filter_identical_fn;
+        friend class columnar_table_plugin::select_equal_and_project_fn;
+        friend class columnar_table_plugin::negation_filter_fn;
+
+        class our_iterator_core;
+
+        typedef svector<table_element> column;
+
+        /**
+           Rows [0, m_sorted) are sorted and distinct, the rows after them were
+           added since the last normalization. Reading operations normalize the
+           table first, so the members are mutable.
+        */
+        mutable vector<column> m_columns;
+        mutable unsigned       m_sorted = 0;
+
+        columnar_table(columnar_table_plugin & plugin, const table_signature & sig);
+
+        unsigned num_rows() const { return m_columns[0].size(); }
+        unsigned num_pending() const { return num_rows() - m_sorted; }
+
+        void append_row(const table_element * f);
+        void get_row(unsigned r, table_fact & f) const;
+
+        int compare_rows(unsigned r1, unsigned r2) const;
+        int compare_row(unsigned r, const table_element * f) const;
+        static int compare_keys(const columnar_table & t1, unsigned r1, const unsigned_vector & cols1,
+            const columnar_table & t2, unsigned r2, const unsigned_vector & cols2);
+
+        /**
+           \brief Return the first sorted row in [lo, m_sorted) that is not smaller than \c f.
+        */
+        unsigned lower_bound(const table_element * f, unsigned lo) const;
+
+        /**
+           \brief Sort the pending rows and merge them into the sorted rows.
+        */
+        void normalize() const;
+
+        /**
+           \brief Sort the row indices \c rows by the values of the columns \c cols.
+        */
+        void sort_rows(const unsigned_vector & cols, unsigned_vector & rows) const;
+
+        /**
+           \brief Store into \c rows the rows of the normalized table, sorted by \c cols.
+        */
+        void sorted_by(const unsigned_vector & cols, unsigned_vector & rows) const;
+
+        /**
+           \brief Keep only the rows \c rows, which must be in increasing order.
+        */
+        void select(const unsigned_vector & rows);
+
+        /**
+           \brief Remove the rows marked in \c removed.
+        */
+        void remove_rows(const bool_vector & removed);
+
+    public:
+        columnar_table_plugin & get_plugin() const
+        { return static_cast<columnar_table_plugin &>(table_base::get_plugin()); }
+
+        void add_fact(const table_fact & f) override;
+        void remove_fact(const table_element * fact) override;
+        void remove_facts(unsigned fact_cnt, const table_fact * facts) override;
+        void remove_facts(unsigned fact_cnt, const table_element * facts) override;
+        bool contains_fact(const table_fact & f) const override;
+        void reset() override;
+        table_base * clone() const override;
+        bool empty() const override { return num_rows() == 0; }
+
+        iterator begin() const override;
+        iterator end() const override;
+
+        unsigned get_size_estimate_rows() const override { return num_rows(); }
+        unsigned get_size_estimate_bytes() const override
+        { return num_rows() * m_columns.size() * sizeof(table_element); }
+        bool knows_exact_size() const override { return num_pending() == 0; }
+    };
+
+};
+
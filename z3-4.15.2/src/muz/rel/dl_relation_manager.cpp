@@ -72,14 +72,41 @@ namespace datalog {
         m_pred_kinds.insert(pred, kind);
     }
 
+    /**
+       \brief Return true if \c name occurs in the comma separated list \c names.
+    */
+    static bool occurs_in_list(symbol const& names, symbol const& name) {
+        std::string const s = names.str();
+        std::string const n = name.str();
+        size_t start = 0;
+        while (true) {
+            size_t end = s.find(',', start);
+            std::string item = s.substr(start, end == std::string::npos ? std::string::npos : end - start);
+            size_t b = item.find_first_not_of(" \t");
+            size_t e = item.find_last_not_of(" \t");
+            if (b != std::string::npos && item.compare(b, e - b + 1, n) == 0) {
+                return true;
+            }
+            if (end == std::string::npos) {
+                return false;
+            }
+            start = end + 1;
+        }
+    }
+
     family_id relation_manager::get_requested_predicate_kind(func_decl * pred) {
         family_id res;
         if(m_pred_kinds.find(pred, res)) {
             return res;
         }
-        else {
-            return null_family_id;
+        symbol columnar = get_context().columnar_relations();
+        if (!columnar.is_null() && occurs_in_list(columnar, pred->get_name())) {
+            table_plugin * tp = get_table_plugin(symbol("columnar"));
+            if (tp) {
+                return get_table_relation_plugin(*tp).get_kind();
+            }
         }
+        return null_family_id;
     }
 
     relation_base & relation_manager::get_relation(func_decl * pred) {
@@ -135,7 +135,8 @@ namespace datalog {
         void set_predicate_kind(func_decl * pred, family_id kind);
         /**
            Return the relation kind that was requested to represent the predicate \c pred by 
-           \c set_predicate_kind. If there was no such request, return \c null_family_id.
+           \c set_predicate_kind. Predicates listed in \c datalog.columnar_relations request
+           columnar tables. If there was no such request, return \c null_family_id.
         */
         family_id get_requested_predicate_kind(func_decl * pred);
         relation_base & get_relation(func_decl * pred);
@@ -17,7 +17,12 @@ Revision History:
 
 --*/
 
+#include<algorithm>
 #include<utility>
+#ifndef SINGLE_THREAD
+#include<thread>
+#endif
+#include "util/hash.h"
 #include "muz/base/dl_context.h"
 #include "muz/base/dl_util.h"
 #include "muz/rel/dl_sparse_table.h"
@@ -729,6 +734,100 @@ namespace datalog {
         }
     }
 
+    void sparse_table::parallel_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, unsigned num_threads, sparse_table & result) {
+#ifdef SINGLE_THREAD
+        self_agnostic_join_project(t1, t2, joined_col_cnt, t1_joined_cols, t2_joined_cols, removed_cols, tables_swapped, result);
+#else
+        verbose_action _va("parallel_join_project", 1);
+        SASSERT(joined_col_cnt > 0);
+        unsigned t1_entry_size = t1.m_fact_size;
+        unsigned t2_entry_size = t2.m_fact_size;
+        unsigned res_entry_size = result.m_fact_size;
+        unsigned n1 = static_cast<unsigned>(t1.m_data.after_last_offset() / t1_entry_size);
+        unsigned n2 = static_cast<unsigned>(t2.m_data.after_last_offset() / t2_entry_size);
+
+        auto key_hash = [&](const sparse_table & t, const unsigned * cols, const char * ptr) {
+            unsigned h = 0;
+            for (unsigned i = 0; i < joined_col_cnt; i++)
+                h = combine_hash(h, hash_ull(t.m_column_layout.get(ptr, cols[i])));
+            return h;
+        };
+        auto run = [&](auto const & f) {
+            std::vector<std::thread> threads;
+            for (unsigned p = 0; p < num_threads; ++p)
+                threads.push_back(std::thread([&, p]() { f(p); }));
+            for (auto & th : threads)
+                th.join();
+        };
+
+        // hash the join keys of both tables, each thread takes a range of rows.
+        unsigned_vector h1(n1), h2(n2);
+        run([&](unsigned p) {
+            for (unsigned i = p; i < n1; i += num_threads)
+                h1[i] = key_hash(t1, t1_joined_cols, t1.get_at_offset(i * t1_entry_size));
+            for (unsigned i = p; i < n2; i += num_threads)
+                h2[i] = key_hash(t2, t2_joined_cols, t2.get_at_offset(i * t2_entry_size));
+        });
+
+        // join the rows whose keys hash to partition p into a local buffer.
+        std::vector<svector<char>> buffers(num_threads);
+        bool_vector out_of_memory(num_threads, false);
+        run([&](unsigned p) {
+            try {
+                std::vector<std::pair<unsigned, store_offset>> index;
+                for (unsigned j = 0; j < n2; ++j)
+                    if (h2[j] % num_threads == p)
+                        index.push_back({ h2[j], j * static_cast<store_offset>(t2_entry_size) });
+                std::sort(index.begin(), index.end());
+                svector<char> & buffer = buffers[p];
+                for (unsigned i = 0; i < n1; ++i) {
+                    if (h1[i] % num_threads != p)
+                        continue;
+                    const char * t1ptr = t1.get_at_offset(i * static_cast<store_offset>(t1_entry_size));
+                    auto it = std::lower_bound(index.begin(), index.end(), std::make_pair(h1[i], static_cast<store_offset>(0)));
+                    for (; it != index.end() && it->first == h1[i]; ++it) {
+                        const char * t2ptr = t2.get_at_offset(it->second);
+                        bool eq = true;
+                        for (unsigned k = 0; eq && k < joined_col_cnt; k++)
+                            eq = t1.m_column_layout.get(t1ptr, t1_joined_cols[k]) == t2.m_column_layout.get(t2ptr, t2_joined_cols[k]);
+                        if (!eq)
+                            continue;
+                        // column writes may touch up to a word past the end of the row
+                        unsigned sz = buffer.size();
+                        buffer.resize(sz + res_entry_size + sizeof(uint64_t), 0);
+                        char * res = buffer.data() + sz;
+                        if (tables_swapped) {
+                            concatenate_rows(t2.m_column_layout, t1.m_column_layout, result.m_column_layout,
+                                t2ptr, t1ptr, res, removed_cols);
+                        } else {
+                            concatenate_rows(t1.m_column_layout, t2.m_column_layout, result.m_column_layout,
+                                t1ptr, t2ptr, res, removed_cols);
+                        }
+                        buffer.shrink(sz + res_entry_size);
+                    }
+                }
+            }
+            catch (z3_exception &) {
+                out_of_memory[p] = true;
+            }
+        });
+        for (bool oom : out_of_memory)
+            if (oom)
+                throw out_of_memory_error();
+
+        for (svector<char> const & buffer : buffers) {
+            for (unsigned ofs = 0; ofs < buffer.size(); ofs += res_entry_size) {
+                result.m_data.ensure_reserve();
+                result.garbage_collect();
+                memcpy(result.m_data.get_reserve_ptr(), buffer.data() + ofs, res_entry_size);
+                result.add_reserve_content();
+            }
+        }
+#endif
+    }
+
 
     // -----------------------------------
     //
@@ -814,6 +913,7 @@ namespace datalog {
 
 
     class sparse_table_plugin::join_project_fn : public convenient_table_join_project_fn {
+        static const unsigned min_parallel_rows = 10000;
     public:
         join_project_fn(const table_signature & t1_sig, const table_signature & t2_sig, unsigned col_cnt, 
                 const unsigned * cols1, const unsigned * cols2, unsigned removed_col_cnt, 
@@ -836,7 +936,13 @@ namespace datalog {
             //do indexing into the bigger one. If we simply do a product, we want the bigger
             //one to be at the outer iteration (then the small one will hopefully fit into 
             //the cache)
-            if ( (t1.row_count() > t2.row_count()) == (!m_cols1.empty()) ) {
+            //Large joins on some columns are hash partitioned over the threads.
+            unsigned num_threads = plugin.get_context().threads();
+            if (num_threads > 1 && !m_cols1.empty() && t1.row_count() + t2.row_count() >= min_parallel_rows) {
+                sparse_table::parallel_join_project(t1, t2, m_cols1.size(), m_cols1.data(), 
+                    m_cols2.data(), m_removed_cols.data(), false, num_threads, *res);
+            }
+            else if ( (t1.row_count() > t2.row_count()) == (!m_cols1.empty()) ) {
                 sparse_table::self_agnostic_join_project(t2, t1, m_cols1.size(), m_cols2.data(), 
                     m_cols1.data(), m_removed_cols.data(), true, *res);
             }
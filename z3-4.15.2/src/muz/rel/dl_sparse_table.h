@@ -451,6 +451,17 @@ namespace datalog {
             unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
             const unsigned * removed_cols, bool tables_swapped, sparse_table & result);
 
+        /**
+           \brief Perform join-project between t1 and t2 using \c num_threads threads.
+
+           The rows of both tables are partitioned by the hash of their join key. Each thread
+           joins one partition into a local buffer, and the buffers are merged into \c result.
+           The arguments are as for \c self_agnostic_join_project.
+        */
+        static void parallel_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, unsigned num_threads, sparse_table & result);
+
 
         /**
            If the fact at \c data (in table's native representation) is not in the table,
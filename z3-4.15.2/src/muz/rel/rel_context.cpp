@@ -35,6 +35,7 @@ Revision History:
 #include "muz/rel/udoc_relation.h"
 #include "muz/rel/check_relation.h"
 #include "muz/rel/dl_lazy_table.h"
+#include "muz/rel/dl_columnar_table.h"
 #include "muz/rel/dl_sparse_table.h"
 #include "muz/rel/dl_table.h"
 #include "muz/rel/dl_table_relation.h"
@@ -108,6 +109,7 @@ namespace datalog {
         rm.register_plugin(alloc(hashtable_table_plugin, rm));
         rm.register_plugin(alloc(bitvector_table_plugin, rm));
         rm.register_plugin(lazy_table_plugin::mk_sparse(rm));
+        rm.register_plugin(alloc(columnar_table_plugin, rm));
 
         // register plugins for builtin relations
 
@@ -31,6 +31,12 @@ Notes:
 #include "opt/opt_preprocess.h"
 #include "smt/theory_wmaxsat.h"
 #include "smt/theory_pb.h"
+#include "smt/smt_solver.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 
 namespace opt {
@@ -61,25 +67,31 @@ namespace opt {
         return m_c.get_solver(); 
     }
 
-    void maxsmt_solver_base::commit_assignment() {
+    // require the soft constraints to be satisfied at least as much as in their assignment.
+    static void commit_soft(solver& s, vector<soft> const& soft) {
+        ast_manager& m = s.get_manager();
         expr_ref tmp(m);
         expr_ref_vector fmls(m);
         rational k(0), cost(0);
         vector<rational> weights;
-        for (soft const& s : m_soft) {
-            if (s.is_true()) {
-                k += s.weight;
+        for (auto const& sf : soft) {
+            if (sf.is_true()) {
+                k += sf.weight;
             }
             else {
-                cost += s.weight;
+                cost += sf.weight;
             }
-            weights.push_back(s.weight);
-            fmls.push_back(s.s);
+            weights.push_back(sf.weight);
+            fmls.push_back(sf.s);
         }       
         pb_util pb(m);
         tmp = pb.mk_ge(weights.size(), weights.data(), fmls.data(), k);
         TRACE(opt, tout << "cost: " << cost << "\n" << tmp << "\n";);
-        s().assert_expr(tmp);
+        s.assert_expr(tmp);
+    }
+
+    void maxsmt_solver_base::commit_assignment() {
+        commit_soft(s(), m_soft);
     }
 
     bool maxsmt_solver_base::init() {
@@ -167,6 +179,7 @@ namespace opt {
 
 
     void maxsmt_solver_base::trace_bounds(char const * solver) {
+        m_c.bounds_updated(m_index, m_lower, m_upper);
         IF_VERBOSE(1, 
                    rational l = m_c.adjust(m_index, m_lower);
                    rational u = m_c.adjust(m_index, m_upper);
@@ -181,11 +194,22 @@ namespace opt {
     lbool maxsmt::operator()(bool committed) {
         lbool is_sat = l_undef;
         m_msolver = nullptr;
+        m_has_result = false;
         opt_params optp(m_params);
         symbol const& maxsat_engine = m_c.maxsat_engine();
         IF_VERBOSE(1, verbose_stream() << "(maxsmt)\n";);
         TRACE(opt_verbose, s().display(tout << "maxsmt\n") << "\n";);
-        if (!committed && optp.maxlex_enable() && is_maxlex(m_soft)) 
+        bool maxlex = !committed && optp.maxlex_enable() && is_maxlex(m_soft);
+        if (optp.threads() > 1 && !maxlex && !m_soft.empty() && 
+            maxsat_engine != symbol("wmax") && maxsat_engine != symbol("sortmax")) {
+            try {
+                return run_portfolio(committed, optp.threads());
+            }
+            catch (z3_exception& ex) {
+                IF_VERBOSE(1, verbose_stream() << "(maxsmt.parallel " << ex.what() << ")\n");
+            }
+        }
+        if (maxlex) 
             m_msolver = mk_maxlex(m_c, m_index, m_soft);            
         else if (m_soft.empty() || maxsat_engine == symbol("maxres") || maxsat_engine == symbol::null)             
             m_msolver = mk_maxres(m_c, m_index, m_soft);            
@@ -250,6 +274,9 @@ namespace opt {
         if (m_msolver) {
             return m_msolver->get_assignment(idx);
         }
+        else if (m_has_result) {
+            return m_soft[idx].is_true();
+        }
         else {
             return true;
         }
@@ -290,6 +317,9 @@ namespace opt {
         if (m_msolver) {
             m_msolver->commit_assignment();
         }
+        else if (m_has_result) {
+            commit_soft(s(), m_soft);
+        }
     }
 
     void maxsmt::add(expr* f, rational const& w) {
@@ -396,6 +426,266 @@ namespace opt {
         }
     };
 
+    // bounds shared by a portfolio of MaxSMT solvers.
+    // The solvers are canceled once the bounds meet.
+    class maxsmt_bounds {
+        mutex                m_mux;
+        rational             m_lower;
+        rational             m_upper;
+        bool                 m_done = false;
+        ptr_vector<reslimit> m_limits;
+
+        void stop() {
+            m_done = true;
+            for (reslimit* l : m_limits)
+                l->cancel();
+        }
+
+        void check() {
+            if (!m_done && m_lower >= m_upper)
+                stop();
+        }
+
+    public:
+        maxsmt_bounds(rational const& upper): m_upper(upper) {}
+
+        void add_limit(reslimit& l) { m_limits.push_back(&l); }
+
+        void update_lower(rational const& l) {
+            lock_guard lock(m_mux);
+            if (l > m_lower)
+                m_lower = l;
+            check();
+        }
+
+        void update_upper(rational const& u) {
+            lock_guard lock(m_mux);
+            if (u < m_upper)
+                m_upper = u;
+            check();
+        }
+
+        void finish() {
+            lock_guard lock(m_mux);
+            if (!m_done)
+                stop();
+        }
+
+        rational const& lower() const { return m_lower; }
+        bool met() const { return m_lower >= m_upper; }
+    };
+
+    static rational cost(model& mdl, vector<soft> const& soft) {
+        rational r;
+        for (auto const& s : soft)
+            if (!mdl.is_true(s.s))
+                r += s.weight;
+        return r;
+    }
+
+    // context of a MaxSMT solver running in a thread.
+    // It keeps the best model and publishes bounds.
+    class worker_maxsat_context : public solver_maxsat_context {
+        vector<soft> const& m_soft;
+        maxsmt_bounds*      m_bounds;
+    public:
+        model_ref m_best;
+        rational  m_best_cost;
+
+        worker_maxsat_context(params_ref& p, solver* s, model* mdl, vector<soft> const& soft, maxsmt_bounds* b):
+            solver_maxsat_context(p, s, mdl), m_soft(soft), m_bounds(b) {}
+
+        void model_updated(model* mdl) override {
+            if (!mdl)
+                return;
+            rational c = cost(*mdl, m_soft);
+            if (m_best && c >= m_best_cost)
+                return;
+            m_best = mdl->copy();
+            m_best_cost = c;
+            if (m_bounds)
+                m_bounds->update_upper(c);
+        }
+
+        void bounds_updated(unsigned id, rational const& lower, rational const& upper) override {
+            if (m_bounds)
+                m_bounds->update_lower(adjust(id, lower));
+        }
+    };
+
+    // opt_solver is tied to its context, so its assertions are copied into an SMT solver.
+    static solver* copy_solver(solver& s, ast_manager& m, params_ref const& p) {
+        if (!dynamic_cast<opt_solver*>(&s))
+            return s.translate(m, p);
+        ast_translation tr(s.get_manager(), m);
+        expr_ref_vector fmls(s.get_manager());
+        s.get_assertions(fmls);
+        solver* r = mk_smt_solver(m, p, symbol::null);
+        for (expr* f : fmls)
+            r->assert_expr(tr(f));
+        return r;
+    }
+
+    void solve_parallel(maxsat_context& c, std::vector<maxsmt_job>& jobs, bool portfolio, bool committed) {
+#ifdef SINGLE_THREAD
+        throw default_exception("parallel MaxSMT is not available in single threaded mode");
+#else
+        ast_manager& m = c.get_manager();
+        unsigned n = jobs.size();
+        model_ref base;
+        c.get_base_model(base);
+        maxsmt_bounds bounds(portfolio ? cost(*base, *jobs[0].m_soft) : rational::zero());
+        scoped_ptr_vector<ast_manager> pms;
+        scoped_limits sl(m.limit());
+        // the worker contexts refer to their soft constraints.
+        vector<vector<soft>> softs(n);
+        std::vector<params_ref> params;
+        scoped_ptr_vector<worker_maxsat_context> ctxs;
+        svector<lbool> results(n, l_undef);
+        for (unsigned i = 0; i < n; ++i) {
+            ast_manager* new_m = alloc(ast_manager, m, true);
+            pms.push_back(new_m);
+            ast_translation tr(m, *new_m);
+            params.push_back(jobs[i].m_params);
+            params[i].set_uint("threads", 1);
+            for (auto const& s : *jobs[i].m_soft)
+                softs[i].push_back(soft(expr_ref(tr(s.s.get()), *new_m), s.weight, false));
+            solver* s = copy_solver(c.get_solver(), *new_m, params[i]);
+            model_ref mdl = base->translate(tr);
+            ctxs.push_back(alloc(worker_maxsat_context, params[i], s, mdl.get(), softs[i], portfolio ? &bounds : nullptr));
+            sl.push_child(&(new_m->limit()));
+            if (portfolio)
+                bounds.add_limit(new_m->limit());
+        }
+
+        auto worker_thread = [&](unsigned i) {
+            worker_maxsat_context& ctx = *ctxs[i];
+            try {
+                maxsmt ms(ctx, 0);
+                ms.updt_params(params[i]);
+                for (auto const& s : softs[i])
+                    ms.add(s.s, s.weight);
+                results[i] = ms(committed);
+                if (results[i] != l_false) {
+                    model_ref mdl;
+                    svector<symbol> labels;
+                    ms.get_model(mdl, labels);
+                    ctx.model_updated(mdl.get());
+                }
+            }
+            catch (z3_exception& ex) {
+                IF_VERBOSE(1, verbose_stream() << "(maxsmt.parallel " << ex.what() << ")\n");
+                results[i] = l_undef;
+            }
+            if (portfolio && results[i] == l_true)
+                bounds.finish();
+        };
+        vector<std::thread> threads(n);
+        for (unsigned i = 0; i < n; ++i)
+            threads[i] = std::thread([&, i]() { worker_thread(i); });
+        for (auto& th : threads)
+            th.join();
+
+        for (unsigned i = 0; i < n; ++i) {
+            auto& job = jobs[i];
+            auto& ctx = *ctxs[i];
+            job.m_result = results[i];
+            job.m_lower = portfolio ? bounds.lower() : rational::zero();
+            if (portfolio && bounds.met())
+                job.m_result = l_true;
+            job.m_model = nullptr;
+            if (!ctx.m_best)
+                continue;
+            ctx.fm()(ctx.m_best);
+            ast_translation tr(*pms[i], m);
+            job.m_model = ctx.m_best->translate(tr);
+            job.m_cost = ctx.m_best_cost;
+            if (job.m_result == l_true)
+                job.m_lower = job.m_cost;
+        }
+#endif
+    }
+
+    void maxsmt::set_result(maxsmt_job const& job, rational const& upper) {
+        m_msolver = nullptr;
+        m_has_result = true;
+        m_lower = job.m_lower;
+        m_upper = upper;
+        m_model = job.m_model.get();
+        m_labels.reset();
+        if (m_model)
+            for (soft& s : m_soft)
+                s.set_value(m_model->is_true(s.s));
+    }
+
+    /**
+       Run a portfolio of MaxSMT engines on copies of the solver. The
+       engines share lower and upper bounds, so a model found by one engine
+       is proved optimal by the lower bound of another. One engine uses
+       LNS to improve upper bounds.
+    */
+    lbool maxsmt::run_portfolio(bool committed, unsigned num_threads) {
+        symbol engines[5] = { m_c.maxsat_engine(), symbol("maxres"), symbol("rc2"), symbol("maxres-bin"), symbol("pd-maxres") };
+        std::vector<maxsmt_job> jobs;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            params_ref p(m_c.params());
+            p.copy(m_params);
+            symbol engine = engines[i % 5];
+            if (engine == symbol::null)
+                engine = symbol("maxres");
+            p.set_sym("maxsat_engine", engine);
+            p.set_bool("enable_lns", i == 1 || p.get_bool("enable_lns", false));
+            p.set_uint("random_seed", i);
+            jobs.push_back(maxsmt_job(m_soft, p));
+        }
+        IF_VERBOSE(1, verbose_stream() << "(maxsmt.parallel :threads " << num_threads << ")\n";);
+        solve_parallel(m_c, jobs, true, committed);
+        unsigned best = UINT_MAX;
+        for (unsigned i = 0; i < jobs.size(); ++i)
+            if (jobs[i].m_model && (best == UINT_MAX || jobs[i].m_cost < jobs[best].m_cost))
+                best = i;
+        if (best == UINT_MAX)
+            return l_undef;
+        auto const& job = jobs[best];
+        lbool r = l_undef;
+        for (auto const& j : jobs) {
+            if (j.m_result == l_false)
+                return l_false;
+            if (j.m_result == l_true)
+                r = l_true;
+        }
+        set_result(job, job.m_cost);
+        if (r == l_true)
+            m_lower = job.m_cost;
+        m_c.model_updated(m_model.get());
+        return r;
+    }
+
+    /**
+       Solve independent MaxSMT objectives, each on a copy of the solver.
+    */
+    lbool maxsmt::solve_box(maxsat_context& c, ptr_vector<maxsmt> const& mss, unsigned num_threads) {
+        lbool r = l_true;
+        for (unsigned i = 0; i < mss.size(); i += num_threads) {
+            std::vector<maxsmt_job> jobs;
+            for (unsigned j = i; j < mss.size() && j < i + num_threads; ++j) {
+                params_ref p(c.params());
+                p.copy(mss[j]->m_params);
+                jobs.push_back(maxsmt_job(mss[j]->m_soft, p));
+            }
+            solve_parallel(c, jobs, false, false);
+            for (unsigned j = 0; j < jobs.size(); ++j) {
+                auto const& job = jobs[j];
+                maxsmt& ms = *mss[i + j];
+                if (job.m_model)
+                    ms.set_result(job, job.m_cost);
+                if (r == l_true && job.m_result != l_true)
+                    r = job.m_result;
+            }
+        }
+        return r;
+    }
+
     lbool maxsmt_wrapper::operator()(vector<std::pair<expr*,rational>>& soft) {
         solver_maxsat_context ctx(m_params, m_solver.get(), m_model.get());
         maxsmt maxsmt(ctx, 0);
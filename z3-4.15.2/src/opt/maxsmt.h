@@ -122,6 +122,27 @@ namespace opt {
        Returns modified soft constraints that are maximal assignments.
     */
 
+    /**
+       \brief A MaxSMT problem solved on a copy of the solver of a context.
+       The model and bounds are in terms of the context.
+    */
+    struct maxsmt_job {
+        vector<soft> const* m_soft;
+        params_ref          m_params;
+        lbool               m_result = l_undef;
+        rational            m_lower;
+        rational            m_cost;
+        model_ref           m_model;
+        maxsmt_job(vector<soft> const& s, params_ref const& p): m_soft(&s), m_params(p) {}
+    };
+
+    /**
+       \brief Solve each job on a copy of the solver of c, in its own thread and
+       ast_manager. Portfolio jobs solve the same soft constraints: they share
+       lower and upper bounds and stop when the bounds meet.
+    */
+    void solve_parallel(maxsat_context& c, std::vector<maxsmt_job>& jobs, bool portfolio, bool committed);
+
     class maxsmt {
         ast_manager&              m;
         maxsat_context&           m_c;
@@ -135,9 +156,11 @@ namespace opt {
         model_ref        m_model;
         svector<symbol>  m_labels;
         params_ref       m_params;
+        bool             m_has_result = false; // result was set by parallel solvers
     public:
         maxsmt(maxsat_context& c, unsigned id);
         lbool operator()(bool committed);
+        static lbool solve_box(maxsat_context& c, ptr_vector<maxsmt> const& mss, unsigned num_threads);
         void updt_params(params_ref& p);
         void add(expr* f, rational const& w); 
         unsigned size() const { return m_soft.size(); }
@@ -155,6 +178,8 @@ namespace opt {
         void model_updated(model* mdl);
         void reset_upper();
     private:
+        lbool run_portfolio(bool committed, unsigned num_threads);
+        void set_result(maxsmt_job const& job, rational const& upper);
         bool is_maxsat_problem(weights_t& ws) const;        
         void verify_assignment();
         solver& s();
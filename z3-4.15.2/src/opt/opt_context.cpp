@@ -546,9 +546,15 @@ namespace opt {
         m_box_index = 1;
         m_box_models.reset();
         lbool r = m_optsmt.box();
+        unsigned num_threads = opt_params(m_params).threads();
+        bool parallel = r == l_true && num_threads > 1 && execute_box_maxsat(num_threads) == l_true;
         for (unsigned i = 0, j = 0; r == l_true && i < m_objectives.size(); ++i) {
             objective const& obj = m_objectives[i];
-            if (obj.m_type == O_MAXSMT) {
+            if (obj.m_type == O_MAXSMT && parallel) {
+                m_maxsmts.find(obj.m_id)->get_model(m_model, m_labels);
+                m_box_models.push_back(m_model.get());
+            }
+            else if (obj.m_type == O_MAXSMT) {
                 solver::scoped_push _sp(get_solver());
                 r = execute(obj, false, false);
                 m_box_models.push_back(m_model.get());
@@ -567,6 +573,26 @@ namespace opt {
         return r;
     }
 
+    /**
+       \brief solve the MaxSMT objectives of box mode in parallel.
+       Returns l_true if all of them were solved.
+    */
+    lbool context::execute_box_maxsat(unsigned num_threads) {
+        ptr_vector<maxsmt> mss;
+        for (objective const& obj : m_objectives)
+            if (obj.m_type == O_MAXSMT)
+                mss.push_back(m_maxsmts.find(obj.m_id));
+        if (mss.size() < 2)
+            return l_undef;
+        try {
+            return maxsmt::solve_box(*this, mss, num_threads);
+        }
+        catch (z3_exception& ex) {
+            IF_VERBOSE(1, verbose_stream() << "(opt.box " << ex.what() << ")\n");
+            return l_undef;
+        }
+    }
+
     expr_ref context::mk_le(unsigned i, model_ref& mdl) {
         objective const& obj = m_objectives[i];
         return mk_cmp(false, mdl, obj);
@@ -61,6 +61,7 @@ namespace opt {
         virtual void add_offset(unsigned id, rational const& o) = 0;
         virtual void set_model(model_ref& _m) = 0;
         virtual void model_updated(model* mdl) = 0;
+        virtual void bounds_updated(unsigned id, rational const& lower, rational const& upper) {} // bounds of a MaxSMT solver changed.
     };
 
     /**
@@ -296,6 +297,7 @@ namespace opt {
         lbool execute_maxsat(symbol const& s, bool committed, bool scoped);
         lbool execute_lex();
         lbool execute_box();
+        lbool execute_box_maxsat(unsigned num_threads);
         lbool execute_pareto();
         lbool adjust_unknown(lbool r);
         bool scoped_lex();
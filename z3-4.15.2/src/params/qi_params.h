@@ -36,6 +36,7 @@ struct qi_params {
     unsigned           m_qi_max_lazy_multipattern_matching = 2;
     bool               m_qi_profile = false;
     unsigned           m_qi_profile_freq = UINT_MAX;
+    std::string        m_qi_log;
     quick_checker_mode m_qi_quick_checker = MC_NO;
     bool               m_qi_lazy_quick_checker = true;
     bool               m_qi_promote_unsat = true;
@@ -106,11 +106,13 @@ struct smt_params : public preprocessor_params,
     unsigned         m_threads = 1;
     unsigned         m_threads_max_conflicts = UINT_MAX;
     unsigned         m_threads_cube_frequency = 2;
+    bool             m_threads_cube_and_conquer = false;
     bool             m_simplify_clauses = true;
     unsigned         m_tick = 1000;
     bool             m_display_features = false;
     bool             m_new_core2th_eq = true;
     bool             m_ematching = true;
+    unsigned         m_ematching_threads = 1;
     bool             m_induction = false;
     bool             m_clause_proof = false;
     symbol           m_proof_log;
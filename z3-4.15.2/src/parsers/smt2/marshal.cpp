@@ -8,32 +8,45 @@ Abstract:
 
    marshaling and unmarshaling of expressions
 
+   Expressions are marshaled using the binary format of ast_serialize.
+   Expressions that cannot be serialized in binary, and input that
+   is not in binary format, use SMT2 text.
+
    --*/
 #include "parsers/smt2/marshal.h"
 
 #include <sstream>
+#include <iterator>
 
 #include "cmd_context/cmd_context.h"
 #include "parsers/smt2/smt2parser.h"
 #include "util/vector.h"
+#include "ast/ast_serialize.h"
 #include "ast/ast_smt_pp.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 
 std::ostream &marshal(std::ostream &os, expr_ref e, ast_manager &m) {
-    ast_smt_pp pp(m);
-    pp.display_smt2(os, e);
-    return os;
+    std::string s = marshal(e, m);
+    return os.write(s.data(), s.size());
 }
 
 std::string marshal(expr_ref e, ast_manager &m) {
-    std::stringstream ss;
-    marshal(ss, e, m);
-    return ss.str();
+    std::string out;
+    try {
+        ast * a = e.get();
+        serialize_asts(m, 1, &a, out);
+    }
+    catch (default_exception &) {
+        std::stringstream ss;
+        ast_smt_pp pp(m);
+        pp.display_smt2(ss, e);
+        out = ss.str();
+    }
+    return out;
 }
 
-
-expr_ref unmarshal(std::istream &is, ast_manager &m) {
+static expr_ref unmarshal_smt2(std::istream &is, ast_manager &m) {
     cmd_context ctx(false, &m);
     ctx.set_ignore_check(true);
     if (!parse_smt2_commands(ctx, is)) { 
@@ -45,7 +58,19 @@ expr_ref unmarshal(std::istream &is, ast_manager &m) {
     return expr_ref(mk_and(m, size, it), m);
 }
 
+expr_ref unmarshal(std::istream &is, ast_manager &m) {
+    std::string s((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    return unmarshal(s, m);
+}
+
 expr_ref unmarshal(std::string s, ast_manager &m) {
-    std::istringstream is(s);
-    return unmarshal(is, m);
+    if (!is_serialized_ast(s.data(), s.size())) {
+        std::istringstream is(s);
+        return unmarshal_smt2(is, m);
+    }
+    ast_ref_vector roots(m);
+    deserialize_asts(m, s.data(), s.size(), roots);
+    if (roots.size() != 1 || !is_expr(roots.get(0)))
+        return expr_ref(nullptr, m);
+    return expr_ref(to_expr(roots.get(0)), m);
 }
@@ -3040,11 +3040,11 @@ namespace smt2 {
             parse_ext_cmd(line, pos);
         }
 
-    public:
-        parser(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & p, char const * filename=nullptr):
+        // reads from is, or from [begin, end) when is is null.
+        parser(cmd_context & ctx, std::istream * is, char const * begin, char const * end, bool interactive, params_ref const & p, char const * filename):
             m_ctx(ctx),
             m_params(p),
-            m_scanner(ctx, is, interactive),
+            m_scanner(ctx, is, begin, end, interactive),
             m_curr(scanner::NULL_TOKEN),
             m_curr_cmd(nullptr),
             m_num_bindings(0),
@@ -3096,6 +3096,15 @@ namespace smt2 {
             updt_params();
         }
 
+    public:
+        parser(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & p, char const * filename=nullptr):
+            parser(ctx, &is, nullptr, nullptr, interactive, p, filename) {
+        }
+
+        parser(cmd_context & ctx, char const * begin, char const * end, params_ref const & p, char const * filename=nullptr):
+            parser(ctx, nullptr, begin, end, false, p, filename) {
+        }
+
         ~parser() {
             reset_stack();
         }
@@ -3242,6 +3251,11 @@ bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive,
     return p();
 }
 
+bool parse_smt2_commands(cmd_context & ctx, char const * begin, char const * end, params_ref const & ps, char const * filename) {
+    smt2::parser p(ctx, begin, end, ps, filename);
+    return p();
+}
+
 bool parse_smt2_commands_with_parser(class smt2::parser *& p, cmd_context & ctx, std::istream & is, bool interactive, params_ref const & ps, char const * filename) {
     if (p)
         p->reset_input(is, interactive);
@@ -16,6 +16,7 @@ Author:
 Revision History:
 
 --*/
+#include <cstring>
 #include "parsers/smt2/smt2scanner.h"
 #include "parsers/util/parser_params.hpp"
 
@@ -26,7 +27,13 @@ namespace smt2 {
             m_cache.push_back(m_curr);
         if (m_at_eof)
             throw scanner_exception("unexpected end of file");
-        if (m_interactive) {
+        if (m_data) {
+            if (m_data < m_data_end)
+                m_curr = *m_data++;
+            else
+                m_at_eof = true;
+        }
+        else if (m_interactive) {
             m_curr = m_stream->get();
             if (m_stream->eof())
                 m_at_eof = true;
@@ -50,9 +57,37 @@ namespace smt2 {
         m_spos++;
     }
 
+    /**
+       \brief make p the current character of the in-memory input.
+       This has the same effect as calling next() for every character in [m_data - 1, p).
+    */
+    void scanner::advance_to(char const* p) {
+        char const* cur = m_data - 1;
+        SASSERT(m_data && !m_at_eof && cur <= p && p <= m_data_end);
+        if (p == cur)
+            return;
+        if (m_cache_input)
+            m_cache.append(static_cast<unsigned>(p - cur), cur);
+        m_spos += static_cast<int>(p - cur);
+        if (p < m_data_end) {
+            m_curr = *p;
+            m_data = p + 1;
+        }
+        else {
+            m_curr = m_data_end[-1];
+            m_data = m_data_end;
+            m_at_eof = true;
+        }
+    }
+
     void scanner::read_comment() {
         SASSERT(curr() == ';');
         next();
+        if (m_data && !m_at_eof) {
+            char const* p = m_data - 1;
+            p = static_cast<char const*>(memchr(p, '\n', m_data_end - p));
+            advance_to(p ? p : m_data_end);
+        }
         while (true) {
             char c = curr();
             if (m_at_eof)
@@ -118,10 +153,16 @@ namespace smt2 {
     }
 
     scanner::token scanner::read_symbol_core() {
+        if (m_data && !m_at_eof) {
+            char const* begin = m_data - 1, * p = begin;
+            while (p < m_data_end && is_symbol_char(*p))
+                ++p;
+            m_string.append(static_cast<unsigned>(p - begin), begin);
+            advance_to(p);
+        }
         while (!m_at_eof) {
             char c = curr();
-            signed char n = m_normalized[static_cast<unsigned char>(c)];
-            if (n == 'a' || n == '0' || n == '-') {
+            if (is_symbol_char(c)) {
                 m_string.push_back(c);
                 next();
             }
@@ -148,35 +189,80 @@ namespace smt2 {
         return read_symbol_core();
     }
 
-    scanner::token scanner::read_number() {
-        SASSERT('0' <= curr() && curr() <= '9');
-        rational q(1);
-        m_number = rational(curr() - '0');
-        next();
-        bool is_float = false;
+    namespace {
+    /**
+       \brief digits are accumulated in a machine word and folded into
+       the result every max_digits digits.
+    */
+    struct digit_acc {
+        static const unsigned max_digits = 18;
+        rational& m_number;
+        uint64_t  m_chunk = 0;
+        unsigned  m_digits = 0;
+        unsigned  m_num_frac = 0;
+        bool      m_is_float = false;
 
-        while (!m_at_eof) {
-            char c = curr();
+        digit_acc(rational& n) : m_number(n) { m_number.reset(); }
+
+        // return false if c is not part of the numeral.
+        bool add(char c) {
             if ('0' <= c && c <= '9') {
-                m_number = rational(10)*m_number + rational(c - '0');
-                if (is_float)
-                    q *= rational(10);
-                next();
-            }
-            else if (c == '.') {
-                if (is_float)
-                    break;
-                is_float = true;
-                next();
+                m_chunk = 10 * m_chunk + (c - '0');
+                if (m_is_float)
+                    ++m_num_frac;
+                if (++m_digits == max_digits)
+                    flush();
+                return true;
             }
-            else {
-                break;
+            if (c == '.' && !m_is_float) {
+                m_is_float = true;
+                return true;
             }
+            return false;
+        }
+
+        void flush() {
+            static const uint64_t pow10[max_digits + 1] = {
+                1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+                100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+                10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+                100000000000000000ull, 1000000000000000000ull };
+            if (m_digits == 0)
+                return;
+            if (!m_number.is_zero())
+                m_number *= rational(pow10[m_digits], rational::ui64());
+            m_number += rational(m_chunk, rational::ui64());
+            m_chunk = 0;
+            m_digits = 0;
+        }
+    };
+
+    int hex_digit(char c) {
+        if ('0' <= c && c <= '9') return c - '0';
+        if ('a' <= c && c <= 'f') return 10 + (c - 'a');
+        if ('A' <= c && c <= 'F') return 10 + (c - 'A');
+        return -1;
+    }
+    }
+
+    scanner::token scanner::read_number() {
+        SASSERT('0' <= curr() && curr() <= '9');
+        digit_acc acc(m_number);
+        if (m_data) {
+            char const* p = m_data - 1;
+            while (p < m_data_end && acc.add(*p))
+                ++p;
+            advance_to(p);
         }
-        if (is_float)
-            m_number /= q;
+        else {
+            while (!m_at_eof && acc.add(curr()))
+                next();
+        }
+        acc.flush();
+        if (acc.m_num_frac > 0)
+            m_number /= power(rational(10), acc.m_num_frac);
         TRACE(scanner, tout << "new number: " << m_number << "\n";);
-        return is_float ? FLOAT_TOKEN : INT_TOKEN;
+        return acc.m_is_float ? FLOAT_TOKEN : INT_TOKEN;
     }
 
     scanner::token scanner::read_signed_number() {
@@ -222,46 +308,46 @@ namespace smt2 {
         SASSERT(curr() == '#');
         next();
         char c = curr();
-        if (c == 'x') {
-            next();
-            c = curr();
+        if (c == 'x' || c == 'b') {
+            // digits are packed into a machine word of at most 60 bits
+            // before they are shifted into m_number.
+            unsigned log_base = c == 'x' ? 4 : 1;
+            unsigned max_digits = 60 / log_base;
+            uint64_t chunk = 0;
+            unsigned num_digits = 0;
             m_number  = rational(0);
             m_bv_size = 0;
-            while (true) {
-                if ('0' <= c && c <= '9') {
-                    m_number *= rational(16);
-                    m_number += rational(c - '0');
-                }
-                else if ('a' <= c && c <= 'f') {
-                    m_number *= rational(16);
-                    m_number += rational(10 + (c - 'a'));
-                }
-                else if ('A' <= c && c <= 'F') {
-                    m_number *= rational(16);
-                    m_number += rational(10 + (c - 'A'));
-                }
-                else {
-                    if (m_bv_size == 0)
-                        throw scanner_exception("invalid empty bit-vector literal", m_line, m_spos);
-                    return BV_TOKEN;
-                }
-                m_bv_size += 4;
-                next();
-                c = curr();
-            }
-        }
-        else if (c == 'b') {
+            auto flush = [&]() {
+                if (num_digits == 0)
+                    return;
+                if (!m_number.is_zero())
+                    m_number *= rational::power_of_two(log_base * num_digits);
+                m_number += rational(chunk, rational::ui64());
+                chunk = 0;
+                num_digits = 0;
+            };
+            auto add = [&](char c) {
+                int d = log_base == 4 ? hex_digit(c) : (c == '0' || c == '1' ? c - '0' : -1);
+                if (d < 0)
+                    return false;
+                chunk = (chunk << log_base) | static_cast<uint64_t>(d);
+                m_bv_size += log_base;
+                if (++num_digits == max_digits)
+                    flush();
+                return true;
+            };
             next();
-            c = curr();
-            m_number  = rational(0);
-            m_bv_size = 0;
-            while (c == '0' || c == '1') {
-                m_number *= rational(2);
-                m_number += rational(c - '0');
-                m_bv_size++;
-                next();
-                c = curr();
+            if (m_data && !m_at_eof) {
+                char const* p = m_data - 1;
+                while (p < m_data_end && add(*p))
+                    ++p;
+                advance_to(p);
+            }
+            else {
+                while (!m_at_eof && add(curr()))
+                    next();
             }
+            flush();
             if (m_bv_size == 0)
                 throw scanner_exception("invalid empty bit-vector literal", m_line, m_spos);
             return BV_TOKEN;
@@ -276,6 +362,14 @@ namespace smt2 {
     }
 
     scanner::scanner(cmd_context & ctx, std::istream& stream, bool interactive) :
+        scanner(ctx, &stream, nullptr, nullptr, interactive) {
+    }
+
+    scanner::scanner(cmd_context & ctx, char const* begin, char const* end) :
+        scanner(ctx, nullptr, begin, end, false) {
+    }
+
+    scanner::scanner(cmd_context & ctx, std::istream* stream, char const* begin, char const* end, bool interactive) :
         ctx(ctx),
         m_interactive(interactive),
         m_spos(0),
@@ -286,10 +380,15 @@ namespace smt2 {
         m_bv_size(UINT_MAX),
         m_bpos(0),
         m_bend(0),
-        m_stream(&stream),
+        m_stream(stream),
+        m_data(begin),
+        m_data_end(end),
         m_cache_input(false) {
+        init_normalized();
+        next();
+    }
 
-
+    void scanner::init_normalized() {
         for (int i = 0; i < 256; ++i) {
             m_normalized[i] = (signed char) i;
         }
@@ -325,7 +424,6 @@ namespace smt2 {
         m_normalized[static_cast<int>('?')] = 'a';
         m_normalized[static_cast<int>('/')] = 'a';
         m_normalized[static_cast<int>(',')] = 'a';
-        next();
     }
 
     scanner::token scanner::scan() {
@@ -398,6 +496,19 @@ namespace smt2 {
     void scanner::reset_input(std::istream & stream, bool interactive) {
         m_stream = &stream;
         m_interactive = interactive;
+        m_data = nullptr;
+        m_data_end = nullptr;
+        m_at_eof = false;
+        m_bpos = 0;
+        m_bend = 0;
+        next();
+    }
+
+    void scanner::reset_input(char const* begin, char const* end) {
+        m_stream = nullptr;
+        m_interactive = false;
+        m_data = begin;
+        m_data_end = end;
         m_at_eof = false;
         m_bpos = 0;
         m_bend = 0;
@@ -50,6 +50,10 @@ namespace smt2 {
         unsigned           m_bend;
         svector<char>      m_string;
         std::istream*      m_stream;
+        // in-memory input, e.g., a memory mapped file.
+        // m_data points past the current character.
+        char const*        m_data;
+        char const*        m_data_end;
         
         bool               m_cache_input;
         svector<char>      m_cache;
@@ -59,6 +63,12 @@ namespace smt2 {
         char curr() const { return m_curr; }
         void new_line() { m_line++; m_spos = 0; }
         void next();
+        void advance_to(char const* p);
+        void init_normalized();
+        bool is_symbol_char(char c) const {
+            signed char n = m_normalized[static_cast<unsigned char>(c)];
+            return n == 'a' || n == '0' || n == '-';
+        }
         
     public:
         
@@ -76,6 +86,13 @@ namespace smt2 {
         };
         
         scanner(cmd_context & ctx, std::istream& stream, bool interactive = false);  
+
+        scanner(cmd_context & ctx, char const* begin, char const* end);
+
+        /**
+           \brief Read from stream, or from [begin, end) when stream is null.
+        */
+        scanner(cmd_context & ctx, std::istream* stream, char const* begin, char const* end, bool interactive);
         
         int get_line() const { return m_line; }
         int get_pos() const { return m_pos; }
@@ -100,6 +117,7 @@ namespace smt2 {
         unsigned cache_size() const { return m_cache.size(); }
         void reset_cache() { m_cache.reset(); }
         void reset_input(std::istream & stream, bool interactive = false);
+        void reset_input(char const* begin, char const* end);
 
         char const * cached_str(unsigned begin, unsigned end);
     };
@@ -26,6 +26,7 @@ class sat_allocator {
     static const unsigned SMALL_OBJ_SIZE = 512;
     static const unsigned MASK = ((1 << PTR_ALIGNMENT) - 1);
     static const unsigned NUM_FREE = 1 + (SMALL_OBJ_SIZE >> PTR_ALIGNMENT);
+    static const unsigned CACHE_LINE_SIZE = 64;
     struct chunk {
         char  * m_curr;
         char    m_data[CHUNK_SIZE];
@@ -43,6 +44,18 @@ class sat_allocator {
     unsigned free_slot_id(size_t size) const {
         return (static_cast<unsigned>(size >> PTR_ALIGNMENT) + ((0 != (size & MASK)) ? 1u : 0u));
     }
+    // number of bytes to skip such that the first prefix bytes at the bump pointer stay within one cache line.
+    unsigned line_gap(size_t prefix) const {
+        unsigned offset = static_cast<unsigned>(reinterpret_cast<size_t>(m_chunk_ptr) % CACHE_LINE_SIZE);
+        return offset + prefix > CACHE_LINE_SIZE ? CACHE_LINE_SIZE - offset : 0;
+    }
+    bool fits_chunk(unsigned sz) const {
+        return !m_chunks.empty() && (char*)m_chunk_ptr + sz <= (char*)m_chunks.back() + CHUNK_SIZE;
+    }
+    void new_chunk() {
+        m_chunks.push_back(alloc(chunk));
+        m_chunk_ptr = m_chunks.back();
+    }
 public:
     sat_allocator(char const * id = "unknown"): m_id(id), m_alloc_size(0), m_chunk_ptr(nullptr) {}
     ~sat_allocator() { reset(); }
@@ -64,15 +77,30 @@ public:
             m_free[slot_id].pop_back();
             return result;
         }
-        if (m_chunks.empty()) {
-            m_chunks.push_back(alloc(chunk));
-            m_chunk_ptr = m_chunks.back();
-        }
-        
         unsigned sz = align_size(size);
-        if ((char*)m_chunk_ptr + sz > (char*)m_chunks.back() + CHUNK_SIZE) {
-            m_chunks.push_back(alloc(chunk));
-            m_chunk_ptr = m_chunks.back();            
+        if (!fits_chunk(sz)) 
+            new_chunk();
+        void * result = m_chunk_ptr;
+        m_chunk_ptr = (char*)m_chunk_ptr + sz;
+        return result;
+    }
+
+    /**
+       \brief allocate from the end of the current chunk such that the first prefix bytes
+       of the object do not straddle a cache line. The skipped bytes are recycled through the free lists.
+       Consecutive calls lay out objects contiguously in allocation order.
+    */
+    void * allocate_line_aligned(size_t size, size_t prefix) {
+        if (size >= SMALL_OBJ_SIZE || prefix > CACHE_LINE_SIZE) 
+            return allocate(size);
+        m_alloc_size += size;
+        unsigned sz = align_size(size);
+        if (!fits_chunk(line_gap(prefix) + sz))
+            new_chunk();
+        unsigned gap = line_gap(prefix);
+        if (gap > 0) {
+            m_free[free_slot_id(gap)].push_back(m_chunk_ptr);
+            m_chunk_ptr = (char*)m_chunk_ptr + gap;
         }
         void * result = m_chunk_ptr;
         m_chunk_ptr = (char*)m_chunk_ptr + sz;
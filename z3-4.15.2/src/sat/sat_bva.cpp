@@ -0,0 +1,412 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_bva.cpp
+
+Abstract:
+
+    Bounded variable addition.
+
+--*/
+#include "sat/sat_bva.h"
+#include "sat/sat_solver.h"
+#include "util/stopwatch.h"
+#include "util/trace.h"
+
+namespace sat {
+
+    bva::bva(solver & _s):
+        s(_s),
+        m_counter(0),
+        m_num_new_vars(0) {
+        reset_statistics();
+    }
+
+    struct bva::report {
+        bva &     m_bva;
+        stopwatch m_watch;
+        unsigned  m_num_vars;
+        unsigned  m_num_added;
+        unsigned  m_num_removed;
+        report(bva & b):
+            m_bva(b),
+            m_num_vars(b.m_num_vars),
+            m_num_added(b.m_num_added),
+            m_num_removed(b.m_num_removed) {
+            m_watch.start();
+        }
+
+        ~report() {
+            m_watch.stop();
+            IF_VERBOSE(2,
+                       verbose_stream() << " (sat-bva";
+                       verbose_stream() << " :vars " << (m_bva.m_num_vars - m_num_vars);
+                       verbose_stream() << " :added " << (m_bva.m_num_added - m_num_added);
+                       verbose_stream() << " :removed " << (m_bva.m_num_removed - m_num_removed);
+                       verbose_stream() << " :cost " << m_bva.m_counter;
+                       verbose_stream() << mem_stat();
+                       verbose_stream() << m_watch << ")\n";);
+        }
+    };
+
+    void bva::operator()() {
+        if (!s.m_config.m_bva || s.m_simplifications <= s.m_config.m_bva_delay)
+            return;
+        // fresh variables are not allowed to escape into scoped clauses
+        // or into the variable maps of an extension.
+        if (s.m_ext || s.num_user_scopes() > 0)
+            return;
+        // the internal proof checker only supports RUP steps.
+        if (s.m_config.m_drat_check_unsat)
+            return;
+        s.propagate(false);
+        if (s.inconsistent())
+            return;
+        ++m_num_calls;
+        report rpt(*this);
+        m_counter = s.m_config.m_bva_limit;
+        m_num_new_vars = 0;
+        init();
+
+        literal_vector candidates;
+        for (unsigned i = 0; i < m_num_occs.size(); ++i)
+            if (m_num_occs[i] >= 3)
+                candidates.push_back(to_literal(i));
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [&](literal a, literal b) { return m_num_occs[a.index()] > m_num_occs[b.index()]; });
+
+        try {
+            for (literal l : candidates) {
+                while (m_counter > 0 && m_num_new_vars < s.m_config.m_bva_max_vars && !s.inconsistent() && process(l))
+                    s.checkpoint();
+                if (m_counter <= 0 || m_num_new_vars >= s.m_config.m_bva_max_vars)
+                    break;
+            }
+        }
+        catch (solver_exception & ex) {
+            cleanup_clauses();
+            reset();
+            throw ex;
+        }
+        cleanup_clauses();
+        reset();
+        CASSERT("sat_bva", s.check_invariant());
+    }
+
+    void bva::init() {
+        unsigned num_lits = 2 * s.num_vars();
+        reset();
+        m_occs.resize(num_lits);
+        m_num_occs.resize(num_lits, 0);
+        m_mark.resize(num_lits, false);
+        m_count.resize(num_lits, 0);
+        m_last.resize(num_lits, UINT_MAX);
+
+        auto is_unassigned = [&](unsigned n, literal const* lits) {
+            for (unsigned i = 0; i < n; ++i)
+                if (s.value(lits[i]) != l_undef)
+                    return false;
+            return true;
+        };
+
+        for (clause* c : s.m_clauses) {
+            if (c->was_removed() || c->frozen() || !is_unassigned(c->size(), c->begin()))
+                continue;
+            m_tmp.reset();
+            m_tmp.append(c->size(), c->begin());
+            add_clause(m_tmp, c);
+            m_counter -= c->size();
+        }
+        for (unsigned l_idx = 0; l_idx < num_lits; ++l_idx) {
+            literal l1 = ~to_literal(l_idx);
+            for (watched const& w : s.get_wlist(l_idx)) {
+                if (!w.is_binary_non_learned_clause())
+                    continue;
+                literal l2 = w.get_literal();
+                if (l1.index() > l2.index() || s.value(l1) != l_undef || s.value(l2) != l_undef)
+                    continue;
+                m_tmp.reset();
+                m_tmp.push_back(l1);
+                m_tmp.push_back(l2);
+                add_clause(m_tmp, nullptr);
+            }
+        }
+    }
+
+    void bva::reset() {
+        m_lits.reset();
+        m_begin.reset();
+        m_size.reset();
+        m_origin.reset();
+        m_removed.reset();
+        m_occs.reset();
+        m_num_occs.reset();
+        m_mark.reset();
+        m_count.reset();
+        m_last.reset();
+        m_touched.reset();
+    }
+
+    void bva::reserve(literal l) {
+        unsigned n = std::max(l.index(), (~l).index()) + 1;
+        m_occs.reserve(n);
+        m_num_occs.reserve(n, 0);
+        m_mark.reserve(n, false);
+        m_count.reserve(n, 0);
+        m_last.reserve(n, UINT_MAX);
+    }
+
+    unsigned bva::add_clause(literal_vector const& lits, clause* origin) {
+        unsigned idx = m_size.size();
+        m_begin.push_back(m_lits.size());
+        m_size.push_back(lits.size());
+        m_origin.push_back(origin);
+        m_removed.push_back(false);
+        for (literal lit : lits) {
+            m_lits.push_back(lit);
+            m_occs[lit.index()].push_back(idx);
+            m_num_occs[lit.index()]++;
+        }
+        return idx;
+    }
+
+    void bva::remove_clause(unsigned idx) {
+        SASSERT(!m_removed[idx]);
+        m_removed[idx] = true;
+        for (unsigned i = lits_begin(idx); i < lits_end(idx); ++i)
+            m_num_occs[m_lits[i].index()]--;
+        del_solver_clause(idx);
+        ++m_num_removed;
+    }
+
+    literal bva::min_occ_literal(unsigned idx, literal l) const {
+        literal result = null_literal;
+        for (unsigned i = lits_begin(idx); i < lits_end(idx); ++i) {
+            literal lit = m_lits[i];
+            if (lit != l && (result == null_literal || m_num_occs[lit.index()] < m_num_occs[result.index()]))
+                result = lit;
+        }
+        return result;
+    }
+
+    /**
+       \brief check if d = (c \ { l }) u { l2 } for some literal l2.
+       The literals of c are marked.
+    */
+    bool bva::match(unsigned c, unsigned d, literal l, literal& l2) {
+        if (c == d || m_removed[d] || m_size[c] != m_size[d])
+            return false;
+        l2 = null_literal;
+        for (unsigned i = lits_begin(d); i < lits_end(d); ++i) {
+            literal lit = m_lits[i];
+            if (lit == l)
+                return false;
+            if (m_mark[lit.index()])
+                continue;
+            if (l2 != null_literal)
+                return false;
+            l2 = lit;
+        }
+        return l2 != null_literal && l2 != ~l;
+    }
+
+    unsigned bva::find_match(unsigned c, literal l, literal l2) {
+        unsigned result = UINT_MAX;
+        for (unsigned i = lits_begin(c); i < lits_end(c); ++i)
+            m_mark[m_lits[i].index()] = true;
+        for (unsigned d : m_occs[l2.index()]) {
+            literal l3;
+            if (match(c, d, l, l3) && l3 == l2) {
+                result = d;
+                break;
+            }
+        }
+        for (unsigned i = lits_begin(c); i < lits_end(c); ++i)
+            m_mark[m_lits[i].index()] = false;
+        return result;
+    }
+
+    /**
+       \brief grow the matched literal set from l while the reduction
+       in the number of clauses increases. Apply the replacement if it
+       is a strict reduction.
+    */
+    bool bva::process(literal l) {
+        m_mlits.reset();
+        m_mcls.reset();
+        m_mlits.push_back(l);
+        for (unsigned c : m_occs[l.index()])
+            if (!m_removed[c])
+                m_mcls.push_back(c);
+        if (m_mcls.size() < 3)
+            return false;
+
+        while (m_counter > 0) {
+            m_pairs.reset();
+            for (unsigned c : m_mcls) {
+                literal lmin = min_occ_literal(c, l);
+                if (lmin == null_literal)
+                    continue;
+                for (unsigned i = lits_begin(c); i < lits_end(c); ++i)
+                    m_mark[m_lits[i].index()] = true;
+                m_counter -= m_occs[lmin.index()].size();
+                for (unsigned d : m_occs[lmin.index()]) {
+                    literal l2;
+                    if (match(c, d, l, l2) && !m_mlits.contains(l2))
+                        m_pairs.push_back({ l2, c });
+                }
+                for (unsigned i = lits_begin(c); i < lits_end(c); ++i)
+                    m_mark[m_lits[i].index()] = false;
+            }
+
+            literal lmax = null_literal;
+            for (auto const& [l2, c] : m_pairs) {
+                if (m_last[l2.index()] == c)
+                    continue;
+                m_last[l2.index()] = c;
+                if (m_count[l2.index()]++ == 0)
+                    m_touched.push_back(l2);
+                if (lmax == null_literal || m_count[l2.index()] > m_count[lmax.index()])
+                    lmax = l2;
+            }
+            unsigned k = m_mlits.size(), m = m_mcls.size();
+            unsigned cnt = lmax == null_literal ? 0 : m_count[lmax.index()];
+            for (literal t : m_touched) {
+                m_count[t.index()] = 0;
+                m_last[t.index()] = UINT_MAX;
+            }
+            m_touched.reset();
+
+            int64_t red = (int64_t)k * m - k - m;
+            int64_t new_red = (int64_t)(k + 1) * cnt - (k + 1) - cnt;
+            if (lmax == null_literal || new_red <= red)
+                break;
+
+            m_mlits.push_back(lmax);
+            m_next_mcls.reset();
+            for (auto const& [l2, c] : m_pairs)
+                if (l2 == lmax && (m_next_mcls.empty() || m_next_mcls.back() != c))
+                    m_next_mcls.push_back(c);
+            m_mcls.swap(m_next_mcls);
+        }
+
+        unsigned k = m_mlits.size(), m = m_mcls.size();
+        if (k < 2 || (int64_t)k * m - k - m <= 0)
+            return false;
+        replace(l);
+        return !s.inconsistent();
+    }
+
+    void bva::replace(literal l) {
+        bool_var v = s.mk_var(false, true);
+        literal x(v, false);
+        reserve(x);
+        ++m_num_new_vars;
+        ++m_num_vars;
+        TRACE(sat_bva, tout << "bva " << x << " lits: " << m_mlits << " clauses: " << m_mcls.size() << "\n";);
+
+        // collect the clauses to be replaced before any clauses are added.
+        m_next_mcls.reset();
+        for (unsigned c : m_mcls) {
+            for (literal lj : m_mlits) {
+                unsigned d = lj == l ? c : find_match(c, l, lj);
+                if (d != UINT_MAX)
+                    m_next_mcls.push_back(d);
+            }
+        }
+
+        // x or C is RAT on x, ~x or lj is RAT on ~x because the
+        // resolvents with x or C are the clauses that are replaced.
+        for (unsigned c : m_mcls) {
+            m_tmp.reset();
+            m_tmp.push_back(x);
+            for (unsigned i = lits_begin(c); i < lits_end(c); ++i)
+                if (m_lits[i] != l)
+                    m_tmp.push_back(m_lits[i]);
+            add_solver_clause(m_tmp);
+        }
+        for (literal lj : m_mlits) {
+            m_tmp.reset();
+            m_tmp.push_back(~x);
+            m_tmp.push_back(lj);
+            add_solver_clause(m_tmp);
+        }
+
+        for (unsigned d : m_next_mcls)
+            if (!m_removed[d])
+                remove_clause(d);
+    }
+
+    void bva::add_solver_clause(literal_vector& lits) {
+        ++m_num_added;
+        if (s.m_config.m_drat)
+            s.m_drat.add(lits, status::redundant());
+        clause* c = nullptr;
+        {
+            literal_vector tmp(lits);
+            flet<bool> _disable_drat(s.m_config.m_drat, false);
+            c = s.mk_clause(tmp.size(), tmp.data(), status::asserted());
+        }
+        if (lits.size() > 2 && !c)
+            return;
+        add_clause(lits, c);
+    }
+
+    void bva::del_solver_clause(unsigned idx) {
+        clause* c = m_origin[idx];
+        if (c) {
+            if (s.m_config.m_drat)
+                s.m_drat.del(*c);
+            s.detach_clause(*c);
+            c->set_removed(true);
+        }
+        else {
+            SASSERT(m_size[idx] == 2);
+            literal l1 = m_lits[lits_begin(idx)];
+            literal l2 = m_lits[lits_begin(idx) + 1];
+            if (s.m_config.m_drat)
+                s.m_drat.del(l1, l2);
+            del_bin_watch(~l1, l2);
+            del_bin_watch(~l2, l1);
+        }
+    }
+
+    void bva::del_bin_watch(literal l1, literal l2) {
+        watch_list& wlist = s.get_wlist(l1);
+        for (unsigned i = 0; i < wlist.size(); ++i) {
+            watched const& w = wlist[i];
+            if (w.is_binary_non_learned_clause() && w.get_literal() == l2) {
+                wlist.erase(wlist.begin() + i);
+                return;
+            }
+        }
+    }
+
+    void bva::cleanup_clauses() {
+        unsigned j = 0;
+        for (clause* c : s.m_clauses) {
+            if (c->was_removed())
+                s.del_clause(*c);
+            else
+                s.m_clauses[j++] = c;
+        }
+        s.m_clauses.shrink(j);
+    }
+
+    void bva::collect_statistics(statistics & st) const {
+        st.update("sat bva calls", m_num_calls);
+        st.update("sat bva vars", m_num_vars);
+        st.update("sat bva added clauses", m_num_added);
+        st.update("sat bva removed clauses", m_num_removed);
+    }
+
+    void bva::reset_statistics() {
+        m_num_calls = 0;
+        m_num_vars = 0;
+        m_num_added = 0;
+        m_num_removed = 0;
+    }
+
+};
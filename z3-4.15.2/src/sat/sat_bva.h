@@ -0,0 +1,100 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_bva.h
+
+Abstract:
+
+    Bounded variable addition.
+
+    Given a set of literals L and a set of clauses S such that
+    C or l is a clause for every C in S and l in L, replace the
+    |L|*|S| clauses by
+
+        x or C      for every C in S
+        ~x or l     for every l in L
+
+    where x is a fresh variable. The replacement is applied when it
+    reduces the number of clauses. The clauses with x are RAT on x
+    and ~x, respectively, so the transformation is DRAT compatible
+    when the additions are logged before the deletions.
+
+    Reference: Manthey, Heule, Biere, Automated Reencoding of Boolean
+    Formulas, HVC 2012.
+
+--*/
+#pragma once
+
+#include "sat/sat_types.h"
+#include "util/statistics.h"
+
+namespace sat {
+    class solver;
+
+    class bva {
+        struct report;
+
+        solver &           s;
+        int64_t            m_counter;
+
+        // irredundant clauses, binary clauses have a null origin.
+        literal_vector     m_lits;
+        unsigned_vector    m_begin;
+        unsigned_vector    m_size;
+        ptr_vector<clause> m_origin;
+        bool_vector        m_removed;
+        vector<unsigned_vector> m_occs;    // literal index -> clause indices
+        unsigned_vector    m_num_occs;     // literal index -> number of non-removed clauses
+
+        bool_vector        m_mark;         // literal index -> mark
+        unsigned_vector    m_count;        // literal index -> number of matched clauses
+        unsigned_vector    m_last;         // literal index -> last matched clause
+        literal_vector     m_touched;
+
+        literal_vector     m_mlits;        // matched literals
+        unsigned_vector    m_mcls;         // matched clauses
+        unsigned_vector    m_next_mcls;
+        svector<std::pair<literal, unsigned>> m_pairs;
+        literal_vector     m_tmp;
+        unsigned           m_num_new_vars;
+
+        // stats
+        unsigned           m_num_calls;
+        unsigned           m_num_vars;
+        unsigned           m_num_added;
+        unsigned           m_num_removed;
+
+        unsigned lits_begin(unsigned idx) const { return m_begin[idx]; }
+        unsigned lits_end(unsigned idx) const { return m_begin[idx] + m_size[idx]; }
+
+        void init();
+        void reset();
+        unsigned add_clause(literal_vector const& lits, clause* origin);
+        void remove_clause(unsigned idx);
+        void reserve(literal l);
+
+        literal min_occ_literal(unsigned idx, literal l) const;
+        bool match(unsigned c, unsigned d, literal l, literal& l2);
+        unsigned find_match(unsigned c, literal l, literal l2);
+        literal next_literal();
+        bool process(literal l);
+        void replace(literal l);
+
+        void add_solver_clause(literal_vector& lits);
+        void del_solver_clause(unsigned idx);
+        void del_bin_watch(literal l1, literal l2);
+        void cleanup_clauses();
+
+    public:
+        bva(solver & s);
+
+        void operator()();
+
+        void collect_statistics(statistics & st) const;
+        void reset_statistics();
+    };
+
+};
+
@@ -32,6 +32,8 @@ namespace sat {
         m_used(false),
         m_frozen(false),
         m_reinit_stack(false),
+        m_imported(false),
+        m_vivified(false),
         m_inact_rounds(0),
         m_glue(255),
         m_psm(255) {
@@ -183,14 +185,21 @@ namespace sat {
         return cls;
     }
 
+    /**
+       \brief copy a clause while relocating clauses during defragmentation.
+       The header and the two watched literals are placed within a single cache line,
+       so that propagation visits the clause with a single cache miss.
+    */
     clause * clause_allocator::copy_clause(clause const& other) {
         size_t size = clause::get_obj_size(other.size());
-        void * mem = m_allocator.allocate(size);
+        void * mem = m_allocator.allocate_line_aligned(size, clause::get_obj_size(2));
         clause * cls = new (mem) clause(m_id_gen.mk(), other.size(), other.m_lits, other.is_learned());
         cls->m_reinit_stack = other.on_reinit_stack();
         cls->m_glue   = other.glue();
         cls->m_psm    = other.psm();
         cls->m_frozen = other.frozen();
+        cls->m_imported = other.imported();
+        cls->m_vivified = other.vivified();
         cls->m_approx = other.approx();
         return cls;
     }
@@ -50,6 +50,8 @@ namespace sat {
         unsigned           m_used:1;
         unsigned           m_frozen:1;
         unsigned           m_reinit_stack:1;
+        unsigned           m_imported:1;
+        unsigned           m_vivified:1;
         unsigned           m_inact_rounds:8;
         unsigned           m_glue:8;
         unsigned           m_psm:8;  // transient field used during gc
@@ -103,6 +105,12 @@ namespace sat {
 
         bool on_reinit_stack() const { return m_reinit_stack; }
         void set_reinit_stack(bool f) { m_reinit_stack = f; }
+
+        bool imported() const { return m_imported; }
+        void set_imported(bool f) { m_imported = f; }
+
+        bool vivified() const { return m_vivified; }
+        void set_vivified(bool f) { m_vivified = f; }
     };
 
     std::ostream & operator<<(std::ostream & out, clause_vector const & cs);
@@ -96,6 +96,11 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_par_max_glue    = p.par_max_glue();
+        m_par_max_size    = p.par_max_size();
+        m_par_ring_size   = p.par_ring_size();
+        m_par_import_budget = p.par_import_budget();
+        m_par_portfolio   = p.par_portfolio();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -118,6 +123,14 @@ namespace sat {
         m_cut_dont_cares    = p.cut_dont_cares();
         m_cut_redundancies  = p.cut_redundancies();
         m_cut_force         = p.cut_force();
+        m_vivify            = p.vivify();
+        m_vivify_delay      = p.vivify_delay();
+        m_vivify_glue       = p.vivify_glue();
+        m_vivify_limit      = p.vivify_limit();
+        m_bva               = p.bva();
+        m_bva_delay         = p.bva_delay();
+        m_bva_limit         = p.bva_limit();
+        m_bva_max_vars      = p.bva_max_vars();
         m_lookahead_simplify = p.lookahead_simplify();
         m_lookahead_double = p.lookahead_double();
         m_lookahead_simplify_bca = p.lookahead_simplify_bca();
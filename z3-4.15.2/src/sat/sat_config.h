@@ -112,6 +112,11 @@ namespace sat {
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        unsigned           m_par_max_glue;
+        unsigned           m_par_max_size;
+        unsigned           m_par_ring_size;
+        unsigned           m_par_import_budget;
+        bool               m_par_portfolio;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -128,6 +133,14 @@ namespace sat {
         bool               m_cut_dont_cares;
         bool               m_cut_redundancies;
         bool               m_cut_force;
+        bool               m_vivify;
+        unsigned           m_vivify_delay;
+        unsigned           m_vivify_glue;
+        unsigned           m_vivify_limit;
+        bool               m_bva;
+        unsigned           m_bva_delay;
+        unsigned           m_bva_limit;
+        unsigned           m_bva_max_vars;
         bool               m_anf_simplify;
         unsigned           m_anf_delay;
         bool               m_anf_exlin;
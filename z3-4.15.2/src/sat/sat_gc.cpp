@@ -18,6 +18,7 @@ Revision History:
 --*/
 
 
+#include "util/profiler.h"
 #include "sat/sat_solver.h"
 
 namespace sat {
@@ -35,6 +36,7 @@ namespace sat {
     }
 
     void solver::do_gc() {
+        scoped_profile _profile("sat.gc");
         if (!should_gc()) return;
         TRACE(sat, tout << m_conflicts_since_gc << " " << m_gc_threshold << "\n";);
         unsigned gc = m_stats.m_gc_clause;
@@ -22,69 +22,105 @@ Revision History:
 
 namespace sat {
 
-    void parallel::vector_pool::next(unsigned& index) {
-        SASSERT(index < m_size);
-        unsigned n = index + 2 + get_length(index);
-        index = (n >= m_size) ? 0 : n;
+    void parallel::clause_ring::finalize() {
+        dealloc_vect(m_seq, m_num_slots);
+        dealloc_vect(m_data, m_num_slots * m_slot_width);
+        m_seq = nullptr;
+        m_data = nullptr;
     }
 
-    void parallel::vector_pool::reserve(unsigned num_threads, unsigned sz) {
-        m_vectors.reset();
-        m_vectors.resize(sz, 0);
-        m_heads.reset();
-        m_heads.resize(num_threads, 0);
-        m_at_end.reset();
-        m_at_end.resize(num_threads, true);
-        m_tail = 0;
-        m_size = sz;
+    void parallel::clause_ring::reserve(unsigned num_slots, unsigned max_size) {
+        finalize();
+        m_num_slots = std::max(num_slots, 1u);
+        m_slot_width = std::max(max_size, 2u) + 2;
+        m_seq = alloc_vect<std::atomic<uint64_t>>(m_num_slots);
+        m_data = alloc_vect<std::atomic<unsigned>>(m_num_slots * m_slot_width);
+        for (unsigned i = 0; i < m_num_slots; ++i)
+            m_seq[i].store(0, std::memory_order_relaxed);
+        m_head.store(0, std::memory_order_release);
     }
-    
-    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n) {
-        SASSERT(m_tail < m_size);
-        unsigned capacity = n + 2;
-        m_vectors.reserve(m_size + capacity, 0);
-        IF_VERBOSE(3, verbose_stream() << owner << ": begin-add " << n << " tail: " << m_tail << " size: " << m_size << "\n";);
-        for (unsigned i = 0; i < m_heads.size(); ++i) {
-            while (m_tail < m_heads[i] && m_heads[i] < m_tail + capacity) {
-                next(m_heads[i]);
-            }
-            m_at_end[i] = false;
-        }
-        m_vectors[m_tail++] = owner;
-        m_vectors[m_tail++] = n;    
+
+    /**
+       \brief publish clause number k = head in slot k % num_slots.
+       The slot sequence number is 2k+1 while the slot is written and 2k+2 once the clause is available.
+    */
+    void parallel::clause_ring::push(unsigned glue, unsigned n, literal const* lits) {
+        SASSERT(n <= max_size());
+        uint64_t k = m_head.load(std::memory_order_relaxed);
+        unsigned idx = static_cast<unsigned>(k % m_num_slots);
+        std::atomic<unsigned>* data = m_data + idx * m_slot_width;
+        m_seq[idx].store(2*k + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        data[0].store(n, std::memory_order_relaxed);
+        data[1].store(glue, std::memory_order_relaxed);
+        for (unsigned i = 0; i < n; ++i)
+            data[i + 2].store(lits[i].index(), std::memory_order_relaxed);
+        m_seq[idx].store(2*k + 2, std::memory_order_release);
+        m_head.store(k + 1, std::memory_order_release);
     }
 
-    void parallel::vector_pool::add_vector_elem(unsigned e) {
-        m_vectors[m_tail++] = e;
+    /**
+       \brief copy clause number k. Return false if the clause was overwritten by the producer.
+    */
+    bool parallel::clause_ring::read(uint64_t k, unsigned& glue, literal_vector& lits) const {
+        unsigned idx = static_cast<unsigned>(k % m_num_slots);
+        std::atomic<unsigned> const* data = m_data + idx * m_slot_width;
+        uint64_t seq = m_seq[idx].load(std::memory_order_acquire);
+        if (seq != 2*k + 2)
+            return false;
+        unsigned n = data[0].load(std::memory_order_relaxed);
+        glue = data[1].load(std::memory_order_relaxed);
+        if (n > max_size())
+            return false;
+        lits.reset();
+        for (unsigned i = 0; i < n; ++i)
+            lits.push_back(to_literal(data[i + 2].load(std::memory_order_relaxed)));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return m_seq[idx].load(std::memory_order_relaxed) == seq;
     }
 
-    void parallel::vector_pool::end_add_vector() {
-        if (m_tail >= m_size) 
-            m_tail = 0;
+    namespace {
+        struct par_config_info {
+            char const* m_key;
+            char const* m_restart;
+            char const* m_branching;
+            char const* m_phase;
+        };
+
+        // restart strategy, branching heuristic and phase selection are
+        // varied together such that neighboring threads differ in all of them.
+        const par_config_info s_par_configs[] = {
+            { "sat par wins main",                 nullptr,     nullptr, nullptr },
+            { "sat par wins clone",                nullptr,     nullptr, nullptr },
+            { "sat par wins local-search",         nullptr,     nullptr, nullptr },
+            { "sat par wins ddfw",                 nullptr,     nullptr, nullptr },
+            { "sat par wins luby-chb-caching",     "luby",      "chb",   "caching" },
+            { "sat par wins geometric-vsids-false","geometric", "vsids", "always_false" },
+            { "sat par wins ema-chb-random",       "ema",       "chb",   "random" },
+            { "sat par wins static-vsids-ls",      "static",    "vsids", "local_search" },
+            { "sat par wins luby-vsids-true",      "luby",      "vsids", "always_true" },
+            { "sat par wins geometric-chb-basic",  "geometric", "chb",   "basic_caching" },
+            { "sat par wins ema-vsids-ls",         "ema",       "vsids", "local_search" },
+            { "sat par wins static-chb-caching",   "static",    "chb",   "caching" },
+        };
     }
 
+    unsigned parallel::num_configs() {
+        return sizeof(s_par_configs) / sizeof(s_par_configs[0]);
+    }
 
-    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned const*& ptr) {
-        unsigned head = m_heads[owner];      
-        unsigned iterations = 0;
-        while (head != m_tail || !m_at_end[owner]) {
-            ++iterations;
-            SASSERT(head < m_size && m_tail < m_size);            
-            bool is_self = owner == get_owner(head);
-            next(m_heads[owner]);
-            IF_VERBOSE(static_cast<unsigned>(iterations > m_size ? 0 : 3), verbose_stream() << owner << ": [" << head << ":" << m_heads[owner] << "] tail: " << m_tail << "\n";);
-            m_at_end[owner] = (m_heads[owner] == m_tail);
-            if (!is_self) {
-                n = get_length(head);
-                ptr = get_ptr(head);
-                return true;
-            }
-            head = m_heads[owner];
-        }
-        return false;
+    char const* parallel::config_key(unsigned config) {
+        return s_par_configs[config].m_key;
     }
 
-    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
+    parallel::parallel(solver& s): 
+        m_max_glue(s.get_config().m_par_max_glue),
+        m_max_size(s.get_config().m_par_max_size),
+        m_ring_size(s.get_config().m_par_ring_size),
+        m_import_budget(s.get_config().m_par_import_budget),
+        m_num_clauses(0), 
+        m_consumer_ready(false), 
+        m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
         reset();
@@ -96,25 +132,56 @@ namespace sat {
         for (auto* s : m_solvers)
             dealloc(s);
         m_solvers.reset();
+        m_configs.reset();
+        for (auto* r : m_rings)
+            dealloc(r);
+        m_rings.reset();
+        m_cursors.reset();
+        m_next_producer.reset();
+    }
+
+    void parallel::reserve(unsigned num_owners) {
+        for (auto* r : m_rings)
+            dealloc(r);
+        m_rings.reset();
+        for (unsigned i = 0; i < num_owners; ++i) {
+            m_rings.push_back(alloc(clause_ring));
+            m_rings.back()->reserve(m_ring_size, m_max_size);
+        }
+        m_cursors.reset();
+        m_cursors.resize(num_owners * num_owners, 0);
+        m_next_producer.reset();
+        m_next_producer.resize(num_owners, 0);
     }
 
     void parallel::init_solvers(solver& s, unsigned num_extra_solvers) {
         unsigned num_threads = num_extra_solvers + 1;
         m_solvers.init(num_extra_solvers);
         m_limits.init(num_extra_solvers);
-        symbol saved_phase = s.m_params.get_sym("phase", symbol("caching"));
+        m_configs.reset();
+        bool portfolio = s.get_config().m_par_portfolio;
+        unsigned num_portfolio = num_configs() - PAR_PORTFOLIO;
         
         for (unsigned i = 0; i < num_extra_solvers; ++i) {
-            s.m_params.set_uint("random_seed", s.m_rand());
-            if (i == 1 + num_threads/2) 
-                s.m_params.set_sym("phase", symbol("random"));
-            m_solvers[i] = alloc(sat::solver, s.m_params, m_limits[i]);
+            params_ref p(s.m_params);
+            p.set_uint("random_seed", s.m_rand());
+            unsigned config = PAR_CLONE;
+            if (portfolio) {
+                config = PAR_PORTFOLIO + i % num_portfolio;
+                par_config_info const& info = s_par_configs[config];
+                p.set_sym("restart", symbol(info.m_restart));
+                p.set_sym("branching.heuristic", symbol(info.m_branching));
+                p.set_sym("phase", symbol(info.m_phase));
+            }
+            else if (i == 1 + num_threads/2) 
+                p.set_sym("phase", symbol("random"));
+            m_configs.push_back(config);
+            m_solvers[i] = alloc(sat::solver, p, m_limits[i]);
             m_solvers[i]->copy(s, true);
             m_solvers[i]->set_par(this, i);
             push_child(m_solvers[i]->rlimit());            
         }
         s.set_par(this, num_extra_solvers);
-        s.m_params.set_sym("phase", saved_phase);        
     }
 
     void parallel::push_child(reslimit& rl) {
@@ -146,58 +213,75 @@ namespace sat {
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        literal lits[2] = { l1, l2 };
+        m_rings[s.m_par_id]->push(2, 2, lits);
+        ++s.m_stats.m_par_exported;
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
         if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        unsigned n = c.size();
-        unsigned owner = s.m_par_id;
-        IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) 
-            m_pool.add_vector_elem(c[i].index());
-        m_pool.end_add_vector();        
+        IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  c << "\n";);
+        m_rings[s.m_par_id]->push(c.glue(), c.size(), c.begin());
+        ++s.m_stats.m_par_exported;
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
         _get_clauses(s);        
     }
 
+    /**
+       \brief import clauses published by other threads, at most m_import_budget per call.
+       Producers are visited round-robin so that a small budget does not starve any of them.
+       Clauses that were overwritten before this thread got to read them are counted as dropped.
+    */
     void parallel::_get_clauses(solver& s) {
-        unsigned n;
-        unsigned const* ptr;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
-            bool usable_clause = true;
-            for (unsigned i = 0; usable_clause && i < n; ++i) {
-                literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
-                usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
+        unsigned num_rings = m_rings.size();
+        unsigned budget = m_import_budget;
+        unsigned glue = 0;
+        literal_vector lits;
+        unsigned start = m_next_producer[owner];
+        for (unsigned j = 0; j < num_rings && budget > 0; ++j) {
+            unsigned producer = (start + j) % num_rings;
+            if (producer == owner)
+                continue;
+            m_next_producer[owner] = (producer + 1) % num_rings;
+            clause_ring const& ring = *m_rings[producer];
+            uint64_t& cursor = m_cursors[owner * num_rings + producer];
+            uint64_t head = ring.head();
+            if (head - cursor > ring.num_slots()) {
+                s.m_stats.m_par_dropped += static_cast<unsigned>(head - cursor - ring.num_slots());
+                cursor = head - ring.num_slots();
             }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
-            SASSERT(n >= 2);
-            if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+            for (; cursor < head && budget > 0; ++cursor) {
+                if (!ring.read(cursor, glue, lits)) {
+                    ++s.m_stats.m_par_dropped;
+                    continue;
+                }
+                SASSERT(lits.size() >= 2);
+                bool usable_clause = all_of(lits, [&](literal lit) { return lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var()); });
+                IF_VERBOSE(3, verbose_stream() << owner << ": retrieve " << lits << "\n";);
+                if (!usable_clause) {
+                    ++s.m_stats.m_par_dropped;
+                    continue;
+                }
+                --budget;
+                ++s.m_stats.m_par_imported;
+                clause* c = s.mk_clause_core(lits.size(), lits.data(), sat::status::redundant());
+                if (c) {
+                    c->set_glue(glue);
+                    c->set_imported(true);
+                }
             }
-        }        
+        }
     }
 
     bool parallel::enable_add(clause const& c) const {
-        // plingeling, glucose heuristic:
-        return (c.size() <= 40 && c.glue() <= 8) || c.glue() <= 2;
+        // plingeling, glucose heuristic, bounded by the ring slot width:
+        return c.size() <= m_max_size && (c.glue() <= m_max_glue || c.glue() <= 2);
     }
 
     void parallel::_from_solver(solver& s) {
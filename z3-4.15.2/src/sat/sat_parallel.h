@@ -24,28 +24,32 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mutex.h"
+#include <atomic>
 
 namespace sat {
 
     class parallel {
 
-        // shared pool of learned clauses.
-        class vector_pool {
-            unsigned_vector m_vectors;
-            unsigned        m_size{ 0 };
-            unsigned        m_tail{ 0 };
-            unsigned_vector m_heads;
-            bool_vector   m_at_end;
-            void next(unsigned& index);
-            unsigned get_owner(unsigned index) const { return m_vectors[index]; }
-            unsigned get_length(unsigned index) const { return m_vectors[index+1]; }
-            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 2; }
+        // ring of learned clauses published by a single solver thread.
+        // Only the owning thread writes; other threads read without locking.
+        // Each slot carries a sequence number that is odd while the slot is
+        // being written, readers validate it before and after copying a clause
+        // and drop clauses that were overwritten in the meantime.
+        class clause_ring {
+            unsigned                m_num_slots { 0 };
+            unsigned                m_slot_width { 0 };
+            std::atomic<uint64_t>*  m_seq { nullptr };
+            std::atomic<unsigned>*  m_data { nullptr };
+            std::atomic<uint64_t>   m_head { 0 };
+            void finalize();
         public:
-            void reserve(unsigned num_owners, unsigned sz);
-            void begin_add_vector(unsigned owner, unsigned n);
-            void end_add_vector();
-            void add_vector_elem(unsigned e);
-            bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
+            ~clause_ring() { finalize(); }
+            void reserve(unsigned num_slots, unsigned max_size);
+            unsigned num_slots() const { return m_num_slots; }
+            unsigned max_size() const { return m_slot_width - 2; }
+            uint64_t head() const { return m_head.load(std::memory_order_acquire); }
+            void push(unsigned glue, unsigned n, literal const* lits);
+            bool read(uint64_t k, unsigned& glue, literal_vector& lits) const;
         };
 
         bool enable_add(clause const& c) const;
@@ -58,10 +62,17 @@ namespace sat {
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
-        vector_pool    m_pool;
         mutex          m_mux;
 
+        // lock-free clause exchange:
+        ptr_vector<clause_ring> m_rings;          // one ring per producing thread
+        svector<uint64_t>  m_cursors;             // m_cursors[consumer * #rings + producer] is the next clause to read
+        unsigned_vector    m_next_producer;       // round-robin start for each consumer
+        unsigned           m_max_glue;
+        unsigned           m_max_size;
+        unsigned           m_ring_size;
+        unsigned           m_import_budget;
+
         // for exchange with local search:
         unsigned           m_num_clauses;
         scoped_ptr<solver> m_solver_copy;
@@ -71,9 +82,25 @@ namespace sat {
         scoped_limits      m_scoped_rlimit;
         vector<reslimit>   m_limits;
         ptr_vector<solver> m_solvers;
+        unsigned_vector    m_configs;             // configuration of each extra solver
         
     public:
 
+        // configurations of parallel threads. Configurations from
+        // PAR_PORTFOLIO on are used in portfolio mode.
+        enum par_config {
+            PAR_MAIN,                 // the calling solver
+            PAR_CLONE,                // copy of the calling solver with a different seed
+            PAR_LOCAL_SEARCH,
+            PAR_DDFW,
+            PAR_PORTFOLIO
+        };
+
+        static unsigned num_configs();
+
+        // statistics key for the number of wins of a configuration
+        static char const* config_key(unsigned config);
+
         parallel(solver& s);
 
         ~parallel();
@@ -84,11 +111,13 @@ namespace sat {
 
         void push_child(reslimit& rl);
 
-        // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        // reserve one clause ring per thread
+        void reserve(unsigned num_owners);
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
+        unsigned get_config(unsigned i) const { return m_configs[i]; }
+
         void cancel_solver(unsigned i) { m_limits[i].cancel(); }
 
         // exchange unit literals
@@ -26,6 +26,7 @@ Revision History:
 #include "util/trace.h"
 #include "util/max_cliques.h"
 #include "util/gparams.h"
+#include "util/profiler.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_integrity_checker.h"
 #include "sat/sat_lookahead.h"
@@ -52,6 +53,8 @@ namespace sat {
         m_simplifier(*this, p),
         m_scc(*this, p),
         m_asymm_branch(*this, p),
+        m_vivify(*this),
+        m_bva(*this),
         m_probing(*this, p),
         m_mus(*this),
         m_inconsistent(false),
@@ -984,6 +987,7 @@ namespace sat {
     }
 
     bool solver::propagate(bool update) {
+        scoped_profile _profile("sat.propagate");
         unsigned qhead = m_qhead;
         bool r = propagate_core(update);
         if (m_config.m_branching_heuristic == BH_CHB) {
@@ -1224,6 +1228,7 @@ namespace sat {
     //
     // -----------------------
     lbool solver::check(unsigned num_lits, literal const* lits) {
+        scoped_profile _profile("sat.check");
         init_reason_unknown();
         pop_to_base_level();
         m_stats.m_units = init_trail_size();
@@ -1498,7 +1503,7 @@ namespace sat {
 #define IS_MAIN_SOLVER(i)  (i == main_solver_offset)
 
         sat::parallel par(*this);
-        par.reserve(num_threads, 1 << 12);
+        par.reserve(num_threads);
         par.init_solvers(*this, num_extra_solvers);
         for (unsigned i = 0; i < ls.size(); ++i) {
             par.push_child(ls[i]->rlimit());
@@ -1581,6 +1586,15 @@ namespace sat {
             th.join();
         }
         
+        if (result != l_undef) {
+            unsigned config = parallel::PAR_MAIN;
+            if (IS_AUX_SOLVER(finished_id))
+                config = par.get_config(finished_id);
+            else if (IS_LOCAL_SEARCH(finished_id))
+                config = finished_id - local_search_offset < num_local_search ? parallel::PAR_LOCAL_SEARCH : parallel::PAR_DDFW;
+            m_par_wins.reserve(parallel::num_configs(), 0);
+            ++m_par_wins[config];
+        }
         if (IS_AUX_SOLVER(finished_id)) {
             m_stats = par.get_solver(finished_id).m_stats;
         }
@@ -1781,6 +1795,7 @@ namespace sat {
     }
 
     lbool solver::search() {
+        scoped_profile _profile("sat.search");
         if (!m_ext || !m_ext->tracking_assumptions())
             return basic_search();
         while (true) {
@@ -2016,6 +2031,7 @@ namespace sat {
        \brief Apply all simplifications.
     */
     void solver::do_simplify() {
+        scoped_profile _profile("sat.simplify");
         if (!should_simplify()) {
             return;
         }
@@ -2074,6 +2090,14 @@ namespace sat {
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
         m_asymm_branch(false);
+        CASSERT("sat_simplify_bug", check_invariant());
+
+        m_vivify();
+        CASSERT("sat_missed_prop", check_missed_propagation());
+        CASSERT("sat_simplify_bug", check_invariant());
+
+        m_bva();
+        CASSERT("sat_simplify_bug", check_invariant());
 
         if (m_config.m_lookahead_simplify && !m_ext) {
             lookahead lh(*this);
@@ -2338,6 +2362,7 @@ namespace sat {
     }
 
     void solver::do_restart(bool to_base) {        
+        scoped_profile _profile("sat.restart");
         m_stats.m_restart++;
         m_restarts++;
         if (m_conflicts_since_init >= m_restart_next_out && get_verbosity_level() >= 1) {
@@ -2419,6 +2444,7 @@ namespace sat {
     // -----------------------
 
     bool solver::resolve_conflict() {
+        scoped_profile _profile("sat.conflict");
         while (true) {
             lbool r = resolve_conflict_core();
             CASSERT("sat_check_marks", check_marks());
@@ -2523,6 +2549,10 @@ namespace sat {
             case justification::CLAUSE: {
                 clause & c = get_clause(js);
                 unsigned i = 0;
+                if (c.imported()) {
+                    c.set_imported(false);
+                    ++m_stats.m_par_used;
+                }
                 if (consequent != null_literal) {
                     SASSERT(c[0] == consequent || c[1] == consequent);
                     if (c[0] == consequent) {
@@ -3785,10 +3815,15 @@ namespace sat {
         m_simplifier.collect_statistics(st);
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
+        m_vivify.collect_statistics(st);
+        m_bva.collect_statistics(st);
         m_probing.collect_statistics(st);
         if (m_ext) m_ext->collect_statistics(st);
         if (m_local_search) m_local_search->collect_statistics(st);
         if (m_cut_simplifier) m_cut_simplifier->collect_statistics(st);
+        for (unsigned i = 0; i < m_par_wins.size(); ++i)
+            if (m_par_wins[i] > 0)
+                st.update(parallel::config_key(i), m_par_wins[i]);
         st.copy(m_aux_stats);
     }
 
@@ -3797,7 +3832,10 @@ namespace sat {
         m_cleaner.reset_statistics();
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
+        m_vivify.reset_statistics();
+        m_bva.reset_statistics();
         m_probing.reset_statistics();
+        m_par_wins.reset();
         m_aux_stats.reset();
     }
 
@@ -4769,6 +4807,10 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat par exported", m_par_exported);
+        st.update("sat par imported", m_par_imported);
+        st.update("sat par dropped", m_par_dropped);
+        st.update("sat par used", m_par_used);
     }
 
     void stats::reset() {
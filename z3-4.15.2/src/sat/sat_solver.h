@@ -39,6 +39,8 @@ Revision History:
 #include "sat/sat_simplifier.h"
 #include "sat/sat_scc.h"
 #include "sat/sat_asymm_branch.h"
+#include "sat/sat_vivify.h"
+#include "sat/sat_bva.h"
 #include "sat/sat_cut_simplifier.h"
 #include "sat/sat_probing.h"
 #include "sat/sat_mus.h"
@@ -78,6 +80,10 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_par_exported;
+        unsigned m_par_imported;
+        unsigned m_par_dropped;
+        unsigned m_par_used;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -110,6 +116,8 @@ namespace sat {
         simplifier              m_simplifier;
         scc                     m_scc;
         asymm_branch            m_asymm_branch;
+        vivify                  m_vivify;
+        bva                     m_bva;
         probing                 m_probing;
         bool                    m_is_probing { false };
         mus                     m_mus;           // MUS for minimal core extraction
@@ -201,6 +209,7 @@ namespace sat {
         unsigned                m_par_limit_out;
         unsigned                m_par_num_vars;
         bool                    m_par_syncing_clauses;
+        unsigned_vector         m_par_wins;       // number of parallel checks won by each parallel::par_config
 
         class lookahead*        m_cuber;
         class i_local_search*   m_local_search;
@@ -212,6 +221,8 @@ namespace sat {
         friend class integrity_checker;
         friend class cleaner;
         friend class asymm_branch;
+        friend class vivify;
+        friend class bva;
         friend class big;
         friend class drat;
         friend class elim_eqs;
@@ -0,0 +1,217 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_vivify.cpp
+
+Abstract:
+
+    Vivification of learned clauses.
+
+--*/
+#include "sat/sat_vivify.h"
+#include "sat/sat_solver.h"
+#include "util/stopwatch.h"
+#include "util/trace.h"
+
+namespace sat {
+
+    vivify::vivify(solver & _s):
+        s(_s),
+        m_counter(0) {
+        reset_statistics();
+    }
+
+    struct vivify::report {
+        vivify &  m_vivify;
+        stopwatch m_watch;
+        unsigned  m_num_strengthened;
+        unsigned  m_num_elim_literals;
+        unsigned  m_num_units;
+        report(vivify & v):
+            m_vivify(v),
+            m_num_strengthened(v.m_num_strengthened),
+            m_num_elim_literals(v.m_num_elim_literals),
+            m_num_units(v.m_num_units) {
+            m_watch.start();
+        }
+
+        ~report() {
+            m_watch.stop();
+            IF_VERBOSE(2,
+                       unsigned num_strengthened = m_vivify.m_num_strengthened - m_num_strengthened;
+                       unsigned num_elim = m_vivify.m_num_elim_literals - m_num_elim_literals;
+                       unsigned num_units = m_vivify.m_num_units - m_num_units;
+                       verbose_stream() << " (sat-vivify";
+                       if (num_strengthened > 0) verbose_stream() << " :strengthened " << num_strengthened;
+                       if (num_elim > 0)         verbose_stream() << " :elim-literals " << num_elim;
+                       if (num_units > 0)        verbose_stream() << " :units " << num_units;
+                       verbose_stream() << " :cost " << m_vivify.m_counter;
+                       verbose_stream() << mem_stat();
+                       verbose_stream() << m_watch << ")\n";);
+        }
+    };
+
+    struct vivify_glue_lt {
+        bool operator()(clause const * c1, clause const * c2) const {
+            if (c1->glue() != c2->glue()) return c1->glue() < c2->glue();
+            return c1->size() < c2->size();
+        }
+    };
+
+    void vivify::operator()() {
+        if (!s.m_config.m_vivify || s.m_simplifications <= s.m_config.m_vivify_delay)
+            return;
+        if (s.m_learned.empty())
+            return;
+        s.propagate(false);
+        if (s.inconsistent())
+            return;
+        ++m_num_calls;
+        CASSERT("sat_vivify", s.check_invariant());
+        report rpt(*this);
+        bool_vector saved_phase(s.m_phase);
+        flet<bool> _is_probing(s.m_is_probing, true);
+        m_counter = s.m_config.m_vivify_limit;
+        process(s.m_learned);
+        s.m_phase = saved_phase;
+        if (!s.inconsistent())
+            s.propagate(false);
+        CASSERT("sat_vivify", s.check_invariant());
+    }
+
+    /**
+       \brief vivify learned clauses in the order of increasing glue.
+       Clauses that are removed are dropped from the vector.
+    */
+    void vivify::process(clause_vector& clauses) {
+        std::stable_sort(clauses.begin(), clauses.end(), vivify_glue_lt());
+        clause_vector::iterator it  = clauses.begin();
+        clause_vector::iterator it2 = it;
+        clause_vector::iterator end = clauses.end();
+        try {
+            for (; it != end; ++it) {
+                clause & c = *(*it);
+                if (m_counter < 0 || s.inconsistent() || c.was_removed() || c.frozen() ||
+                    c.vivified() || c.glue() > s.m_config.m_vivify_glue || c.size() <= 2) {
+                    *it2 = *it;
+                    ++it2;
+                    continue;
+                }
+                s.checkpoint();
+                if (!process(c))
+                    continue; // clause was removed
+                *it2 = *it;
+                ++it2;
+            }
+            clauses.set_end(it2);
+        }
+        catch (solver_exception & ex) {
+            // put clauses in a consistent state...
+            for (; it != end; ++it, ++it2) {
+                *it2 = *it;
+            }
+            clauses.set_end(it2);
+            throw ex;
+        }
+    }
+
+    /**
+       \brief assign the negation of the literals in c one by one and propagate.
+       The literals of c are permuted such that the retained literals form a prefix
+       and the original clause remains available for DRAT logging in shrink.
+    */
+    bool vivify::process(clause & c) {
+        TRACE(sat_vivify, tout << "processing: " << c << "\n";);
+        SASSERT(s.at_base_lvl());
+        SASSERT(!s.inconsistent());
+        for (literal l : c) {
+            if (s.value(l) == l_true) {
+                s.detach_clause(c);
+                s.del_clause(c);
+                return false;
+            }
+        }
+        ++m_num_vivified;
+        c.set_vivified(true);
+        unsigned sz = c.size();
+        m_counter -= sz;
+
+        scoped_detach scoped_d(s, c);  // clause must not be used for propagation
+        unsigned trail_sz = s.m_trail.size();
+        unsigned j = 0;
+        bool done = false;
+        s.push();
+        for (unsigned i = 0; !done && i < sz; ++i) {
+            literal l = c[i];
+            switch (s.value(l)) {
+            case l_false:
+                // ~c[0..j) implies ~l
+                break;
+            case l_true:
+                // ~c[0..j) implies l
+                std::swap(c[i], c[j++]);
+                done = true;
+                break;
+            default:
+                std::swap(c[i], c[j++]);
+                s.assign_scoped(~l);
+                s.propagate_core(false);
+                done = s.inconsistent();
+                break;
+            }
+        }
+        m_counter -= s.m_trail.size() - trail_sz;
+        s.pop(1);
+        SASSERT(!s.inconsistent());
+        if (j == sz)
+            return true;
+        return re_attach(scoped_d, c, j);
+    }
+
+    bool vivify::re_attach(scoped_detach& scoped_d, clause& c, unsigned new_sz) {
+        VERIFY(s.m_trail.size() == s.m_qhead);
+        unsigned old_sz = c.size();
+        ++m_num_strengthened;
+        m_num_elim_literals += old_sz - new_sz;
+        TRACE(sat_vivify, tout << "strengthened: " << literal_vector(new_sz, c.begin()) << "\n";);
+
+        switch (new_sz) {
+        case 0:
+            s.set_conflict();
+            return false;
+        case 1:
+            ++m_num_units;
+            s.assign_unit(c[0]);
+            s.propagate_core(false);
+            scoped_d.del_clause();
+            return false;
+        case 2:
+            SASSERT(s.value(c[0]) == l_undef && s.value(c[1]) == l_undef);
+            s.mk_bin_clause(c[0], c[1], c.is_learned());
+            if (s.m_trail.size() > s.m_qhead) s.propagate_core(false);
+            scoped_d.del_clause();
+            return false;
+        default:
+            s.shrink(c, old_sz, new_sz);
+            return true;
+        }
+    }
+
+    void vivify::collect_statistics(statistics & st) const {
+        st.update("sat vivify calls", m_num_calls);
+        st.update("sat vivify clauses", m_num_vivified);
+        st.update("sat vivify strengthened", m_num_strengthened);
+        st.update("sat vivify elim literals", m_num_elim_literals);
+    }
+
+    void vivify::reset_statistics() {
+        m_num_calls = 0;
+        m_num_vivified = 0;
+        m_num_strengthened = 0;
+        m_num_elim_literals = 0;
+        m_num_units = 0;
+    }
+
+};
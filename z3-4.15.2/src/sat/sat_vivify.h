@@ -0,0 +1,58 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_vivify.h
+
+Abstract:
+
+    Vivification of learned clauses.
+
+    For a clause l1 or ... or ln, assign ~l1, ~l2, ... in order and
+    propagate with the clause detached. If a conflict is found after ~li,
+    the clause can be shortened to l1 or ... or li. If li is implied true,
+    the same prefix suffices. Literals that are already false are dropped.
+    Each shortened clause is a RUP consequence of the remaining clauses,
+    so it is logged as a redundant clause before the original is deleted.
+
+--*/
+#pragma once
+
+#include "sat/sat_types.h"
+#include "util/statistics.h"
+
+namespace sat {
+    class solver;
+    class scoped_detach;
+
+    class vivify {
+        struct report;
+
+        solver &   s;
+        int64_t    m_counter;
+
+        // stats
+        unsigned   m_num_calls;
+        unsigned   m_num_vivified;
+        unsigned   m_num_strengthened;
+        unsigned   m_num_elim_literals;
+        unsigned   m_num_units;
+
+        bool process(clause & c);
+
+        void process(clause_vector & clauses);
+
+        bool re_attach(scoped_detach& scoped_d, clause& c, unsigned new_sz);
+
+    public:
+        vivify(solver & s);
+
+        void operator()();
+
+        void collect_statistics(statistics & st) const;
+        void reset_statistics();
+    };
+
+};
+
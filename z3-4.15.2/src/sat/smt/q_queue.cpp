@@ -32,7 +32,6 @@ namespace q {
         m_cost_function(m),
         m_new_gen_function(m),
         m_parser(m),
-        m_evaluator(m),
         m_subst(m)
     {
         init_parser_vars();
@@ -50,6 +49,8 @@ namespace q {
             warning_msg("invalid new_gen function '%s', switching to default one", m_params.m_qi_new_gen.c_str());
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
+        m_cost_program.compile(m, m_cost_function);
+        m_new_gen_program.compile(m, m_new_gen_function);
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
     }
 
@@ -110,14 +111,14 @@ namespace q {
 
     float queue::get_cost(binding& f) {
         set_values(f, 0);
-        float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
+        float r = m_cost_program(m_vals.size(), m_vals.data());
         f.c->m_stat->update_max_cost(r);
         return r;
     }
 
     unsigned queue::get_new_gen(binding& f, float cost) {
         set_values(f, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        float r = m_new_gen_program(m_vals.size(), m_vals.data());
         return std::max(f.m_max_generation + 1, static_cast<unsigned>(r));
     }
 
@@ -48,7 +48,8 @@ namespace q {
         expr_ref                      m_cost_function;
         expr_ref                      m_new_gen_function;
         cost_parser                   m_parser;
-        cost_evaluator                m_evaluator;
+        compiled_cost_function        m_cost_program;
+        compiled_cost_function        m_new_gen_program;
         cached_var_subst              m_subst;
         svector<float>                m_vals;
         double                        m_eager_cost_threshold = 0;
@@ -25,6 +25,7 @@ Revision History:
 #include "ast/pp.h"
 #include "shell/smtlib_frontend.h"
 #include "shell/z3_log_frontend.h"
+#include "shell/qi_log_frontend.h"
 #include "util/warning.h"
 #include "util/z3_version.h"
 #include "shell/dimacs_frontend.h"
@@ -43,7 +44,7 @@ Revision History:
 #include <crtdbg.h>
 #endif
 
-typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_OPB, IN_LP, IN_Z3_LOG, IN_DRAT } input_kind;
+typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_OPB, IN_LP, IN_Z3_LOG, IN_QI_LOG, IN_DRAT } input_kind;
 
 static char const * g_input_file          = nullptr;
 static char const * g_drat_input_file     = nullptr;
@@ -84,6 +85,7 @@ void display_usage() {
     std::cout << "  -opb        use parser for PB optimization input format.\n";
     std::cout << "  -lp         use parser for a modest subset of CPLEX LP input format.\n";
     std::cout << "  -log        use parser for Z3 log input format.\n";
+    std::cout << "  -qilog      analyze a quantifier instantiation log written with smt.qi.log.\n";
     std::cout << "  -in         read formula from standard input.\n";
     std::cout << "  -model      display model for satisfiable SMT.\n";
     std::cout << "\nMiscellaneous:\n";
@@ -214,6 +216,9 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "log") == 0) {
                 g_input_kind = IN_Z3_LOG;
             }
+            else if (strcmp(opt_name, "qilog") == 0) {
+                g_input_kind = IN_QI_LOG;
+            }
             else if (strcmp(opt_name, "st") == 0) {
                 g_display_statistics = true; 
                 gparams::set("stats", "true");
@@ -384,6 +389,9 @@ int STD_CALL main(int argc, char ** argv) {
                 else if (strcmp(ext, "log") == 0) {
                     g_input_kind = IN_Z3_LOG;
                 }
+                else if (strcmp(ext, "qilog") == 0) {
+                    g_input_kind = IN_QI_LOG;
+                }
                 else if (strcmp(ext, "smt2") == 0) {
                     g_input_kind = IN_SMTLIB_2;
                 }
@@ -412,6 +420,9 @@ int STD_CALL main(int argc, char ** argv) {
         case IN_Z3_LOG:
             replay_z3_log(g_input_file);
             break;
+        case IN_QI_LOG:
+            return_value = analyze_qi_log(g_input_file);
+            break;
         case IN_DRAT:
             return_value = read_drat(g_drat_input_file);
             break;
@@ -0,0 +1,194 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_log_frontend.cpp
+
+Abstract:
+
+    Analyze a binary quantifier instantiation log written with qi.log.
+
+    An instance is a child of the instances that created the terms of its
+    bindings. The analyzer reports the depth of the resulting instantiation
+    trees, the deepest chain of instances, chains that repeatedly
+    instantiate the same quantifiers (matching loops), and the quantifiers
+    with the most instances.
+
+--*/
+#include<iostream>
+#include<fstream>
+#include<iomanip>
+#include<algorithm>
+#include<unordered_map>
+#include "util/util.h"
+#include "util/error_codes.h"
+#include "smt/qi_log.h"
+#include "shell/qi_log_frontend.h"
+
+namespace {
+
+    struct quantifier_info {
+        unsigned m_id = 0;
+        unsigned m_instances = 0;
+        unsigned m_satisfied = 0;
+        unsigned m_simplified = 0;
+        unsigned m_mbqi = 0;
+        unsigned m_terms = 0;
+        unsigned m_max_generation = 0;
+        unsigned m_max_depth = 0;
+        unsigned m_self_chain = 0;
+        double   m_cost = 0;
+
+        unsigned total() const { return m_instances + m_satisfied + m_simplified; }
+    };
+
+    // chains where a quantifier is instantiated this often are reported as matching loops.
+    const unsigned loop_threshold = 5;
+    const unsigned max_quantifiers = 20;
+    const unsigned max_chain = 16;
+
+    class qi_log_analyzer {
+        std::unordered_map<unsigned, quantifier_info> m_info;
+        std::unordered_map<unsigned, unsigned>        m_creator;  // term -> instance that created it
+        unsigned_vector                               m_quantifier, m_depth, m_self, m_parent;
+        unsigned m_num_ematching = 0;
+        unsigned m_num_mbqi = 0;
+
+    public:
+
+        void add(smt::qi_log_instance const & inst) {
+            unsigned idx = m_quantifier.size();
+            unsigned depth = 1, self = 1, parent = UINT_MAX;
+            for (unsigned b : inst.m_bindings) {
+                auto it = m_creator.find(b);
+                if (it == m_creator.end())
+                    continue;
+                unsigned p = it->second;
+                if (m_depth[p] + 1 > depth) {
+                    depth = m_depth[p] + 1;
+                    parent = p;
+                }
+                if (m_quantifier[p] == inst.m_quantifier)
+                    self = std::max(self, m_self[p] + 1);
+            }
+            m_quantifier.push_back(inst.m_quantifier);
+            m_depth.push_back(depth);
+            m_self.push_back(self);
+            m_parent.push_back(parent);
+
+            auto & info = m_info[inst.m_quantifier];
+            info.m_id = inst.m_quantifier;
+            switch (inst.m_status) {
+            case smt::qi_status::instance:   ++info.m_instances; break;
+            case smt::qi_status::satisfied:  ++info.m_satisfied; break;
+            case smt::qi_status::simplified: ++info.m_simplified; break;
+            }
+            if (inst.m_source == smt::qi_source::mbqi) {
+                ++info.m_mbqi;
+                ++m_num_mbqi;
+            }
+            else
+                ++m_num_ematching;
+            info.m_cost += inst.m_cost;
+            info.m_terms += inst.m_created.size();
+            info.m_max_generation = std::max(info.m_max_generation, inst.m_generation);
+            info.m_max_depth = std::max(info.m_max_depth, depth);
+            info.m_self_chain = std::max(info.m_self_chain, self);
+            for (unsigned t : inst.m_created)
+                m_creator[t] = idx;
+        }
+
+        void display(std::ostream & out, u_map<smt::qi_log_quantifier> const & qs) const {
+            auto name = [&](unsigned id) {
+                smt::qi_log_quantifier q;
+                return qs.find(id, q) ? q.m_name : std::string("#") + std::to_string(id);
+            };
+            unsigned num_instances = m_quantifier.size();
+            unsigned deepest = UINT_MAX;
+            for (unsigned i = 0; i < num_instances; ++i)
+                if (deepest == UINT_MAX || m_depth[i] > m_depth[deepest])
+                    deepest = i;
+
+            out << "instances:            " << num_instances << "\n";
+            out << "e-matching instances: " << m_num_ematching << "\n";
+            out << "mbqi instances:       " << m_num_mbqi << "\n";
+            out << "quantifiers:          " << m_info.size() << "\n";
+            if (deepest == UINT_MAX)
+                return;
+            out << "max instance depth:   " << m_depth[deepest] << "\n";
+
+            // the deepest chain, starting from its last instance
+            out << "\ndeepest chain:\n";
+            std::unordered_map<unsigned, unsigned> occurrences;
+            unsigned n = 0;
+            for (unsigned i = deepest; i != UINT_MAX; i = m_parent[i], ++n) {
+                ++occurrences[m_quantifier[i]];
+                if (n < max_chain)
+                    out << "  " << name(m_quantifier[i]) << "\n";
+            }
+            if (n > max_chain)
+                out << "  ... " << (n - max_chain) << " more\n";
+
+            std::vector<quantifier_info> infos;
+            for (auto const& [id, info] : m_info)
+                infos.push_back(info);
+
+            std::sort(infos.begin(), infos.end(), [&](quantifier_info const & a, quantifier_info const & b) {
+                return a.m_self_chain > b.m_self_chain || (a.m_self_chain == b.m_self_chain && a.m_id < b.m_id);
+            });
+            out << "\npossible matching loops:\n";
+            bool found = false;
+            for (auto const & info : infos) {
+                unsigned occ = occurrences.count(info.m_id) ? occurrences.at(info.m_id) : 0;
+                if (info.m_self_chain < loop_threshold && occ < loop_threshold)
+                    continue;
+                found = true;
+                out << "  " << name(info.m_id) << ": self chain " << info.m_self_chain
+                    << ", occurrences in deepest chain " << occ << ", max generation " << info.m_max_generation << "\n";
+            }
+            if (!found)
+                out << "  none\n";
+
+            std::sort(infos.begin(), infos.end(), [&](quantifier_info const & a, quantifier_info const & b) {
+                return a.total() > b.total() || (a.total() == b.total() && a.m_id < b.m_id);
+            });
+            out << "\nquantifiers by instances:\n";
+            out << "  " << std::left << std::setw(30) << "name" << std::right
+                << std::setw(10) << "total" << std::setw(10) << "asserted" << std::setw(10) << "sat"
+                << std::setw(10) << "true" << std::setw(10) << "mbqi" << std::setw(10) << "terms"
+                << std::setw(10) << "avg-cost" << std::setw(8) << "max-gen" << std::setw(8) << "depth" << "\n";
+            for (unsigned i = 0; i < infos.size() && i < max_quantifiers; ++i) {
+                auto const & info = infos[i];
+                out << "  " << std::left << std::setw(30) << name(info.m_id) << std::right
+                    << std::setw(10) << info.total() << std::setw(10) << info.m_instances << std::setw(10) << info.m_satisfied
+                    << std::setw(10) << info.m_simplified << std::setw(10) << info.m_mbqi << std::setw(10) << info.m_terms
+                    << std::setw(10) << std::setprecision(3) << info.m_cost / info.total()
+                    << std::setw(8) << info.m_max_generation << std::setw(8) << info.m_max_depth << "\n";
+            }
+            if (infos.size() > max_quantifiers)
+                out << "  ... " << (infos.size() - max_quantifiers) << " more\n";
+        }
+    };
+}
+
+unsigned analyze_qi_log(char const * file_name) {
+    if (!file_name) {
+        std::cerr << "Error: the quantifier instantiation log must be given as a file.\n";
+        return ERR_OPEN_FILE;
+    }
+    std::ifstream in(file_name, std::ios::binary);
+    if (in.bad() || in.fail()) {
+        std::cerr << "Error: failed to open file \"" << file_name << "\".\n";
+        return ERR_OPEN_FILE;
+    }
+    smt::qi_log_reader reader(in);
+    qi_log_analyzer analyzer;
+    smt::qi_log_instance inst;
+    while (reader.next(inst))
+        analyzer.add(inst);
+    if (!reader.ok())
+        std::cerr << "Warning: \"" << file_name << "\" is not a complete quantifier instantiation log.\n";
+    analyzer.display(std::cout, reader.quantifiers());
+    return 0;
+}
@@ -0,0 +1,16 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_log_frontend.h
+
+Abstract:
+
+    Analyze a binary quantifier instantiation log written with qi.log.
+
+--*/
+#pragma once
+
+unsigned analyze_qi_log(char const * file_name);
+
@@ -23,6 +23,7 @@ Revision History:
 #include<signal.h>
 #include "util/timeout.h"
 #include "util/mutex.h"
+#include "util/mapped_file.h"
 #include "parsers/smt2/smt2parser.h"
 #include "muz/fp/dl_cmds.h"
 #include "cmd_context/extra_cmds/dbg_cmds.h"
@@ -173,7 +174,12 @@ unsigned read_smtlib2_commands(char const * file_name) {
     signal(SIGINT, on_ctrl_c);
 
     bool result = true;
-    if (file_name) {
+    mapped_file mf;
+    if (file_name && mf.open(file_name)) {
+        result = parse_smt2_commands(ctx, mf.begin(), mf.end());
+    }
+    else if (file_name) {
+        // not a regular file, e.g., a pipe.
         std::ifstream in(file_name);
         if (in.bad() || in.fail()) {
             std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
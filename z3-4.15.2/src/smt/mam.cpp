@@ -26,6 +26,10 @@ Revision History:
 #include "ast/ast_smt2_pp.h"
 #include "smt/mam.h"
 #include "smt/smt_context.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <atomic>
+#endif
 
 using namespace smt;
 
@@ -1833,11 +1837,49 @@ namespace {
 
     typedef svector<backtrack_point> backtrack_stack;
 
+    /**
+       \brief Instances found by an interpreter that runs in a worker thread.
+       The main thread adds them to the quantifier manager.
+    */
+    struct match_buffer {
+        struct instance {
+            quantifier * m_qa;
+            app *        m_pat;
+            unsigned     m_num_bindings;
+            unsigned     m_bindings_idx;
+            unsigned     m_max_generation;
+            unsigned     m_min_top_generation;
+            unsigned     m_max_top_generation;
+            unsigned     m_used_enodes_idx;
+            unsigned     m_num_used_enodes;
+        };
+        svector<instance>                     m_instances;
+        enode_vector                          m_bindings;
+        vector<std::tuple<enode *, enode *>>  m_used_enodes;
+        bool                                  m_completed = false;
+
+        void reset() {
+            m_instances.reset();
+            m_bindings.reset();
+            m_used_enodes.reset();
+            m_completed = false;
+        }
+
+        void add(quantifier * qa, app * pat, unsigned num_bindings, enode * const * bindings, unsigned max_generation,
+                 unsigned min_top_generation, unsigned max_top_generation, vector<std::tuple<enode *, enode *>> const & used_enodes) {
+            m_instances.push_back({ qa, pat, num_bindings, m_bindings.size(), max_generation, min_top_generation, max_top_generation,
+                        m_used_enodes.size(), used_enodes.size() });
+            m_bindings.append(num_bindings, bindings);
+            m_used_enodes.append(used_enodes);
+        }
+    };
+
     class interpreter {
         context &           m_context;
         ast_manager &       m;
         mam &               m_mam;
         bool                m_use_filters;
+        match_buffer *      m_buffer { nullptr }; // set when running in a worker thread
         enode_vector        m_registers;
         enode_vector        m_bindings;
         enode_vector        m_args;
@@ -1970,6 +2012,65 @@ namespace {
             } }
         }
 
+        /**
+           \brief Worker threads must not update the E-graph, the resource limit counter,
+           or the temporary enode used for congruence table lookups.
+        */
+        bool resource_limits_exceeded() {
+            if (m_buffer)
+                return m.limit().is_canceled() || memory::above_high_watermark();
+            return m_context.resource_limits_exceeded();
+        }
+
+        bool get_cancel_flag() {
+            return m_buffer ? m.limit().is_canceled() : m_context.get_cancel_flag();
+        }
+
+        enode * get_enode_eq_to(func_decl * f, unsigned num_args, enode * const * args) {
+            return m_buffer ? find_cgr(f, num_args, args) : m_context.get_enode_eq_to(f, num_args, args);
+        }
+
+        /**
+           \brief Return the enode of the congruence table that is congruent to f(args), or nullptr.
+           The parents of the argument with the fewest parents are traversed instead of
+           looking up the congruence table.
+        */
+        enode * find_cgr(func_decl * f, unsigned num_args, enode * const * args) {
+            if (num_args == 0)
+                return nullptr;
+            enode * r = nullptr;
+            for (unsigned i = 0; i < num_args; ++i) {
+                enode * a = args[i]->get_root();
+                if (!r || a->get_num_parents() < r->get_num_parents())
+                    r = a;
+            }
+            bool comm = num_args == 2 && f->is_commutative() && !f->is_flat_associative();
+            for (enode * p : r->get_const_parents()) {
+                if (p->get_decl() != f || p->get_num_args() != num_args || !p->is_cgr() || !p->is_cgc_enabled() || p->is_true_eq())
+                    continue;
+                unsigned i = 0;
+                for (; i < num_args && p->get_arg(i)->get_root() == args[i]->get_root(); ++i)
+                    ;
+                if (i == num_args)
+                    return p;
+                if (comm &&
+                    p->get_arg(0)->get_root() == args[1]->get_root() &&
+                    p->get_arg(1)->get_root() == args[0]->get_root())
+                    return p;
+            }
+            return nullptr;
+        }
+
+        void on_match(yield const * y, unsigned num_bindings) {
+            if (!m_buffer) {
+                m_mam.on_match(y->m_qa, y->m_pat, num_bindings, m_bindings.begin(), m_max_generation, m_used_enodes);
+                return;
+            }
+            unsigned min_gen = 0, max_gen = 0;
+            get_min_max_top_generation(min_gen, max_gen);
+            m_buffer->add(y->m_qa, y->m_pat, num_bindings, m_bindings.begin(), m_max_generation, min_gen, max_gen, m_used_enodes);
+        }
+
         enode_vector * mk_depth1_vector(enode * n, func_decl * f, unsigned i);
 
         enode_vector * mk_depth2_vector(joint2 * j2, func_decl * f, unsigned i);
@@ -2035,6 +2136,19 @@ namespace {
             return true;
         }
 
+        /**
+           \brief Match the candidates of t in a worker thread and collect the instances in buffer.
+           Duplicate candidates are removed by the caller.
+        */
+        bool execute(code_tree * t, enode_vector const & candidates, match_buffer & buffer) {
+            flet<match_buffer *> _buffer(m_buffer, &buffer);
+            init(t);
+            for (enode * app : candidates) 
+                if (app->is_cgr() && (resource_limits_exceeded() || !execute_core(t, app)))
+                    return false;
+            return true;
+        }
+
         // init(t) must be invoked before execute_core
         bool execute_core(code_tree * t, enode * n);
 
@@ -2534,14 +2648,10 @@ namespace {
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
 #define ON_MATCH(NUM)                                                   \
             m_max_generation = std::max(m_max_generation, get_max_generation(NUM, m_bindings.begin())); \
-            if (m_context.get_cancel_flag()) {                          \
+            if (get_cancel_flag()) {                                    \
                 return false;                                           \
             }                                                           \
-            m_mam.on_match(static_cast<const yield *>(m_pc)->m_qa,                                      \
-                           static_cast<const yield *>(m_pc)->m_pat,                                     \
-                           NUM,                                                                         \
-                           m_bindings.begin(),                                                          \
-                           m_max_generation, m_used_enodes)
+            on_match(static_cast<const yield *>(m_pc), NUM)
             ON_MATCH(1);
             goto backtrack;
 
@@ -2599,7 +2709,7 @@ namespace {
 
         case GET_CGR1:
 #define GET_CGR_COMMON()                                                                                                                                                \
-            m_n1 = m_context.get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());              \
+            m_n1 = get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());                        \
             if (m_n1 == 0 || !m_context.is_relevant(m_n1))                                                                                                              \
                 goto backtrack;                                                                                                                                         \
             update_max_generation(m_n1, nullptr);                                                                                                                       \
@@ -2710,7 +2820,7 @@ namespace {
 
         if (since_last_check++ > 100) {
             since_last_check = 0;
-            if (m_context.resource_limits_exceeded()) {
+            if (resource_limits_exceeded()) {
                 // Soft timeout...
                 // Cleanup before exiting
                 while (m_top != 0) {
@@ -3094,6 +3204,9 @@ namespace {
         compiler                    m_compiler;
         interpreter                 m_interpreter;
         code_tree_map               m_trees;
+        scoped_ptr_vector<interpreter>  m_workers;
+        scoped_ptr_vector<match_buffer> m_buffers;
+        vector<enode_vector>        m_worker_candidates;
 
         ptr_vector<code_tree>       m_tmp_trees;
         ptr_vector<func_decl>       m_tmp_trees_to_delete;
@@ -3885,13 +3998,123 @@ namespace {
             }
         }
 
+        // matching is done in parallel only if there is enough work to amortize starting the threads.
+        static const unsigned min_parallel_candidates = 128;
+
+        bool use_parallel_match() const {
+#ifdef SINGLE_THREAD
+            return false;
+#else
+            if (m_context.get_fparams().m_ematching_threads <= 1 || m_to_match.size() <= 1)
+                return false;
+            unsigned num_candidates = 0;
+            for (code_tree* t : m_to_match)
+                num_candidates += t->get_candidates().size();
+            return num_candidates >= min_parallel_candidates;
+#endif
+        }
+
+        /**
+           \brief Match the code trees in m_to_match concurrently. Each code tree is matched by one
+           thread against the E-graph, which is not updated while matching. The instances are
+           added on the main thread in the order of m_to_match, the same order as sequential matching.
+           Return false if a resource limit is exceeded; code trees that are not completed remain in m_to_match.
+        */
+        bool match_parallel() {
+#ifdef SINGLE_THREAD
+            return true;
+#else
+            unsigned sz = m_to_match.size();
+            unsigned num_threads = std::min(m_context.get_fparams().m_ematching_threads, sz);
+            while (m_workers.size() < num_threads)
+                m_workers.push_back(alloc(interpreter, m_context, *this, m_use_filters));
+            while (m_buffers.size() < sz)
+                m_buffers.push_back(alloc(match_buffer));
+            m_worker_candidates.reserve(sz);
+            // enode marks are shared, so duplicate candidates are removed before matching.
+            for (unsigned i = 0; i < sz; ++i) {
+                code_tree* t = m_to_match[i];
+                m_buffers[i]->reset();
+                enode_vector& cands = m_worker_candidates[i];
+                cands.reset();
+                if (!t->filter_candidates())
+                    continue;
+                for (enode* app : t->get_candidates()) {
+                    if (!app->is_marked() && app->is_cgr()) {
+                        app->set_mark();
+                        cands.push_back(app);
+                    }
+                }
+                for (enode* app : cands)
+                    app->unset_mark();
+            }
+
+            std::atomic<unsigned> next(0);
+            auto worker = [&](unsigned id) {
+                interpreter& intp = *m_workers[id];
+                for (unsigned i = next++; i < sz; i = next++) {
+                    code_tree* t = m_to_match[i];
+                    auto const& cands = t->filter_candidates() ? m_worker_candidates[i] : t->get_candidates();
+                    try {
+                        m_buffers[i]->m_completed = intp.execute(t, cands, *m_buffers[i]);
+                    }
+                    catch (z3_exception &) {
+                        m_buffers[i]->m_completed = false;
+                    }
+                }
+            };
+            vector<std::thread> threads(num_threads - 1);
+            for (unsigned id = 1; id < num_threads; ++id)
+                threads[id - 1] = std::thread([&, id]() { worker(id); });
+            worker(0);
+            for (auto& th : threads)
+                th.join();
+
+            vector<std::tuple<enode *, enode *>> used_enodes;
+            unsigned i = 0;
+            bool ok = true;
+            while (ok && i < sz) {
+                match_buffer& b = *m_buffers[i];
+                ok = b.m_completed && !m_context.resource_limits_exceeded();
+                for (unsigned k = 0; ok && k < b.m_instances.size(); ++k) {
+                    auto const& inst = b.m_instances[k];
+                    if (m_context.get_cancel_flag()) {
+                        ok = false;
+                        break;
+                    }
+                    used_enodes.reset();
+                    for (unsigned j = 0; j < inst.m_num_used_enodes; ++j)
+                        used_enodes.push_back(b.m_used_enodes[inst.m_used_enodes_idx + j]);
+                    m_context.add_instance(inst.m_qa, inst.m_pat, inst.m_num_bindings, b.m_bindings.data() + inst.m_bindings_idx, nullptr,
+                                           inst.m_max_generation, inst.m_min_top_generation, inst.m_max_top_generation, used_enodes);
+                }
+                if (ok)
+                    m_to_match[i++]->reset_candidates();
+            }
+            if (ok)
+                return true;
+            // instances of a partially added code tree are deduplicated when it is matched again.
+            unsigned j = 0;
+            for (; i < sz; ++i)
+                m_to_match[j++] = m_to_match[i];
+            m_to_match.shrink(j);
+            return false;
+#endif
+        }
+
         void match() override {
             TRACE(trigger_bug, tout << "match\n"; display(tout););
-            for (code_tree* t : m_to_match) {
-                SASSERT(t->has_candidates());
-                if (!m_interpreter.execute(t))
+            if (use_parallel_match()) {
+                if (!match_parallel())
                     return;
-                t->reset_candidates();
+            }
+            else {
+                for (code_tree* t : m_to_match) {
+                    SASSERT(t->has_candidates());
+                    if (!m_interpreter.execute(t))
+                        return;
+                    t->reset_candidates();
+                }
             }
             m_to_match.reset();
             if (!m_new_patterns.empty()) {
@@ -0,0 +1,173 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_log.cpp
+
+Abstract:
+
+    Compact binary log of quantifier instantiations.
+
+--*/
+#include <cstring>
+#include <map>
+#include "smt/qi_log.h"
+#include "smt/smt_enode.h"
+#include "util/mutex.h"
+#include "util/warning.h"
+
+namespace smt {
+
+    static char const   g_magic[4] = { 'Z', '3', 'Q', 'I' };
+    static unsigned const g_version = 1;
+    static unsigned const g_buffer_size = 1 << 16;
+
+    std::string qi_log_file_name(std::string const & base) {
+        static mutex g_mux;
+        static std::map<std::string, unsigned> g_num_logs;
+        unsigned n;
+        {
+            lock_guard lock(g_mux);
+            n = g_num_logs[base]++;
+        }
+        if (n == 0)
+            return base;
+        return base + "." + std::to_string(n);
+    }
+
+    qi_log_writer::qi_log_writer(char const * file_name):
+        m_out(file_name, std::ios::out | std::ios::binary | std::ios::trunc) {
+        if (!m_out) {
+            warning_msg("could not open quantifier instantiation log '%s'", file_name);
+            return;
+        }
+        m_buffer.append(4, g_magic);
+        put_uint(g_version);
+    }
+
+    qi_log_writer::~qi_log_writer() {
+        flush();
+    }
+
+    void qi_log_writer::flush() {
+        if (m_out.is_open() && !m_buffer.empty())
+            m_out.write(m_buffer.data(), m_buffer.size());
+        m_buffer.reset();
+        m_out.flush();
+    }
+
+    void qi_log_writer::put_uint(unsigned n) {
+        while (n >= 0x80) {
+            m_buffer.push_back(static_cast<char>((n & 0x7F) | 0x80));
+            n >>= 7;
+        }
+        m_buffer.push_back(static_cast<char>(n));
+    }
+
+    void qi_log_writer::put_quantifier(quantifier * q) {
+        if (m_logged.contains(q->get_id()))
+            return;
+        m_logged.insert(q->get_id());
+        std::string name = q->get_qid().str();
+        m_buffer.push_back('Q');
+        put_uint(q->get_id());
+        put_uint(q->get_num_decls());
+        put_uint(static_cast<unsigned>(name.size()));
+        m_buffer.append(name.size(), name.data());
+    }
+
+    void qi_log_writer::log_instance(quantifier * q, qi_source src, qi_status st, float cost, unsigned generation,
+                                     unsigned num_bindings, enode * const * bindings,
+                                     unsigned num_created, enode * const * created) {
+        if (!m_out.is_open())
+            return;
+        put_quantifier(q);
+        m_buffer.push_back('I');
+        put_uint(q->get_id());
+        m_buffer.push_back(static_cast<char>(static_cast<unsigned>(src) | (static_cast<unsigned>(st) << 2)));
+        char c[sizeof(float)];
+        memcpy(c, &cost, sizeof(float));
+        m_buffer.append(sizeof(float), c);
+        put_uint(generation);
+        put_uint(num_bindings);
+        for (unsigned i = 0; i < num_bindings; ++i)
+            put_uint(bindings[i]->get_expr_id());
+        put_uint(num_created);
+        for (unsigned i = 0; i < num_created; ++i)
+            put_uint(created[i]->get_expr_id());
+        ++m_num_instances;
+        if (m_buffer.size() >= g_buffer_size)
+            flush();
+    }
+
+    qi_log_reader::qi_log_reader(std::istream & in):
+        m_in(in) {
+        char magic[4];
+        unsigned version = 0;
+        m_in.read(magic, 4);
+        m_ok = m_in && memcmp(magic, g_magic, 4) == 0 && get_uint(version) && version == g_version;
+    }
+
+    bool qi_log_reader::get_uint(unsigned & n) {
+        n = 0;
+        for (unsigned shift = 0; shift < 35; shift += 7) {
+            int c = m_in.get();
+            if (c == EOF)
+                return false;
+            n |= static_cast<unsigned>(c & 0x7F) << shift;
+            if (!(c & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool qi_log_reader::get_ids(unsigned_vector & ids) {
+        unsigned n, id;
+        ids.reset();
+        if (!get_uint(n))
+            return false;
+        for (unsigned i = 0; i < n; ++i) {
+            if (!get_uint(id))
+                return false;
+            ids.push_back(id);
+        }
+        return true;
+    }
+
+    bool qi_log_reader::next(qi_log_instance & inst) {
+        while (m_ok) {
+            int tag = m_in.get();
+            if (tag == EOF)
+                return false;
+            unsigned id, n;
+            if (tag == 'Q') {
+                qi_log_quantifier q;
+                if (!get_uint(id) || !get_uint(q.m_num_decls) || !get_uint(n))
+                    break;
+                q.m_name.resize(n);
+                if (n > 0 && !m_in.read(q.m_name.data(), n))
+                    break;
+                m_quantifiers.insert(id, q);
+                continue;
+            }
+            if (tag != 'I')
+                break;
+            char c[sizeof(float)];
+            int flags;
+            if (!get_uint(inst.m_quantifier) || (flags = m_in.get()) == EOF || !m_in.read(c, sizeof(float)))
+                break;
+            inst.m_source = static_cast<qi_source>(flags & 0x3);
+            inst.m_status = static_cast<qi_status>(flags >> 2);
+            memcpy(&inst.m_cost, c, sizeof(float));
+            if (!get_uint(inst.m_generation))
+                break;
+            if (get_ids(inst.m_bindings) && get_ids(inst.m_created))
+                return true;
+            break;
+        }
+        m_ok = false;
+        return false;
+    }
+
+};
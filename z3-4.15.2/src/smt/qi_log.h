@@ -0,0 +1,112 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_log.h
+
+Abstract:
+
+    Compact binary log of quantifier instantiations.
+
+    The log is a sequence of records. Each record starts with a tag byte
+    and stores its fields as LEB128 encoded unsigned integers:
+
+    - 'Q' quantifier:  id, number of bound variables, name.
+      Emitted before the first instance of the quantifier.
+    - 'I' instance:    quantifier id, source/status byte, cost (4 bytes),
+      generation, bindings (expression ids), terms created by the instance
+      (expression ids).
+
+    The writer buffers records and each solver context writes its own
+    file, so logging does not synchronize threads.
+
+--*/
+#pragma once
+
+#include <fstream>
+#include <string>
+#include "ast/ast.h"
+#include "util/map.h"
+#include "util/uint_set.h"
+#include "util/vector.h"
+
+namespace smt {
+
+    class enode;
+
+    enum class qi_source : unsigned char {
+        ematching,
+        mbqi
+    };
+
+    enum class qi_status : unsigned char {
+        instance,      // the instance was asserted
+        satisfied,     // the instance was already satisfied
+        simplified     // the instance simplified to true
+    };
+
+    class qi_log_writer {
+        std::ofstream  m_out;
+        svector<char>  m_buffer;
+        uint_set       m_logged;
+        unsigned       m_num_instances = 0;
+
+        void put_uint(unsigned n);
+        void put_quantifier(quantifier * q);
+        void flush();
+    public:
+        qi_log_writer(char const * file_name);
+        ~qi_log_writer();
+
+        bool is_open() const { return m_out.is_open(); }
+        unsigned num_instances() const { return m_num_instances; }
+
+        void log_instance(quantifier * q, qi_source src, qi_status st, float cost, unsigned generation,
+                          unsigned num_bindings, enode * const * bindings,
+                          unsigned num_created, enode * const * created);
+    };
+
+    struct qi_log_instance {
+        unsigned        m_quantifier = 0;
+        qi_source       m_source = qi_source::ematching;
+        qi_status       m_status = qi_status::instance;
+        float           m_cost = 0;
+        unsigned        m_generation = 0;
+        unsigned_vector m_bindings;
+        unsigned_vector m_created;
+    };
+
+    struct qi_log_quantifier {
+        std::string m_name;
+        unsigned    m_num_decls = 0;
+    };
+
+    class qi_log_reader {
+        std::istream &           m_in;
+        u_map<qi_log_quantifier> m_quantifiers;
+        bool                     m_ok = true;
+
+        bool get_uint(unsigned & n);
+        bool get_ids(unsigned_vector & ids);
+    public:
+        qi_log_reader(std::istream & in);
+
+        /**
+           \brief read the next instance. Return false at the end of the log
+           or if the log is malformed, see ok().
+        */
+        bool next(qi_log_instance & inst);
+
+        bool ok() const { return m_ok; }
+
+        u_map<qi_log_quantifier> const & quantifiers() const { return m_quantifiers; }
+    };
+
+    /**
+       \brief return a fresh log file name. The first log of the process
+       with this base is written to base, the following ones to base.1, base.2, ...
+    */
+    std::string qi_log_file_name(std::string const & base);
+
+};
@@ -18,6 +18,8 @@ Revision History:
 --*/
 #include "util/warning.h"
 #include "util/stats.h"
+#include "util/profiler.h"
+#include "util/stopwatch.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/rewriter/var_subst.h"
@@ -36,7 +38,6 @@ namespace smt {
         m_cost_function(m),
         m_new_gen_function(m),
         m_parser(m),
-        m_evaluator(m),
         m_subst(m),
         m_instances(m) {
         init_parser_vars();
@@ -60,6 +61,8 @@ namespace smt {
             warning_msg("invalid new_gen function '%s', switching to default one", m_params.m_qi_new_gen.c_str());
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
+        m_cost_program.compile(m, m_cost_function);
+        m_new_gen_program.compile(m, m_new_gen_function);
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
     }
 
@@ -119,7 +122,16 @@ namespace smt {
 
     float qi_queue::get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
         q::quantifier_stat * stat = set_values(q, pat, generation, min_top_generation, max_top_generation, 0);
-        float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
+        float r;
+        if (m_params.m_qi_profile) {
+            stopwatch sw;
+            sw.start();
+            r = m_cost_program(m_vals.size(), m_vals.data());
+            sw.stop();
+            stat->add_cost_time(sw.get_seconds());
+        }
+        else
+            r = m_cost_program(m_vals.size(), m_vals.data());
         stat->update_max_cost(r);
         return r;
     }
@@ -127,7 +139,7 @@ namespace smt {
     unsigned qi_queue::get_new_gen(quantifier * q, unsigned generation, float cost) {
         // max_top_generation and min_top_generation are not available for computing inc_gen
         set_values(q, nullptr, generation, 0, 0, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        float r = m_new_gen_program(m_vals.size(), m_vals.data());
         if (q->get_weight() > 0 || r > 0)
             return static_cast<unsigned>(r);
         return std::max(generation + 1, static_cast<unsigned>(r));
@@ -144,10 +156,11 @@ namespace smt {
               }
               tout << "\n";);
         TRACE(new_entries_bug, tout << "[qi:insert]\n";);
-        m_new_entries.push_back(entry(f, cost, generation));
+        m_new_entries.push_back(entry(f, cost, generation, pat == nullptr));
     }
 
     void qi_queue::instantiate() {
+        scoped_profile _profile("smt.qi");
         unsigned since_last_check = 0;
         for (entry & curr : m_new_entries) {
             if (m_context.get_cancel_flag()) {
@@ -196,6 +209,20 @@ namespace smt {
         }
     }
 
+    bool qi_queue::logging() {
+        // the log is opened on the first instance, qi.log may be set after the queue is set up.
+        if (!m_log && !m_params.m_qi_log.empty())
+            m_log = alloc(qi_log_writer, qi_log_file_name(m_params.m_qi_log).c_str());
+        return m_log.get() != nullptr;
+    }
+
+    void qi_queue::log_instance(entry const & ent, qi_status st, unsigned num_created, enode * const * created) {
+        fingerprint * f = ent.m_qb;
+        quantifier * q  = static_cast<quantifier*>(f->get_data());
+        m_log->log_instance(q, ent.m_mbqi ? qi_source::mbqi : qi_source::ematching, st, ent.m_cost, ent.m_generation,
+                            f->get_num_args(), f->get_args(), num_created, created);
+    }
+
     void qi_queue::instantiate(entry & ent) {
         // set temporary flag to enable quantifier-specific tracing in within smt_internalizer.
         flet<bool> _coming_from_quant(m_context.m_coming_from_quant, true);
@@ -220,6 +247,8 @@ namespace smt {
             // a dummy instantiation is still an instantiation.
             // in this way smt.qi.profile=true coincides with the axiom profiler
             stat->inc_num_instances_checker_sat();
+            if (logging())
+                log_instance(ent, qi_status::satisfied);
             return;
         }
 
@@ -240,6 +269,8 @@ namespace smt {
         if (m.is_true(s_instance)) {
             STRACE(instance, tout <<  "Instance reduced to true\n";);
             stat -> inc_num_instances_simplify_true();
+            if (logging())
+                log_instance(ent, qi_status::simplified);
             if (m.has_trace_stream()) {
                 display_instance_profile(f, q, num_bindings, bindings, pr ? pr->get_id() : 0, generation);
                 m.trace_stream() << "[end-of-instance]\n";
@@ -325,10 +356,15 @@ namespace smt {
         m_stats.m_num_instances++;
         unsigned gen = get_new_gen(q, generation, ent.m_cost);
         display_instance_profile(f, q, num_bindings, bindings, proof_id, gen);
+        unsigned num_enodes = m_context.enodes().size();
         m_context.internalize_instance(lemma, pr1, gen);
         if (f->get_def()) {
             m_context.internalize(f->get_def(), true);
         }
+        if (logging()) {
+            auto const& enodes = m_context.enodes();
+            log_instance(ent, qi_status::instance, enodes.size() - num_enodes, enodes.data() + num_enodes);
+        }
         TRACE_CODE({
             static unsigned num_useless = 0;
             if (m.is_or(lemma)) {
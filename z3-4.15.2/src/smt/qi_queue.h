@@ -25,6 +25,7 @@ Revision History:
 #include "smt/smt_checker.h"
 #include "smt/smt_quantifier.h"
 #include "smt/fingerprints.h"
+#include "smt/qi_log.h"
 #include "params/qi_params.h"
 #include "ast/cost_evaluator.h"
 #include "util/statistics.h"
@@ -48,16 +49,18 @@ namespace smt {
         expr_ref                      m_cost_function;
         expr_ref                      m_new_gen_function;
         cost_parser                   m_parser;
-        cost_evaluator                m_evaluator;
+        compiled_cost_function        m_cost_program;
+        compiled_cost_function        m_new_gen_program;
         cached_var_subst              m_subst;
         svector<float>                m_vals;
         double                        m_eager_cost_threshold = 0;
         struct entry {
             fingerprint * m_qb;
             float         m_cost;
-            unsigned      m_generation:31;
+            unsigned      m_generation:30;
             unsigned      m_instantiated:1;
-            entry(fingerprint * f, float c, unsigned g):m_qb(f), m_cost(c), m_generation(g), m_instantiated(false) {}
+            unsigned      m_mbqi:1;      // the instance was not produced by E-matching
+            entry(fingerprint * f, float c, unsigned g, bool mbqi):m_qb(f), m_cost(c), m_generation(g), m_instantiated(false), m_mbqi(mbqi) {}
         };
         svector<entry>                m_new_entries;
         svector<entry>                m_delayed_entries;
@@ -69,6 +72,7 @@ namespace smt {
             unsigned   m_instantiated_trail_lim;
         };
         svector<scope>                m_scopes;
+        scoped_ptr<qi_log_writer>     m_log;
 
         void init_parser_vars();
         q::quantifier_stat * set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost);
@@ -77,6 +81,8 @@ namespace smt {
         void instantiate(entry & ent);
         void get_min_max_costs(float & min, float & max) const;
         void display_instance_profile(fingerprint * f, quantifier * q, unsigned num_bindings, enode * const * bindings, unsigned proof_id, unsigned generation);
+        bool logging();
+        void log_instance(entry const & ent, qi_status st, unsigned num_created = 0, enode * const * created = nullptr);
 
     public:
         qi_queue(quantifier_manager & qm, context & ctx, qi_params & params);
@@ -20,6 +20,7 @@ Revision History:
 #include "util/luby.h"
 #include "util/warning.h"
 #include "util/timeit.h"
+#include "util/profiler.h"
 #include "util/union_find.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -1640,6 +1641,7 @@ namespace smt {
     }
 
     bool context::propagate_theories() {
+        scoped_profile _profile("smt.theory_propagate");
         for (theory * t : m_theory_set) {
             t->propagate();
             if (inconsistent())
@@ -1701,6 +1703,7 @@ namespace smt {
        congruences cannot be retracted to a consistent state.
      */
     bool context::propagate() {
+        scoped_profile _profile("smt.propagate");
         TRACE(propagate, tout << "propagating... " << m_qhead << ":" << m_assigned_literals.size() << "\n");
         
         while (true) {
@@ -3254,6 +3257,7 @@ namespace smt {
     }
 
     void context::internalize_assertions() {
+        scoped_profile _profile("smt.internalize");
         if (get_cancel_flag()) return;
         if (m_internalizing_assertions) return;
         flet<bool> _internalizing(m_internalizing_assertions, true);
@@ -3803,6 +3807,7 @@ namespace smt {
 
 
     lbool context::search() {
+        scoped_profile _profile("smt.search");
         if (m_asserted_formulas.inconsistent()) {
             asserted_inconsistent();
             return l_false;
@@ -4053,6 +4058,7 @@ namespace smt {
     }
 
     final_check_status context::final_check() {
+        scoped_profile _profile("smt.final_check");
         TRACE(final_check, tout << "final_check inconsistent: " << inconsistent() << "\n"; display(tout); display_normalized_enodes(tout););
         CASSERT("relevancy", check_relevancy());
         
@@ -4154,6 +4160,7 @@ namespace smt {
 
 
     bool context::resolve_conflict() {
+        scoped_profile _profile("smt.conflict");
         m_stats.m_num_conflicts++;
         m_num_conflicts ++;
         m_num_conflicts_since_restart ++;
@@ -36,6 +36,7 @@ namespace smt {
 #else
 
 #include <thread>
+#include <condition_variable>
 
 namespace smt {
     
@@ -55,6 +56,9 @@ namespace smt {
             return result;
         }        
 
+        if (ctx.get_fparams().m_threads_cube_and_conquer)
+            return cube_and_conquer(asms, num_threads, max_conflicts);
+
         enum par_exception_kind {
             DEFAULT_EX,
             ERROR_EX
@@ -262,5 +266,361 @@ namespace smt {
         return result;
     }
 
+
+    /**
+       \brief cube-and-conquer with work stealing.
+
+       Cubes are conjunctions of lookahead literals kept in one deque per worker.
+       All cubes, lemmas and cores live in the main manager and are only accessed under the lock.
+       A worker solves the most recent cube of its own deque under a conflict budget.
+       When the budget runs out while other workers are idle, the worker splits its cube on a
+       lookahead literal, keeps one half and pushes the other half to its deque.
+       Otherwise it continues with a doubled budget.
+       Idle workers steal the oldest cube from the fullest deque.
+       When a cube is refuted, the cube literals in the unsat core prune every queued cube
+       that contains them, and the negated core is shared as a lemma with the other workers.
+    */
+    lbool parallel::cube_and_conquer(expr_ref_vector const& asms, unsigned num_threads, unsigned max_conflicts) {
+        enum par_exception_kind {
+            DEFAULT_EX,
+            ERROR_EX
+        };
+
+        struct cube_stats {
+            unsigned m_solved = 0;
+            unsigned m_split = 0;
+            unsigned m_stolen = 0;
+            unsigned m_pruned = 0;
+            unsigned m_lemmas = 0;
+        };
+
+        vector<smt_params> smt_params;
+        scoped_ptr_vector<ast_manager> pms;
+        scoped_ptr_vector<context> pctxs;
+        vector<expr_ref_vector> pasms;
+
+        ast_manager& m = ctx.m;
+        scoped_limits sl(m.limit());
+        unsigned thread_max_conflicts = ctx.get_fparams().m_threads_max_conflicts;
+        unsigned finished_id = UINT_MAX;
+        std::string        ex_msg;
+        par_exception_kind ex_kind = DEFAULT_EX;
+        unsigned error_code = 0;
+        lbool result = l_undef;
+        bool done = false;
+        bool has_undef = false;
+        failure undef_reason = UNKNOWN;
+        if (m.has_trace_stream())
+            throw default_exception("trace streams have to be off in parallel mode");
+
+        for (unsigned i = 0; i < num_threads; ++i) 
+            smt_params.push_back(ctx.get_fparams());
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager* new_m = alloc(ast_manager, m, true);
+            pms.push_back(new_m);
+            pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
+            context& new_ctx = *pctxs.back();
+            context::copy(ctx, new_ctx, true);
+            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
+            ast_translation tr(m, *new_m);
+            pasms.push_back(tr(asms));
+            sl.push_child(&(new_m->limit()));
+        }
+
+        // shared state, protected by mux
+        std::mutex mux;
+        std::condition_variable cv;
+        vector<vector<expr_ref_vector>> deques(num_threads);
+        vector<expr_ref_vector> cube_cores;      // cube literals of refuted cubes
+        expr_ref_vector lemmas(m);               // negated unsat cores of refuted cubes
+        unsigned_vector lemma_owner;
+        unsigned_vector lemma_lim(num_threads, 0u);
+        expr_ref_vector core(m);                 // assumptions used in refutations
+        obj_hashtable<expr> core_set;
+        unsigned num_active = 0, num_idle = 0;
+        cube_stats stats;
+
+        deques[0].push_back(expr_ref_vector(m));
+
+        auto is_pruned = [&](expr_ref_vector const& cube) {
+            for (auto const& cc : cube_cores)
+                if (all_of(cc, [&](expr* e) { return cube.contains(e); }))
+                    return true;
+            return false;
+        };
+
+        auto has_cube = [&]() {
+            for (auto const& d : deques)
+                if (!d.empty())
+                    return true;
+            return false;
+        };
+
+        auto pop_cube = [&](unsigned i, expr_ref_vector& cube) {
+            while (true) {
+                unsigned j = i;
+                if (deques[i].empty()) {
+                    for (unsigned k = 0; k < num_threads; ++k)
+                        if (deques[k].size() > deques[j].size())
+                            j = k;
+                    if (deques[j].empty())
+                        return false;
+                    cube.reset();
+                    cube.append(deques[j][0]);
+                    deques[j].erase(deques[j].begin());
+                    ++stats.m_stolen;
+                }
+                else {
+                    cube.reset();
+                    cube.append(deques[i].back());
+                    deques[i].pop_back();
+                }
+                if (!is_pruned(cube))
+                    return true;
+                ++stats.m_pruned;
+            }
+        };
+
+        auto import_lemmas = [&](unsigned i) {
+            context& pctx = *pctxs[i];
+            ast_translation tr(m, pctx.m);
+            for (unsigned j = lemma_lim[i]; j < lemmas.size(); ++j) 
+                if (lemma_owner[j] != i) 
+                    pctx.assert_expr(tr(lemmas.get(j)));
+            lemma_lim[i] = lemmas.size();
+        };
+
+        // stop all workers other than i. Called with mux held.
+        auto cancel_others = [&](unsigned i) {
+            done = true;
+            for (ast_manager* pm : pms)
+                if (pm != pms[i])
+                    pm->limit().cancel();
+            cv.notify_all();
+        };
+
+        auto finish = [&](unsigned i, lbool r) {
+            if (finished_id == UINT_MAX) {
+                finished_id = i;
+                result = r;
+            }
+            cancel_others(i);
+        };
+
+        auto worker_thread = [&](unsigned i) {
+            try {
+                context& pctx = *pctxs[i];
+                ast_manager& pm = *pms[i];
+                expr_ref_vector cube(pm), lasms(pm);
+                expr_ref_vector mcube(m);
+                while (true) {
+                    {
+                        std::unique_lock<std::mutex> lock(mux);
+                        while (!done && !pop_cube(i, mcube)) {
+                            if (num_active == 0) {
+                                // all cubes are refuted (or undetermined)
+                                done = true;
+                                cv.notify_all();
+                                break;
+                            }
+                            ++num_idle;
+                            cv.wait(lock);
+                            --num_idle;
+                        }
+                        if (done) {
+                            mcube.reset();
+                            return;
+                        }
+                        ++num_active;
+                        ast_translation tr(m, pm);
+                        cube.reset();
+                        for (expr* e : mcube)
+                            cube.push_back(tr(e));
+                        mcube.reset();
+                        pctx.pop_to_base_lvl();
+                        import_lemmas(i);
+                    }
+
+                    unsigned budget = std::min(thread_max_conflicts, max_conflicts);
+                    lbool r = l_undef;
+                    while (true) {
+                        lasms.reset();
+                        lasms.append(pasms[i]);
+                        lasms.append(cube);
+                        pctx.get_fparams().m_max_conflicts = budget;
+                        IF_VERBOSE(2, verbose_stream() << "(smt.thread " << i << " :cube-size " << cube.size() << " :budget " << budget << ")\n";);
+                        r = pctx.check(lasms.size(), lasms.data());
+                        if (r != l_undef || pctx.get_last_search_failure() != NUM_CONFLICTS || budget >= max_conflicts)
+                            break;
+
+                        bool split = false;
+                        {
+                            std::lock_guard<std::mutex> lock(mux);
+                            split = num_idle > 0 && !done;
+                        }
+                        expr_ref lit(pm);
+                        if (split) {
+                            lookahead lh(pctx);
+                            lit = lh.choose();
+                            split = lit && !pm.is_true(lit) && !pm.is_false(lit);
+                        }
+                        if (split) {
+                            expr_ref nlit(pm.mk_not(lit), pm);
+                            split = !cube.contains(lit) && !cube.contains(nlit);
+                        }
+                        if (split) {
+                            if ((pctx.get_random_value() % 2) == 0)
+                                lit = pm.mk_not(lit);
+                            expr_ref nlit(pm.mk_not(lit), pm);
+                            std::lock_guard<std::mutex> lock(mux);
+                            ast_translation tr(pm, m);
+                            expr_ref_vector other(m);
+                            for (expr* e : cube)
+                                other.push_back(tr(e));
+                            other.push_back(tr(nlit.get()));
+                            deques[i].push_back(other);
+                            ++stats.m_split;
+                            cv.notify_one();
+                            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :split " << mk_bounded_pp(lit, pm, 3) << " :depth " << cube.size() + 1 << ")\n";);
+                            cube.push_back(lit);
+                            budget = std::min(thread_max_conflicts, max_conflicts);
+                        }
+                        else {
+                            budget = budget > max_conflicts / 2 ? max_conflicts : 2 * budget;
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(mux);
+                    --num_active;
+                    ++stats.m_solved;
+                    if (done)
+                        return;
+                    if (r == l_true) {
+                        finish(i, r);
+                        return;
+                    }
+                    if (r == l_undef) {
+                        // this cube could not be decided, other cubes may still be satisfiable.
+                        if (!pm.limit().inc()) {
+                            finish(i, r);
+                            return;
+                        }
+                        has_undef = true;
+                        undef_reason = pctx.get_last_search_failure();
+                        cv.notify_all();
+                        continue;
+                    }
+                    // r == l_false
+                    ast_translation tr(pm, m);
+                    expr_ref_vector cc(m);
+                    for (expr* e : pctx.unsat_core()) {
+                        expr* f = tr(e);
+                        if (cube.contains(e))
+                            cc.push_back(f);
+                        else if (!core_set.contains(f)) {
+                            core_set.insert(f);
+                            core.push_back(f);
+                        }
+                    }
+                    if (cc.empty()) {
+                        // refutation does not depend on the cube
+                        finish(i, r);
+                        return;
+                    }
+                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :refuted-cube " << cube.size() << " :core " << cc.size() << ")\n";);
+                    expr_ref lemma(mk_not(mk_and(pctx.unsat_core())), pm);
+                    pctx.assert_expr(lemma);
+                    lemmas.push_back(tr(lemma.get()));
+                    lemma_owner.push_back(i);
+                    ++stats.m_lemmas;
+                    cube_cores.push_back(cc);
+                    for (auto& d : deques) 
+                        stats.m_pruned += d.erase_if([&](expr_ref_vector const& c) { return is_pruned(c); });
+                    if (!has_cube() && num_active == 0)
+                        done = true;
+                    cv.notify_all();
+                }
+            }
+            catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (finished_id == UINT_MAX) {
+                    error_code = err.error_code();
+                    ex_kind = ERROR_EX;
+                }
+                cancel_others(i);
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (finished_id == UINT_MAX) {
+                    ex_msg = ex.what();
+                    ex_kind = DEFAULT_EX;
+                }
+                cancel_others(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (finished_id == UINT_MAX) {
+                    ex_msg = "unknown exception";
+                    ex_kind = ERROR_EX;
+                }
+                cancel_others(i);
+            }
+        };
+
+        vector<std::thread> threads(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i) 
+            threads[i] = std::thread([&, i]() { worker_thread(i); });
+        for (auto & th : threads) 
+            th.join();
+
+        for (context* c : pctxs) 
+            c->collect_statistics(ctx.m_aux_stats);
+        ctx.m_aux_stats.update("parallel cubes solved", stats.m_solved);
+        ctx.m_aux_stats.update("parallel cubes split", stats.m_split);
+        ctx.m_aux_stats.update("parallel cubes stolen", stats.m_stolen);
+        ctx.m_aux_stats.update("parallel cubes pruned", stats.m_pruned);
+        ctx.m_aux_stats.update("parallel cube lemmas", stats.m_lemmas);
+        IF_VERBOSE(1, verbose_stream() << "(smt.cube-and-conquer :solved " << stats.m_solved << " :split " << stats.m_split 
+                   << " :stolen " << stats.m_stolen << " :pruned " << stats.m_pruned << ")\n";);
+
+        if (finished_id == UINT_MAX && ex_kind == ERROR_EX) 
+            throw z3_error(error_code);
+        if (finished_id == UINT_MAX && !ex_msg.empty())
+            throw default_exception(std::move(ex_msg));
+
+        if (finished_id == UINT_MAX) {
+            // every cube was refuted or left undetermined
+            if (has_undef) {
+                ctx.m_last_search_failure = undef_reason;
+                return l_undef;
+            }
+            if (!m.inc())
+                return l_undef;
+            ctx.m_unsat_core.reset();
+            ctx.m_unsat_core.append(core);
+            return l_false;
+        }
+
+        model_ref mdl;        
+        context& pctx = *pctxs[finished_id];
+        ast_translation tr(*pms[finished_id], m);
+        switch (result) {
+        case l_true: 
+            pctx.get_model(mdl);
+            if (mdl) 
+                ctx.set_model(mdl->translate(tr));            
+            break;
+        case l_false:
+            ctx.m_unsat_core.reset();
+            for (expr* e : pctx.unsat_core()) 
+                ctx.m_unsat_core.push_back(tr(e));
+            break;
+        default:
+            ctx.m_last_search_failure = pctx.get_last_search_failure();
+            break;
+        }                                
+        return result;
+    }
+
 }
 #endif
@@ -24,6 +24,9 @@ namespace smt {
 
     class parallel {
         context& ctx;
+
+        lbool cube_and_conquer(expr_ref_vector const& asms, unsigned num_threads, unsigned max_conflicts);
+
     public:
         parallel(context& ctx): ctx(ctx) {}
 
@@ -173,6 +173,7 @@ namespace smt {
             unsigned num_instances_checker_sat  = s->get_num_instances_checker_sat();
             unsigned max_generation = s->get_max_generation();
             float max_cost          = s->get_max_cost();
+            double cost_time        = s->get_cost_time();
             if (num_instances > 0 || num_instances_simplify_true>0 || num_instances_checker_sat>0) {
                 out << "[quantifier_instances] ";
                 out.width(10);
@@ -184,7 +185,7 @@ namespace smt {
                 out.width(3);
                 out << num_instances_checker_sat << " : ";
                 out.width(3);
-                out << max_generation << " : " << max_cost << "\n";
+                out << max_generation << " : " << max_cost << " : " << cost_time << "\n";
             }
         }
 
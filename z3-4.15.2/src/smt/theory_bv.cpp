@@ -893,6 +893,10 @@ namespace smt {
         if (approximate_term(term)) {
             return false;
         }
+        if (is_lazy_op(term)) {
+            internalize_lazy_op(term);
+            return true;
+        }
         switch (term->get_decl_kind()) {
         case OP_BV_NUM:         internalize_num(term); return true;
         case OP_BNEG:           internalize_neg(term); return true;
@@ -1139,6 +1143,139 @@ namespace smt {
         return false;
     }
 
+    //
+    // With bv.lazy_blast, multiplications and unsigned divisions over
+    // non-constant arguments are not bit-blasted when they are internalized.
+    // The result gets fresh bits that are constrained by cheap axioms only.
+    // The circuit is added in final_check_eh when the candidate model
+    // violates the semantics of the operator.
+    //
+    bool theory_bv::is_lazy_op(app * n) const {
+        if (!params().m_bv_lazy_blast || n->get_num_args() != 2)
+            return false;
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+            return !m_util.is_numeral(n->get_arg(0)) && !m_util.is_numeral(n->get_arg(1));
+        case OP_BUDIV_I:
+        case OP_BUREM_I:
+            return !m_util.is_numeral(n->get_arg(1));
+        default:
+            return false;
+        }
+    }
+
+    void theory_bv::internalize_lazy_op(app * n) {
+        SASSERT(!ctx.e_internalized(n));
+        process_args(n);
+        enode * e = mk_enode(n);
+        mk_bits(e->get_th_var(get_id()));
+        m_lazy_ops.push_back(n);
+        m_lazy_refined.push_back(false);
+        ctx.push_trail(push_back_vector<ptr_vector<app>>(m_lazy_ops));
+        ctx.push_trail(push_back_vector<bool_vector>(m_lazy_refined));
+        assert_lazy_op_axioms(n);
+    }
+
+    void theory_bv::assert_lazy_op_axioms(app * n) {
+        enode * e = ctx.get_enode(n);
+        expr * a = n->get_arg(0), * b = n->get_arg(1);
+        sort * s = n->get_sort();
+        expr_ref zero(m_util.mk_numeral(rational::zero(), s), m), one(m_util.mk_numeral(rational::one(), s), m);
+        literal b0 = mk_eq(b, zero, false);
+        literal b1 = mk_eq(b, one, false);
+        auto add_axiom = [&](literal l1, literal l2) {
+            ctx.mark_as_relevant(l1);
+            ctx.mark_as_relevant(l2);
+            ctx.mk_th_axiom(get_id(), l1, l2);
+        };
+        switch (n->get_decl_kind()) {
+        case OP_BMUL: {
+            // a = 0 or b = 0 => a*b = 0, a = 1 => a*b = b, b = 1 => a*b = a
+            literal n0 = mk_eq(n, zero, false);
+            add_axiom(~mk_eq(a, zero, false), n0);
+            add_axiom(~b0, n0);
+            add_axiom(~mk_eq(a, one, false), mk_eq(n, b, false));
+            add_axiom(~b1, mk_eq(n, a, false));
+            // the lowest bit of a product is the conjunction of the lowest bits of the factors.
+            literal r = m_bits[get_var(e)][0];
+            literal x = m_bits[get_arg_var(e, 0)][0];
+            literal y = m_bits[get_arg_var(e, 1)][0];
+            ctx.mk_th_axiom(get_id(), ~r, x);
+            ctx.mk_th_axiom(get_id(), ~r, y);
+            ctx.mk_th_axiom(get_id(), r, ~x, ~y);
+            break;
+        }
+        case OP_BUDIV_I:
+            // b = 0 => a/b = -1, b = 1 => a/b = a, b != 0 => a/b <= a
+            add_axiom(~b0, mk_eq(n, m_util.mk_numeral(rational(-1), s), false));
+            add_axiom(~b1, mk_eq(n, a, false));
+            add_axiom(b0, mk_literal(m_util.mk_ule(n, a)));
+            break;
+        case OP_BUREM_I:
+            // b = 0 => a%b = a, b = 1 => a%b = 0, a%b <= a, b != 0 => a%b < b
+            add_axiom(~b0, mk_eq(n, a, false));
+            add_axiom(~b1, mk_eq(n, zero, false));
+            add_axiom(b0, ~mk_literal(m_util.mk_ule(b, n)));
+            {
+                literal le = mk_literal(m_util.mk_ule(n, a));
+                ctx.mark_as_relevant(le);
+                ctx.mk_th_axiom(get_id(), 1, &le);
+            }
+            break;
+        default:
+            UNREACHABLE();
+        }
+    }
+
+    /**
+       \brief Return true if the bits assigned to \c n and its arguments
+       are consistent with the semantics of the operator.
+    */
+    bool theory_bv::check_lazy_op(app * n) {
+        enode * e = ctx.get_enode(n);
+        numeral r, a, b;
+        if (!get_fixed_value(get_var(e), r) ||
+            !get_fixed_value(get_arg_var(e, 0), a) ||
+            !get_fixed_value(get_arg_var(e, 1), b))
+            return false;
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+            return r == mod(a * b, rational::power_of_two(get_bv_size(e)));
+        case OP_BUDIV_I:
+            return r == (b.is_zero() ? rational::power_of_two(get_bv_size(e)) - 1 : div(a, b));
+        case OP_BUREM_I:
+            return r == (b.is_zero() ? a : mod(a, b));
+        default:
+            UNREACHABLE();
+            return true;
+        }
+    }
+
+    void theory_bv::blast_lazy_op(app * n) {
+        TRACE(bv, tout << "blast: " << mk_bounded_pp(n, m) << "\n";);
+        enode * e = ctx.get_enode(n);
+        expr_ref_vector arg1_bits(m), arg2_bits(m), bits(m);
+        get_arg_bits(e, 0, arg1_bits);
+        get_arg_bits(e, 1, arg2_bits);
+        unsigned sz = arg1_bits.size();
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:    m_bb.mk_multiplier(sz, arg1_bits.data(), arg2_bits.data(), bits); break;
+        case OP_BUDIV_I: m_bb.mk_udiv(sz, arg1_bits.data(), arg2_bits.data(), bits); break;
+        case OP_BUREM_I: m_bb.mk_urem(sz, arg1_bits.data(), arg2_bits.data(), bits); break;
+        default: UNREACHABLE();
+        }
+        ctx.internalize(bits.data(), sz, true);
+        literal_vector n_bits(m_bits[get_var(e)]);
+        for (unsigned i = 0; i < sz; ++i) {
+            literal l = ctx.get_literal(bits.get(i));
+            ctx.mark_as_relevant(l);
+            ctx.mk_th_axiom(get_id(), ~l, n_bits[i]);
+            ctx.mk_th_axiom(get_id(), l, ~n_bits[i]);
+        }
+        m_lazy_blasted.insert(n);
+        ctx.push_trail(insert_obj_trail<app>(m_lazy_blasted, n));
+    }
+
     void theory_bv::apply_sort_cnstr(enode * n, sort * s) {
         if (!is_attached_to_var(n) && !approximate_term(n->get_expr())) {
             mk_bits(mk_var(n));
@@ -1455,13 +1592,36 @@ namespace smt {
         if (m_approximates_large_bvs) {
             return FC_GIVEUP;
         }
-        return FC_DONE;
+        bool blasted = false;
+        for (unsigned i = 0; i < m_lazy_ops.size(); ++i) {
+            app * n = m_lazy_ops[i];
+            if (m_lazy_blasted.contains(n) || !ctx.is_relevant(n) || check_lazy_op(n))
+                continue;
+            blast_lazy_op(n);
+            m_lazy_refined[i] = true;
+            blasted = true;
+        }
+        return blasted ? FC_CONTINUE : FC_DONE;
+    }
+
+    /**
+       \brief A circuit added during search is retracted on backtracking.
+       Operators that needed their circuit once are blasted again at the
+       base level, so that the circuit stays.
+    */
+    void theory_bv::restart_eh() {
+        for (unsigned i = 0; i < m_lazy_ops.size(); ++i)
+            if (m_lazy_refined[i] && !m_lazy_blasted.contains(m_lazy_ops[i]))
+                blast_lazy_op(m_lazy_ops[i]);
     }
 
     void theory_bv::reset_eh() {
         pop_scope_eh(m_trail_stack.get_num_scopes());
         m_bool_var2atom.reset();
         m_fixed_var_table.reset();
+        m_lazy_ops.reset();
+        m_lazy_refined.reset();
+        m_lazy_blasted.reset();
         theory::reset_eh();
     }
 
@@ -1886,6 +2046,13 @@ namespace smt {
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
         st.update("bv dynamic eqs", m_stats.m_num_eq_dynamic);
+        if (!m_lazy_ops.empty()) {
+            unsigned num_refined = 0;
+            for (bool r : m_lazy_refined)
+                num_refined += r;
+            st.update("bv lazy blasted", num_refined);
+            st.update("bv lazy unblasted", m_lazy_ops.size() - num_refined);
+        }
     }
 
     theory_bv::var_enode_pos theory_bv::get_bv_with_theory(bool_var v, theory_id id) const {
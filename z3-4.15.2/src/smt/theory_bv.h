@@ -138,6 +138,9 @@ namespace smt {
         literal_vector           m_tmp_literals;
         svector<var_pos>         m_prop_queue;
         bool                     m_approximates_large_bvs;
+        ptr_vector<app>          m_lazy_ops;      // multiplications and divisions that are bit-blasted on demand
+        bool_vector              m_lazy_refined;  // per element of m_lazy_ops, whether it was ever blasted
+        obj_hashtable<app>       m_lazy_blasted;  // elements of m_lazy_ops whose circuit is currently asserted
 
         theory_var find(theory_var v) const { return m_find.find(v); }
         theory_var next(theory_var v) const { return m_find.next(v); }
@@ -219,6 +222,11 @@ namespace smt {
         void internalize_smul_no_underflow(app *n);
 
         bool approximate_term(app* n);
+        bool is_lazy_op(app * n) const;
+        void internalize_lazy_op(app * n);
+        void assert_lazy_op_axioms(app * n);
+        bool check_lazy_op(app * n);
+        void blast_lazy_op(app * n);
 
         template<bool Signed>
         void internalize_le(app * atom);
@@ -246,6 +254,7 @@ namespace smt {
         void pop_scope_eh(unsigned num_scopes) override;
         final_check_status final_check_eh() override;
         void reset_eh() override;
+        void restart_eh() override;
         bool include_func_interp(func_decl* f) override;
         svector<theory_var>   m_merge_aux[2]; //!< auxiliary vector used in merge_zero_one_bits
         bool merge_zero_one_bits(theory_var r1, theory_var r2);
@@ -0,0 +1,358 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cache_solver.cpp
+
+Abstract:
+
+    Implements a solver that caches unsat cores and models of check-sat
+    calls and answers queries from the cache before searching.
+
+    - An unsat core stays valid while the assertions it was found under
+      are asserted: adding assertions preserves unsatisfiability. A query
+      whose assumptions include the assumptions of a cached core is unsat
+      with that core. Cores are dropped when their scope is popped.
+
+    - A model stays valid across pops, since it satisfies a superset of
+      the remaining assertions. A cached model answers a query when it
+      evaluates the assumptions and the assertions added since it was
+      found to true. Each model records the prefix of assertions it is
+      known to satisfy, so assertions are evaluated once per model.
+
+--*/
+
+#include "solver/solver.h"
+#include "solver/cache_solver.h"
+#include "ast/ast_translation.h"
+#include "model/model.h"
+#include "params/solver_params.hpp"
+
+class cache_solver : public solver {
+
+    struct core_t {
+        expr_ref_vector core;
+        // the part of the core that was passed as assumptions.
+        // the other literals are names of assertions.
+        expr_ref_vector asms;
+        unsigned        level;
+    };
+
+    struct model_t {
+        model_ref mdl;
+        // number of assertions the model is known to satisfy.
+        unsigned  num_checked;
+    };
+
+    struct stats {
+        unsigned m_num_core_hits = 0;
+        unsigned m_num_model_hits = 0;
+        unsigned m_num_misses = 0;
+    };
+
+    ast_manager&    m;
+    solver_ref      s;
+    expr_ref_vector m_assertions;
+    unsigned_vector m_assertions_lim;
+    vector<core_t>  m_cores;
+    vector<model_t> m_models;
+    unsigned        m_max_cores = 256;
+    unsigned        m_max_models = 4;
+    // a user propagator can constrain the search, so its answers are not cached.
+    bool            m_user_propagator = false;
+    stats           m_stats;
+    // answer of the last check-sat if it came from the cache.
+    lbool           m_hit = l_undef;
+    expr_ref_vector m_hit_core;
+    model_ref       m_hit_model;
+    obj_hashtable<expr> m_asms;
+
+    bool find_core(unsigned num_assumptions, expr* const* assumptions) {
+        if (m_cores.empty())
+            return false;
+        m_asms.reset();
+        for (unsigned i = 0; i < num_assumptions; ++i)
+            m_asms.insert(assumptions[i]);
+        for (unsigned i = m_cores.size(); i-- > 0; ) {
+            auto const& c = m_cores[i];
+            if (!all_of(c.asms, [&](expr* a) { return m_asms.contains(a); }))
+                continue;
+            m_hit_core.reset();
+            m_hit_core.append(c.core);
+            return true;
+        }
+        return false;
+    }
+
+    bool is_model(model_t& e, unsigned num_assumptions, expr* const* assumptions) {
+        model& mdl = *e.mdl;
+        for (unsigned i = 0; i < num_assumptions; ++i)
+            if (has_quantifiers(assumptions[i]) || !mdl.is_true(assumptions[i]))
+                return false;
+        for (; e.num_checked < m_assertions.size(); ++e.num_checked) {
+            expr* f = m_assertions.get(e.num_checked);
+            if (has_quantifiers(f) || !mdl.is_true(f))
+                return false;
+        }
+        return true;
+    }
+
+    bool find_model(unsigned num_assumptions, expr* const* assumptions) {
+        for (unsigned i = m_models.size(); i-- > 0; ) {
+            if (!m.inc())
+                return false;
+            if (!is_model(m_models[i], num_assumptions, assumptions))
+                continue;
+            // move the model to the front of the eviction order.
+            model_t e = m_models[i];
+            m_models.erase(m_models.begin() + i);
+            m_models.push_back(e);
+            m_hit_model = e.mdl;
+            return true;
+        }
+        return false;
+    }
+
+    void add_core(unsigned num_assumptions, expr* const* assumptions) {
+        if (m_max_cores == 0)
+            return;
+        expr_ref_vector core(m);
+        s->get_unsat_core(core);
+        m_asms.reset();
+        for (unsigned i = 0; i < num_assumptions; ++i)
+            m_asms.insert(assumptions[i]);
+        // without unsat cores the solver reports an empty core, so
+        // all assumptions take part in it.
+        if (core.empty())
+            core.append(num_assumptions, assumptions);
+        expr_ref_vector asms(m);
+        for (expr* c : core)
+            if (m_asms.contains(c))
+                asms.push_back(c);
+        // levels of cores are non-decreasing, so evicting the oldest
+        // core keeps the cores that are popped last at the end.
+        if (m_cores.size() >= m_max_cores)
+            m_cores.erase(m_cores.begin());
+        m_cores.push_back({ core, asms, m_assertions_lim.size() });
+    }
+
+    void add_model() {
+        if (m_max_models == 0)
+            return;
+        model_ref mdl;
+        s->get_model_core(mdl);
+        if (!mdl)
+            return;
+        if (m_models.size() >= m_max_models)
+            m_models.erase(m_models.begin());
+        // the caller may update the model it gets, so the cache keeps a copy.
+        m_models.push_back({ model_ref(mdl->copy()), m_assertions.size() });
+    }
+
+    void reset_hit() {
+        m_hit = l_undef;
+        m_hit_core.reset();
+        m_hit_model = nullptr;
+    }
+
+public:
+
+    cache_solver(solver* s) :
+        solver(s->get_manager()),
+        m(s->get_manager()),
+        s(s),
+        m_assertions(m),
+        m_hit_core(m) {
+        updt_params(s->get_params());
+    }
+
+    void assert_expr_core2(expr* t, expr* a) override {
+        if (!a)
+            assert_expr_core(t);
+        else {
+            m_assertions.push_back(t);
+            s->assert_expr(t, a);
+        }
+    }
+
+    void assert_expr_core(expr* t) override {
+        m_assertions.push_back(t);
+        s->assert_expr(t);
+    }
+
+    void push() override {
+        m_assertions_lim.push_back(m_assertions.size());
+        s->push();
+    }
+
+    void pop(unsigned n) override {
+        if (n == 0)
+            return;
+        unsigned lvl = m_assertions_lim.size() - n;
+        unsigned old_sz = m_assertions_lim[lvl];
+        m_assertions_lim.shrink(lvl);
+        m_assertions.shrink(old_sz);
+        while (!m_cores.empty() && m_cores.back().level > lvl)
+            m_cores.pop_back();
+        // assertions at the popped positions are replaced by new ones.
+        for (auto& e : m_models)
+            e.num_checked = std::min(e.num_checked, old_sz);
+        reset_hit();
+        s->pop(n);
+    }
+
+    lbool check_sat_core(unsigned num_assumptions, expr* const* assumptions) override {
+        reset_hit();
+        if (m_user_propagator)
+            return s->check_sat_core(num_assumptions, assumptions);
+        if (find_core(num_assumptions, assumptions)) {
+            ++m_stats.m_num_core_hits;
+            return m_hit = l_false;
+        }
+        if (find_model(num_assumptions, assumptions)) {
+            ++m_stats.m_num_model_hits;
+            return m_hit = l_true;
+        }
+        ++m_stats.m_num_misses;
+        lbool r = s->check_sat_core(num_assumptions, assumptions);
+        if (r == l_false)
+            add_core(num_assumptions, assumptions);
+        else if (r == l_true)
+            add_model();
+        return r;
+    }
+
+    void collect_statistics(statistics& st) const override {
+        s->collect_statistics(st);
+        unsigned hits = m_stats.m_num_core_hits + m_stats.m_num_model_hits;
+        unsigned queries = hits + m_stats.m_num_misses;
+        st.update("cache core hits", m_stats.m_num_core_hits);
+        st.update("cache model hits", m_stats.m_num_model_hits);
+        st.update("cache misses", m_stats.m_num_misses);
+        if (queries > 0)
+            st.update("cache hit rate", static_cast<double>(hits) / queries);
+    }
+
+    void get_model_core(model_ref& mdl) override {
+        if (m_hit == l_true)
+            mdl = m_hit_model->copy();
+        else
+            s->get_model_core(mdl);
+    }
+
+    void get_unsat_core(expr_ref_vector& r) override {
+        if (m_hit == l_false)
+            r.append(m_hit_core);
+        else
+            s->get_unsat_core(r);
+    }
+
+    proof* get_proof_core() override { return m_hit == l_undef ? s->get_proof() : nullptr; }
+
+    std::string reason_unknown() const override { return s->reason_unknown(); }
+    void set_reason_unknown(char const* msg) override { s->set_reason_unknown(msg); }
+    void get_labels(svector<symbol>& r) override { if (m_hit == l_undef) s->get_labels(r); }
+
+    solver* translate(ast_manager& m, params_ref const& p) override {
+        ast_translation tr(get_manager(), m);
+        cache_solver* r = alloc(cache_solver, s->translate(m, p));
+        for (expr* f : m_assertions)
+            r->m_assertions.push_back(tr(f));
+        r->m_assertions_lim.append(m_assertions_lim);
+        return r;
+    }
+
+    void updt_params(params_ref const& p) override {
+        s->updt_params(p);
+        solver_params sp(s->get_params());
+        m_max_cores = sp.cache_max_cores();
+        m_max_models = sp.cache_max_models();
+    }
+
+    model_converter_ref get_model_converter() const override { return s->get_model_converter(); }
+
+    unsigned get_num_assertions() const override { return s->get_num_assertions(); }
+    expr* get_assertion(unsigned idx) const override { return s->get_assertion(idx); }
+    ast_manager& get_manager() const override { return s->get_manager(); }
+    void reset_params(params_ref const& p) override { s->reset_params(p); }
+    params_ref const& get_params() const override { return s->get_params(); }
+    void collect_param_descrs(param_descrs& r) override { s->collect_param_descrs(r); }
+    void push_params() override { s->push_params(); }
+    void pop_params() override { s->pop_params(); }
+    void set_produce_models(bool f) override { s->set_produce_models(f); }
+    void set_phase(expr* e) override { s->set_phase(e); }
+    void move_to_front(expr* e) override { s->move_to_front(e); }
+    phase* get_phase() override { return s->get_phase(); }
+    void set_phase(phase* p) override { s->set_phase(p); }
+    unsigned get_num_assumptions() const override { return s->get_num_assumptions(); }
+    expr* get_assumption(unsigned idx) const override { return s->get_assumption(idx); }
+    unsigned get_scope_level() const override { return s->get_scope_level(); }
+    void set_progress_callback(progress_callback* callback) override { s->set_progress_callback(callback); }
+
+    lbool get_consequences(expr_ref_vector const& asms, expr_ref_vector const& vars, expr_ref_vector& consequences) override {
+        reset_hit();
+        return s->get_consequences(asms, vars, consequences);
+    }
+
+    lbool check_sat_cc(expr_ref_vector const& cube, vector<expr_ref_vector> const& clauses) override {
+        if (clauses.empty())
+            return check_sat(cube);
+        reset_hit();
+        return s->check_sat_cc(cube, clauses);
+    }
+
+    lbool find_mutexes(expr_ref_vector const& vars, vector<expr_ref_vector>& mutexes) override {
+        return s->find_mutexes(vars, mutexes);
+    }
+
+    lbool preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>& cores) override {
+        reset_hit();
+        return s->preferred_sat(asms, cores);
+    }
+
+    expr_ref_vector cube(expr_ref_vector& vars, unsigned backtrack_level) override {
+        return s->cube(vars, backtrack_level);
+    }
+
+    expr* congruence_root(expr* e) override { return s->congruence_root(e); }
+    expr* congruence_next(expr* e) override { return s->congruence_next(e); }
+    expr_ref congruence_explain(expr* a, expr* b) override { return s->congruence_explain(a, b); }
+    std::ostream& display(std::ostream& out, unsigned n, expr* const* assumptions) const override {
+        return s->display(out, n, assumptions);
+    }
+    void get_units_core(expr_ref_vector& units) override { s->get_units_core(units); }
+    expr_ref_vector get_trail(unsigned max_level) override { return s->get_trail(max_level); }
+    void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override { s->get_levels(vars, depth); }
+
+    void register_on_clause(void* ctx, user_propagator::on_clause_eh_t& on_clause) override {
+        s->register_on_clause(ctx, on_clause);
+    }
+
+    void user_propagate_init(
+        void*                ctx,
+        user_propagator::push_eh_t&   push_eh,
+        user_propagator::pop_eh_t&    pop_eh,
+        user_propagator::fresh_eh_t&  fresh_eh) override {
+        m_user_propagator = true;
+        m_cores.reset();
+        m_models.reset();
+        s->user_propagate_init(ctx, push_eh, pop_eh, fresh_eh);
+    }
+    void user_propagate_register_fixed(user_propagator::fixed_eh_t& fixed_eh) override { s->user_propagate_register_fixed(fixed_eh); }
+    void user_propagate_register_final(user_propagator::final_eh_t& final_eh) override { s->user_propagate_register_final(final_eh); }
+    void user_propagate_register_eq(user_propagator::eq_eh_t& eq_eh) override { s->user_propagate_register_eq(eq_eh); }
+    void user_propagate_register_diseq(user_propagator::eq_eh_t& diseq_eh) override { s->user_propagate_register_diseq(diseq_eh); }
+    void user_propagate_register_expr(expr* e) override { s->user_propagate_register_expr(e); }
+    void user_propagate_register_created(user_propagator::created_eh_t& r) override { s->user_propagate_register_created(r); }
+    void user_propagate_register_decide(user_propagator::decide_eh_t& r) override { s->user_propagate_register_decide(r); }
+    void user_propagate_initialize_value(expr* var, expr* value) override { s->user_propagate_initialize_value(var, value); }
+};
+
+solver * mk_cache_solver(solver * s) {
+    solver_params sp(s->get_params());
+    if (sp.cache())
+        return alloc(cache_solver, s);
+    else
+        return s;
+}
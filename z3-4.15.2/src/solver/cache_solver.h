@@ -0,0 +1,21 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cache_solver.h
+
+Abstract:
+
+    Implements a solver that caches unsat cores and models of check-sat
+    calls and answers queries from the cache before searching.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+
+class solver;
+
+solver * mk_cache_solver(solver * s);
+
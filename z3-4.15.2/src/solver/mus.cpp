@@ -20,9 +20,16 @@ Notes:
 
 #include "solver/solver.h"
 #include "solver/mus.h"
+#include "solver/solver_pool.h"
+#include "util/scoped_ptr_vector.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
+#include "ast/ast_translation.h"
 #include "model/model_evaluator.h"
+#include "params/solver_params.hpp"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 
 struct mus::imp {
@@ -74,11 +81,19 @@ struct mus::imp {
             mus.push_back(m_lit2expr.back());
             return l_true;
         }
-        return get_mus1(mus);
+        ptr_vector<expr> unknown(m_lit2expr.size(), m_lit2expr.data());
+        return get_mus(unknown, mus);
     }
 
-    lbool get_mus1(expr_ref_vector& mus) {
-        ptr_vector<expr> unknown(m_lit2expr.size(), m_lit2expr.data());
+    // extend mus to a minimal core of mus and unknown.
+    lbool get_mus(ptr_vector<expr>& unknown, expr_ref_vector& mus) {
+        unsigned num_threads = solver_params(m_solver.get_params()).mus_threads();
+        if (num_threads > 1 && unknown.size() > 1)
+            return get_mus_par(unknown, mus, num_threads);
+        return get_mus1(unknown, mus);
+    }
+
+    lbool get_mus1(ptr_vector<expr>& unknown, expr_ref_vector& mus) {
         expr_ref_vector core_exprs(m);
         TRACE(mus, m_solver.display(tout););
         while (!unknown.empty()) { 
@@ -97,10 +112,14 @@ struct mus::imp {
             switch (is_sat) {
             case l_undef: 
                 return is_sat;
-            case l_true:
+            case l_true: {
                 mus.push_back(lit);
-                update_model();
+                model_ref mdl;
+                if (!m_soft.empty())
+                    m_solver.get_model(mdl);
+                update_model(mdl);
                 break;
+            }
             default:
                 core_exprs.reset();
                 m_solver.get_unsat_core(core_exprs);
@@ -125,6 +144,252 @@ struct mus::imp {
         return l_true;
     }
 
+    /**
+       Dichotomic deletion on copies of the solver.
+
+       unknown is partitioned into chunks. In each round the solver copies
+       check, concurrently, whether a chunk can be removed from mus and
+       unknown. A chunk is removed when the rest is unsat, and unknown is
+       reduced to the core. A chunk whose rest is sat stays sat after
+       unknown shrinks: if it is a single literal it belongs to the mus,
+       otherwise it is split in halves.
+    */
+    lbool get_mus_par(ptr_vector<expr>& unknown, expr_ref_vector& mus, unsigned num_threads) {
+#ifdef SINGLE_THREAD
+        return get_mus1(unknown, mus);
+#else
+        scoped_ptr_vector<ast_manager> pms;
+        sref_vector<solver> psolvers;
+        // released before the managers, it hands their limits back to m.
+        scoped_limits sl(m.limit());
+        params_ref p(m_solver.get_params());
+        p.set_uint("mus.threads", 1);
+        p.set_bool("core.minimize", false);
+        try {
+            for (unsigned i = 0; i < num_threads; ++i) {
+                ast_manager* new_m = alloc(ast_manager, m, true);
+                pms.push_back(new_m);
+                psolvers.push_back(m_solver.translate(*new_m, p));
+                sl.push_child(&(new_m->limit()));
+            }
+        }
+        catch (z3_exception&) {
+            // the solver cannot be copied.
+            return get_mus1(unknown, mus);
+        }
+
+        vector<ptr_vector<expr>> chunks;
+        unsigned chunk_size = (unknown.size() + num_threads - 1) / num_threads;
+        for (unsigned i = 0; i < unknown.size(); i += chunk_size)
+            chunks.push_back(ptr_vector<expr>(std::min(chunk_size, unknown.size() - i), unknown.data() + i));
+
+        auto split = [&](ptr_vector<expr> const& chunk, vector<ptr_vector<expr>>& out) {
+            if (chunk.size() == 1) {
+                mus.push_back(chunk[0]);
+                return;
+            }
+            unsigned half = chunk.size() / 2;
+            out.push_back(ptr_vector<expr>(half, chunk.data()));
+            out.push_back(ptr_vector<expr>(chunk.size() - half, chunk.data() + half));
+        };
+
+        while (!chunks.empty()) {
+            IF_VERBOSE(12, verbose_stream() << "(mus reducing core: " << unknown.size() << " chunks: " << chunks.size() << " new core: " << mus.size() << ")\n";);
+            unsigned n = std::min(num_threads, chunks.size());
+            vector<expr_ref_vector> pasms, pcores;
+            vector<model_ref> pmodels(n);
+            svector<lbool> results(n, l_undef);
+            for (unsigned i = 0; i < n; ++i) {
+                ast_translation tr(m, *pms[i]);
+                pasms.push_back(expr_ref_vector(*pms[i]));
+                pcores.push_back(expr_ref_vector(*pms[i]));
+                for (expr* e : mus)
+                    pasms[i].push_back(tr(e));
+                for (expr* e : m_assumptions)
+                    pasms[i].push_back(tr(e));
+                for (unsigned j = 0; j < chunks.size(); ++j)
+                    if (j != i)
+                        for (expr* e : chunks[j])
+                            pasms[i].push_back(tr(e));
+            }
+            auto worker_thread = [&](unsigned i) {
+                try {
+                    results[i] = psolvers[i]->check_sat(pasms[i]);
+                    if (results[i] == l_false)
+                        psolvers[i]->get_unsat_core(pcores[i]);
+                    else if (results[i] == l_true && !m_soft.empty())
+                        psolvers[i]->get_model(pmodels[i]);
+                }
+                catch (z3_exception&) {
+                    results[i] = l_undef;
+                }
+            };
+            vector<std::thread> threads(n);
+            for (unsigned i = 0; i < n; ++i)
+                threads[i] = std::thread([&, i]() { worker_thread(i); });
+            for (auto& th : threads)
+                th.join();
+
+            // use the smallest core.
+            unsigned best = UINT_MAX;
+            for (unsigned i = 0; i < n; ++i) {
+                if (results[i] == l_undef)
+                    return l_undef;
+                if (results[i] == l_false && (best == UINT_MAX || pcores[i].size() < pcores[best].size()))
+                    best = i;
+                if (results[i] == l_true && pmodels[i]) {
+                    ast_translation tr(*pms[i], m);
+                    model_ref mdl = pmodels[i]->translate(tr);
+                    update_model(mdl);
+                }
+            }
+
+            vector<ptr_vector<expr>> new_chunks;
+            if (best == UINT_MAX) {
+                // all tested chunks are needed.
+                for (unsigned i = n; i < chunks.size(); ++i)
+                    new_chunks.push_back(chunks[i]);
+                for (unsigned i = 0; i < n; ++i)
+                    split(chunks[i], new_chunks);
+            }
+            else {
+                ast_translation tr(*pms[best], m);
+                expr_set core;
+                for (expr* c : pcores[best])
+                    core.insert(tr(c));
+                unknown.reset();
+                for (unsigned i = 0; i < chunks.size(); ++i) {
+                    if (i == best)
+                        continue;
+                    ptr_vector<expr> chunk;
+                    for (expr* e : chunks[i])
+                        if (core.contains(e))
+                            chunk.push_back(e);
+                    unknown.append(chunk);
+                    if (chunk.empty())
+                        continue;
+                    if (i < n && results[i] == l_true)
+                        split(chunk, new_chunks);
+                    else
+                        new_chunks.push_back(chunk);
+                }
+            }
+            chunks.swap(new_chunks);
+        }
+        unknown.reset();
+        return l_true;
+#endif
+    }
+
+    /**
+       Enumerate minimal unsat subsets and minimal correction subsets of
+       the soft constraints (MARCO). A map solver over fresh Boolean
+       variables, one per soft constraint, tracks the subsets that are
+       not yet explored. A seed from the map is either satisfiable and
+       grown to a maximal satisfiable subset, whose complement is a
+       correction set, or unsatisfiable and shrunk to a minimal unsat
+       subset. The map is taken from a solver_pool over the solver.
+    */
+    lbool enumerate(unsigned max_num, vector<expr_ref_vector>& muses, vector<expr_ref_vector>& mcses) {
+        m_model.reset();
+        muses.reset();
+        mcses.reset();
+        lbool r = m_solver.check_sat(m_assumptions);
+        if (r == l_false) {
+            muses.push_back(expr_ref_vector(m));
+            return l_true;
+        }
+        if (r == l_undef)
+            return r;
+        unsigned n = m_lit2expr.size();
+        solver_pool pool(&m_solver, 1);
+        ref<solver> map = pool.mk_solver();
+        expr_ref_vector vars(m);
+        for (unsigned i = 0; i < n; ++i)
+            vars.push_back(m.mk_fresh_const("mus", m.mk_bool_sort()));
+        while (max_num == 0 || muses.size() + mcses.size() < max_num) {
+            r = map->check_sat(0, nullptr);
+            if (r != l_true)
+                return r == l_false ? l_true : r;
+            model_ref mdl;
+            map->get_model(mdl);
+            // prefer large seeds: unassigned variables are in the seed.
+            bool_vector in_seed(n, false);
+            expr_ref_vector seed(m);
+            for (unsigned i = 0; i < n; ++i) {
+                in_seed[i] = !mdl->is_false(vars.get(i));
+                if (in_seed[i])
+                    seed.push_back(m_lit2expr.get(i));
+            }
+            {
+                scoped_append _sa(*this, seed, m_assumptions);
+                r = m_solver.check_sat(seed);
+            }
+            if (r == l_undef)
+                return r;
+            expr_ref_vector block(m);
+            if (r == l_true) {
+                if (grow(in_seed) == l_undef)
+                    return l_undef;
+                expr_ref_vector mcs(m);
+                for (unsigned i = 0; i < n; ++i) {
+                    if (!in_seed[i]) {
+                        mcs.push_back(m_lit2expr.get(i));
+                        block.push_back(vars.get(i));
+                    }
+                }
+                mcses.push_back(mcs);
+            }
+            else {
+                expr_set core;
+                get_core(core);
+                ptr_vector<expr> unknown;
+                for (expr* e : seed)
+                    if (core.contains(e) || core.empty())
+                        unknown.push_back(e);
+                expr_ref_vector mus(m);
+                r = get_mus(unknown, mus);
+                if (r != l_true)
+                    return r;
+                for (expr* e : mus)
+                    block.push_back(m.mk_not(vars.get(m_expr2lit.find(e))));
+                muses.push_back(mus);
+            }
+            map->assert_expr(mk_or(block));
+        }
+        return l_undef;
+    }
+
+    // extend a satisfiable subset to a maximal satisfiable subset.
+    lbool grow(bool_vector& in_seed) {
+        model_ref mdl;
+        m_solver.get_model(mdl);
+        update_model(mdl);
+        expr_ref_vector mss(m);
+        for (unsigned i = 0; i < in_seed.size(); ++i)
+            if (in_seed[i])
+                mss.push_back(m_lit2expr.get(i));
+        for (unsigned i = 0; i < in_seed.size(); ++i) {
+            if (in_seed[i])
+                continue;
+            expr* lit = m_lit2expr.get(i);
+            if (!mdl->is_true(lit)) {
+                scoped_append _sa1(*this, mss, m_assumptions);
+                scoped_append _sa2(*this, mss, lit);
+                lbool r = m_solver.check_sat(mss);
+                if (r == l_undef)
+                    return r;
+                if (r == l_false)
+                    continue;
+                m_solver.get_model(mdl);
+                update_model(mdl);
+            }
+            in_seed[i] = true;
+            mss.push_back(lit);
+        }
+        return l_true;
+    }
+
     // use correction sets
     lbool get_mus2(expr_ref_vector& mus) {
         expr* lit = nullptr;
@@ -324,11 +589,8 @@ struct mus::imp {
         }
     }
 
-    void update_model() {
-        if (m_soft.empty()) return;
-        model_ref mdl;
-        expr_ref tmp(m);
-        m_solver.get_model(mdl);
+    void update_model(model_ref& mdl) {
+        if (m_soft.empty() || !mdl) return;
         rational w;
         for (unsigned i = 0; i < m_soft.size(); ++i) {
             if (!mdl->is_true(m_soft.get(i))) {
@@ -369,6 +631,10 @@ lbool mus::get_mus(expr_ref_vector& mus) {
     return m_imp->get_mus(mus);
 }
 
+lbool mus::enumerate(unsigned max_num, vector<expr_ref_vector>& muses, vector<expr_ref_vector>& mcses) {
+    return m_imp->enumerate(max_num, muses, mcses);
+}
+
 void mus::reset() {
     m_imp->reset();
 }
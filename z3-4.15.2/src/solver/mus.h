@@ -46,7 +46,19 @@ class mus {
      */
     void add_assumption(expr* lit);
 
+    /**
+       Minimize the core of soft constraints.
+       With solver.mus.threads > 1, chunks of the candidate literals are
+       tested concurrently on copies of the solver.
+    */
     lbool get_mus(expr_ref_vector& mus);
+
+    /**
+       Enumerate minimal unsat subsets and minimal correction subsets of
+       the soft constraints. Stop after max_num subsets, unless max_num is 0.
+       Return l_true if all subsets were enumerated.
+    */
+    lbool enumerate(unsigned max_num, vector<expr_ref_vector>& muses, vector<expr_ref_vector>& mcses);
     
     void reset();
     
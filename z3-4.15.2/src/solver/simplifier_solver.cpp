@@ -28,6 +28,7 @@ Author:
 #include "solver/solver.h"
 #include "solver/simplifier_solver.h"
 #include "solver/solver_preprocess.h"
+#include "params/solver_params.hpp"
 
 
 class simplifier_solver : public solver {
@@ -190,6 +191,7 @@ public:
             m_preprocess.add_simplifier((*fac)(m, s->get_params(), m_preprocess_state));
         else 
             init_preprocess(m, s->get_params(), m_preprocess, m_preprocess_state);
+        m_preprocess_state.model_trail().set_incremental(solver_params(s->get_params()).preprocess_incremental());
     }
 
     void assert_expr_core2(expr* t, expr* a) override {
@@ -232,6 +234,7 @@ public:
     void collect_statistics(statistics& st) const override { 
         s->collect_statistics(st); 
         m_preprocess.collect_statistics(st);
+        m_preprocess_state.m_reconstruction_trail.collect_statistics(st);
     }
 
     model_ref m_cached_model;
@@ -281,6 +284,7 @@ public:
     void updt_params(params_ref const& p) override { 
         s->updt_params(p); 
         m_preprocess.updt_params(p); 
+        m_preprocess_state.model_trail().set_incremental(solver_params(p).preprocess_incremental());
     }
 
     mutable model_converter_ref m_cached_mc;
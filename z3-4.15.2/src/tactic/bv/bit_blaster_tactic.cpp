@@ -132,6 +132,7 @@ public:
         r.insert("blast_mul", CPK_BOOL, "bit-blast multipliers (and dividers, remainders).", "true");
         r.insert("blast_add", CPK_BOOL, "bit-blast adders.", "true");
         r.insert("blast_quant", CPK_BOOL, "bit-blast quantified variables.", "false");
+        r.insert("blast_aig", CPK_BOOL, "build and/or gates as a structurally hashed and-inverter graph with two-level rewriting.", "false");
         r.insert("blast_full", CPK_BOOL, "bit-blast any term with bit-vector sort, this option will make E-matching ineffective in any pattern containing bit-vector terms.", "false");
     }
      
@@ -41,6 +41,7 @@ struct simplify_tactic::imp {
 
     void collect_statistics(statistics& st) {
         st.update("rewriter.steps", m_num_steps);
+        m_r.collect_statistics(st);
     }
 
     void operator()(goal & g) {
@@ -20,6 +20,7 @@ Notes:
 #include "tactic/tactic.h"
 #include "tactic/probe.h"
 #include "util/stopwatch.h"
+#include "util/profiler.h"
 #include "model/model_v2_pp.h"
 
 
@@ -198,6 +199,7 @@ tactic * mk_fail_if_undecided_tactic() {
 }
 
 void exec(tactic & t, goal_ref const & in, goal_ref_buffer & result) {
+    scoped_profile _profile(t.name());
     t.reset_statistics();
     try {
         t(in, result);
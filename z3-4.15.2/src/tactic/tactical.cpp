@@ -19,6 +19,7 @@ Notes:
 #include "util/scoped_timer.h"
 #include "util/cancel_eh.h"
 #include "util/scoped_ptr_vector.h"
+#include "util/profiler.h"
 #include "tactic/tactical.h"
 #include "tactic/goal_proof_converter.h"
 #ifndef SINGLE_THREAD
@@ -26,6 +27,12 @@ Notes:
 #endif
 #include <vector>
 
+// applies a tactic below a combinator. Every tactic is a phase of the profile.
+static void run_tactic(tactic & t, goal_ref const & in, goal_ref_buffer & result) {
+    scoped_profile _profile(t.name());
+    t(in, result);
+}
+
 class binary_tactical : public tactic {
 protected:
     tactic_ref      m_t1;
@@ -115,7 +122,7 @@ public:
 
         ast_manager & m = in->m();                                                                         
         goal_ref_buffer r1;
-        m_t1->operator()(in, r1);
+        run_tactic(*m_t1, in, r1);
         unsigned r1_size = r1.size();                                                                       
         SASSERT(r1_size > 0);  
         if (r1_size == 1) {                                                                                 
@@ -124,14 +131,14 @@ public:
                 return;
             }                                                                                               
             goal_ref r1_0 = r1[0];      
-            m_t2->operator()(r1_0, result);
+            run_tactic(*m_t2, r1_0, result);
         }
         else {
             goal_ref_buffer r2;
             for (unsigned i = 0; i < r1_size; i++) {                                                        
                 goal_ref g = r1[i];                                                                       
                 r2.reset();
-                m_t2->operator()(g, r2);
+                run_tactic(*m_t2, g, r2);
                 if (is_decided(r2)) {
                     SASSERT(r2.size() == 1);
                     if (is_decided_sat(r2)) {                                                          
@@ -348,7 +355,7 @@ public:
             SASSERT(sz > 0);
             if (i < sz - 1) {
                 try {
-                    t->operator()(in, result);
+                    run_tactic(*t, in, result);
                     return;
                 }
                 catch (tactic_exception &) {
@@ -378,7 +385,7 @@ public:
                 }
             }
             else {
-                t->operator()(in, result);
+                run_tactic(*t, in, result);
                 return;
             }
             in->reset_all();
@@ -509,7 +516,7 @@ public:
             tactic & t = *(ts.get(i));
             
             try {
-                t(in_copy, _result);
+                run_tactic(t, in_copy, _result);
                 bool first = false;
                 {
                     std::lock_guard<std::mutex> lock(mux);
@@ -626,7 +633,7 @@ public:
 
         ast_manager & m = in->m();                                                                          
         goal_ref_buffer r1;
-        m_t1->operator()(in, r1);                
+        run_tactic(*m_t1, in, r1);                
         unsigned r1_size = r1.size();                                                                               
         SASSERT(r1_size > 0);                                                                               
         if (r1_size == 1) {                                                                                 
@@ -636,7 +643,7 @@ public:
                 return;
             }                                                                                               
             goal_ref r1_0 = r1[0];                                                                          
-            m_t2->operator()(r1_0, result);
+            run_tactic(*m_t2, r1_0, result);
         }                                                                                     
         else {                                                                                              
 
@@ -674,7 +681,7 @@ public:
                 bool curr_failed = false;
 
                 try {
-                    ts2[i]->operator()(new_g, r2);                  
+                    run_tactic(*ts2[i], new_g, r2);                  
                 }
                 catch (tactic_exception & ex) {
                     {
@@ -868,7 +875,7 @@ public:
 
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
         m_clean = false;
-        m_t->operator()(in, result);
+        run_tactic(*m_t, in, result);
     }
    
     void cleanup(void) override { if (!m_clean) m_t->cleanup(); m_clean = true; }
@@ -917,7 +924,7 @@ class repeat_tactical : public unary_tactical {
         {
             goal orig_in(g->m(), proofs_enabled, models_enabled, cores_enabled);
             orig_in.copy_from(*(g.get()));
-            m_t->operator()(g, r1);                                                            
+            run_tactic(*m_t, g, r1);                                                            
             if (r1.size() == 1 && is_equal(orig_in, *(r1[0]))) {
                 result.push_back(r1[0]);
                 return;                                                                                     
@@ -1003,7 +1010,7 @@ public:
     char const* name() const override { return "fail_if_branching"; }
 
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
-        m_t->operator()(in, result);
+        run_tactic(*m_t, in, result);
         if (result.size() > m_threshold) {
             result.reset(); // assumes in is not strenthened to one of the branches
             throw tactic_exception("failed-if-branching tactical");
@@ -1027,7 +1034,7 @@ public:
     char const* name() const override { return "cleanup"; }
 
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
-        m_t->operator()(in, result);
+        run_tactic(*m_t, in, result);
         m_t->cleanup();
     }    
 
@@ -1052,7 +1059,7 @@ public:
         cancel_eh<reslimit> eh(in->m().limit());
         { 
             scoped_timer timer(m_timeout, &eh);
-            m_t->operator()(in, result);            
+            run_tactic(*m_t, in, result);            
         }
     }
 
@@ -1117,7 +1124,7 @@ public:
     
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
         scope _scope(m_name);
-        m_t->operator()(in, result);
+        run_tactic(*m_t, in, result);
     }
 
     tactic * translate(ast_manager & m) override { 
@@ -1147,9 +1154,9 @@ public:
     void operator()(goal_ref const & in, goal_ref_buffer & result) override {
         m_clean = false;
         if (m_p->operator()(*(in.get())).is_true()) 
-            m_t1->operator()(in, result);
+            run_tactic(*m_t1, in, result);
         else
-            m_t2->operator()(in, result);
+            run_tactic(*m_t2, in, result);
     }
 
     tactic * translate(ast_manager & m) override {
@@ -1218,7 +1225,7 @@ public:
             result.push_back(in.get());
         }
         else {
-            m_t->operator()(in, result);
+            run_tactic(*m_t, in, result);
         }
     }
 
@@ -1237,7 +1244,7 @@ public:
             result.push_back(in.get());
         }
         else {
-            m_t->operator()(in, result);
+            run_tactic(*m_t, in, result);
         }
     }
 
@@ -1255,7 +1262,7 @@ public:
             result.push_back(in.get());
         }
         else {
-            m_t->operator()(in, result);
+            run_tactic(*m_t, in, result);
         }
     }
 
@@ -16,7 +16,11 @@ Author:
 Revision History:
 
 --*/
+#include <string>
+#include <thread>
 #include "ast/ast.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
 
 static void tst1() {
     ast_manager m;
@@ -131,6 +135,53 @@ static void tst5() {
     m.del(arr3);
 }
 
+static void tst6() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort_ref I(a.mk_int(), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), I, I, I), m);
+    expr_ref_vector small(m);
+    for (unsigned i = 0; i < 16; ++i)
+        small.push_back(a.mk_int(i));
+    unsigned num_asts = m.get_num_asts();
+
+    unsigned const num_threads = 4, n = 5000;
+    m.set_concurrent(true);
+    for (unsigned round = 0; round < 2; ++round) {
+        vector<expr_ref_vector> results;
+        for (unsigned t = 0; t < num_threads; ++t)
+            results.push_back(expr_ref_vector(m));
+        vector<std::thread> threads(num_threads);
+        for (unsigned t = 0; t < num_threads; ++t) {
+            threads[t] = std::thread([&, t]() {
+                for (unsigned i = 0; i < n; ++i) {
+                    expr_ref x(m.mk_const(symbol(("x" + std::to_string(i % 64)).c_str()), I), m);
+                    // private terms that die and shared terms that are revived
+                    expr_ref tmp(m.mk_app(f.get(), x.get(), a.mk_int(i * num_threads + t)), m);
+                    tmp = m.mk_app(f.get(), tmp.get(), x.get());
+                    expr_ref e(m.mk_app(f.get(), x.get(), a.mk_int(i % 100)), m);
+                    results[t].push_back(m.mk_app(f.get(), e.get(), a.mk_int(i % 16)));
+                }
+            });
+        }
+        for (auto & th : threads)
+            th.join();
+        for (unsigned t = 1; t < num_threads; ++t)
+            for (unsigned i = 0; i < n; ++i)
+                ENSURE(results[t].get(i) == results[0].get(i));
+        // the private terms are reclaimed, the shared results survive.
+        unsigned before = m.get_num_asts();
+        m.reclaim_dead_nodes();
+        ENSURE(m.get_num_asts() < before);
+        ENSURE(m.contains(results[0].get(0)));
+        results.reset();
+        m.reclaim_dead_nodes();
+        ENSURE(m.get_num_asts() == num_asts);
+    }
+    m.set_concurrent(false);
+    ENSURE(m.get_num_asts() == num_asts);
+}
 
 struct foo {
     unsigned       m_id; 
@@ -153,5 +204,6 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst6();
 }
 
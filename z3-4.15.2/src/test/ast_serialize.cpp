@@ -0,0 +1,187 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.cpp
+
+Abstract:
+
+    Test binary AST serialization and compare it with the SMT2 text
+    based marshaling in round-trip time and size.
+
+--*/
+#include <iostream>
+#include <sstream>
+#include "ast/ast_serialize.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/array_decl_plugin.h"
+#include "ast/seq_decl_plugin.h"
+#include "ast/ast_smt_pp.h"
+#include "parsers/smt2/marshal.h"
+#include "util/stopwatch.h"
+
+static std::string serialize(ast_manager & m, expr * e) {
+    std::string out;
+    ast * a = e;
+    serialize_asts(m, 1, &a, out);
+    return out;
+}
+
+static expr_ref deserialize(ast_manager & m, std::string const & s) {
+    ast_ref_vector roots(m);
+    deserialize_asts(m, s.data(), s.size(), roots);
+    ENSURE(roots.size() == 1 && is_expr(roots.get(0)));
+    return expr_ref(to_expr(roots.get(0)), m);
+}
+
+static void check_round_trip(ast_manager & m, expr * e) {
+    std::string s = serialize(m, e);
+    // same manager: the result is the original term.
+    expr_ref r = deserialize(m, s);
+    ENSURE(r == e);
+    // fresh manager: serializing the copy yields the same bytes.
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    expr_ref r2 = deserialize(m2, s);
+    ENSURE(serialize(m2, r2) == s);
+}
+
+static void tst_terms() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    bv_util bv(m);
+    array_util ar(m);
+    seq_util su(m);
+
+    sort_ref U(m.mk_uninterpreted_sort(symbol("U")), m);
+    sort_ref I(a.mk_int(), m), R(a.mk_real(), m), B(bv.mk_sort(70), m);
+    sort_ref A(ar.mk_array_sort(I, B), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), U, I), m);
+    func_decl_ref g(m.mk_func_decl(symbol(7), I, R, U), m);
+    expr_ref u(m.mk_const(symbol("u"), U), m);
+    expr_ref x(m.mk_const(symbol("x"), I), m);
+    expr_ref y(m.mk_const(symbol("y"), R), m);
+    expr_ref b(m.mk_const(symbol("b"), B), m);
+    expr_ref arr(m.mk_const(symbol("arr"), A), m);
+
+    expr_ref big(a.mk_int(rational("-123456789012345678901234567890123456789")), m);
+    expr_ref frac(a.mk_numeral(rational(-7, 3), false), m);
+    expr_ref fu(m.mk_app(f.get(), u.get()), m);
+    expr_ref t1(m.mk_eq(m.mk_app(g, a.mk_add(fu, big), frac), u), m);
+    expr_ref t2(a.mk_le(a.mk_add(fu, fu, x), a.mk_int(-5)), m);
+    expr_ref t3(m.mk_eq(ar.mk_select(arr, x), bv.mk_bv_add(b, bv.mk_numeral(rational::power_of_two(69), 70))), m);
+    expr_ref t4(m.mk_eq(su.str.mk_concat(su.str.mk_string(zstring("ab\\u{1F600}")), m.mk_const(symbol("s"), su.str.mk_string_sort())),
+                        su.str.mk_string(zstring("xyz"))), m);
+    expr_ref_vector conj(m);
+    conj.push_back(t1);
+    conj.push_back(t2);
+    conj.push_back(t3);
+    conj.push_back(t4);
+    conj.push_back(m.mk_distinct(3, conj.data()));
+    for (expr * t : conj)
+        check_round_trip(m, t);
+    check_round_trip(m, m.mk_and(conj));
+
+    // quantifier with pattern
+    sort * sorts[2] = { U, I };
+    symbol names[2] = { symbol("v0"), symbol("v1") };
+    expr_ref v0(m.mk_var(1, U), m), v1(m.mk_var(0, I), m);
+    expr_ref fv(m.mk_app(f.get(), v0.get()), m);
+    expr_ref body(a.mk_ge(a.mk_add(fv, v1), v1), m);
+    app_ref pat(m.mk_pattern(to_app(fv)), m);
+    expr * pats[1] = { pat };
+    expr_ref q(m.mk_forall(2, sorts, names, body, 3, symbol("qid"), symbol::null, 1, pats), m);
+    check_round_trip(m, q);
+    check_round_trip(m, m.mk_not(m.mk_exists(2, sorts, names, body)));
+    check_round_trip(m, m.mk_lambda(2, sorts, names, fv));
+}
+
+static void tst_malformed() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref e(a.mk_le(a.mk_add(m.mk_const(symbol("x"), a.mk_int()), a.mk_int(3)), a.mk_int(5)), m);
+    std::string s = serialize(m, e);
+    for (unsigned i = 0; i + 1 < s.size(); ++i) {
+        ast_ref_vector roots(m);
+        try {
+            deserialize_asts(m, s.data(), i, roots);
+            ENSURE(false);
+        }
+        catch (z3_exception &) {
+        }
+    }
+    ENSURE(!is_serialized_ast("(assert x)", 10));
+}
+
+// a term whose tree size is exponential in its DAG size.
+static expr_ref mk_shared_term(ast_manager & m, unsigned n) {
+    bv_util bv(m);
+    sort_ref s(bv.mk_sort(32), m);
+    expr_ref r(m.mk_const(symbol("x"), s), m);
+    for (unsigned i = 0; i < n; ++i) {
+        expr_ref c(m.mk_const(symbol(("y" + std::to_string(i)).c_str()), s), m);
+        r = bv.mk_bv_add(bv.mk_bv_mul(r, c), bv.mk_bv_xor(r, bv.mk_numeral(rational(i * 7919), 32)));
+    }
+    return expr_ref(m.mk_eq(r, bv.mk_numeral(rational(0), 32)), m);
+}
+
+static void bench(ast_manager & m, char const * name, expr * e, unsigned reps) {
+    expr_ref _e(e, m);
+    stopwatch bin_out, bin_in, txt_out, txt_in;
+    size_t bin_size = 0, txt_size = 0;
+    std::string s;
+    for (unsigned i = 0; i < reps; ++i) {
+        {
+            scoped_watch _w(bin_out);
+            s = marshal(_e, m);
+        }
+        bin_size = s.size();
+        ast_manager m2;
+        reg_decl_plugins(m2);
+        scoped_watch _w(bin_in);
+        expr_ref r = unmarshal(s, m2);
+        ENSURE(r);
+    }
+    for (unsigned i = 0; i < reps; ++i) {
+        {
+            scoped_watch _w(txt_out);
+            std::ostringstream out;
+            ast_smt_pp pp(m);
+            pp.display_smt2(out, _e);
+            s = out.str();
+        }
+        txt_size = s.size();
+        ast_manager m2;
+        reg_decl_plugins(m2);
+        scoped_watch _w(txt_in);
+        expr_ref r = unmarshal(s, m2);
+        ENSURE(r);
+    }
+    std::cout << name << "\n";
+    std::cout << "  binary: " << bin_size << " bytes, write " << bin_out.get_seconds() << "s, read " << bin_in.get_seconds() << "s\n";
+    std::cout << "  text:   " << txt_size << " bytes, write " << txt_out.get_seconds() << "s, read " << txt_in.get_seconds() << "s\n";
+}
+
+void tst_ast_serialize_bench(char ** argv, int argc, int & i) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref_vector lits(m);
+    for (unsigned i = 0; i < 2000; ++i) {
+        expr_ref x(m.mk_const(symbol(("x" + std::to_string(i % 100)).c_str()), a.mk_int()), m);
+        expr_ref y(m.mk_const(symbol(("x" + std::to_string((i * 31) % 100)).c_str()), a.mk_int()), m);
+        lits.push_back(a.mk_le(a.mk_add(a.mk_mul(a.mk_int(i), x), y), a.mk_int(rational(i) * rational(1000003))));
+    }
+    bench(m, "linear arithmetic (2000 atoms)", m.mk_and(lits), 5);
+    bench(m, "shared bit-vector term (depth 200)", mk_shared_term(m, 200), 5);
+}
+
+void tst_ast_serialize() {
+    tst_terms();
+    tst_malformed();
+}
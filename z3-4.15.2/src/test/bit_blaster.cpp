@@ -21,8 +21,12 @@ Revision History:
 #include "ast/ast_ll_pp.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/rewriter/bit_blaster/bit_blaster.h"
+#include "ast/rewriter/bit_blaster/bit_blaster_rewriter.h"
+#include "ast/for_each_expr.h"
 #include "model/model.h"
 #include "model/model_evaluator.h"
+#include "util/stopwatch.h"
+#include <iostream>
 
 void mk_bits(ast_manager & m, char const * prefix, unsigned sz, expr_ref_vector & r) {
     sort_ref b(m);
@@ -227,6 +231,98 @@ void tst_sh(ast_manager & m, unsigned sz) {
 //     TRACE(bit_blaster, tout << "ashr " << c.size() << "\n"; display(tout, c, false););
 }
 
+// x * y + z = w, where w is the true value of the left hand side
+// in the assignment or off by one.
+static expr_ref mk_mul_fml(ast_manager & m, unsigned sz, unsigned num_muls) {
+    bv_util bv(m);
+    sort * s = bv.mk_sort(sz);
+    expr_ref_vector xs(m);
+    for (char const * n : { "x", "y", "z", "w" })
+        xs.push_back(m.mk_const(symbol(n), s));
+    expr_ref lhs(xs.get(0), m);
+    for (unsigned i = 0; i < num_muls; ++i)
+        lhs = bv.mk_bv_mul(lhs, xs.get(1 + i % 2));
+    return expr_ref(m.mk_eq(bv.mk_bv_add(lhs, xs.get(2)), xs.get(3)), m);
+}
+
+static void blast(ast_manager & m, expr * fml, bool aig, expr_ref & result, obj_map<func_decl, expr*> & const2bits, bit_blaster_rewriter & rw) {
+    params_ref p;
+    p.set_bool("blast_aig", aig);
+    rw.updt_params(p);
+    proof_ref pr(m);
+    rw(fml, result, pr);
+    ptr_vector<func_decl> newbits;
+    rw.get_translation(const2bits, newbits);
+}
+
+static bool eval_blasted(ast_manager & m, expr * fml, obj_map<func_decl, expr*> & const2bits, unsigned sz, uint64_t const * vals) {
+    model mdl(m);
+    unsigned k = 0;
+    for (auto const & [f, bits] : const2bits) {
+        char name = f->get_name().str()[0];
+        uint64_t v = vals[name == 'x' ? 0 : name == 'y' ? 1 : name == 'z' ? 2 : 3];
+        for (unsigned i = 0; i < sz; ++i)
+            mdl.register_decl(to_app(to_app(bits)->get_arg(i))->get_decl(), m.mk_bool_val((v >> i) & 1));
+        ++k;
+    }
+    ENSURE(k == 4);
+    return mdl.is_true(fml);
+}
+
+static void tst_aig_blast(unsigned sz, unsigned num_muls) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref fml = mk_mul_fml(m, sz, num_muls);
+    bit_blaster_rewriter rw1(m, params_ref()), rw2(m, params_ref());
+    expr_ref r1(m), r2(m);
+    obj_map<func_decl, expr*> c1, c2;
+    blast(m, fml, false, r1, c1, rw1);
+    blast(m, fml, true, r2, c2, rw2);
+    unsigned n1 = get_num_exprs(r1), n2 = get_num_exprs(r2);
+    std::cout << "bv" << sz << " muls: " << num_muls << " nodes: " << n1 << " aig nodes: " << n2 << "\n";
+    ENSURE(n2 < n1);
+    random_gen rand(sz);
+    uint64_t mask = sz == 64 ? ~0ull : (1ull << sz) - 1;
+    for (unsigned round = 0; round < 20; ++round) {
+        uint64_t vals[4];
+        for (unsigned i = 0; i < 3; ++i)
+            vals[i] = ((uint64_t(rand()) << 32) ^ rand()) & mask;
+        uint64_t lhs = vals[0];
+        for (unsigned i = 0; i < num_muls; ++i)
+            lhs *= vals[1 + i % 2];
+        lhs += vals[2];
+        vals[3] = (lhs + (round % 2)) & mask;
+        bool expected = round % 2 == 0;
+        ENSURE(eval_blasted(m, r1, c1, sz, vals) == expected);
+        ENSURE(eval_blasted(m, r2, c2, sz, vals) == expected);
+    }
+}
+
+static void bench_aig_blast(unsigned sz, unsigned num_muls, bool aig) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref fml = mk_mul_fml(m, sz, num_muls);
+    bit_blaster_rewriter rw(m, params_ref());
+    expr_ref r(m);
+    obj_map<func_decl, expr*> c;
+    size_t mem = memory::get_allocation_size();
+    stopwatch sw;
+    sw.start();
+    blast(m, fml, aig, r, c, rw);
+    sw.stop();
+    std::cout << "bv" << sz << " x" << num_muls << (aig ? " aig" : "    ")
+              << " nodes: " << get_num_exprs(r)
+              << " memory: " << (memory::get_allocation_size() - mem) / (1024 * 1024) << "MB"
+              << " time: " << sw.get_seconds() << "s\n";
+}
+
+void tst_bit_blaster_bench(char ** argv, int argc, int & i) {
+    for (unsigned sz : { 32, 64, 128 }) {
+        bench_aig_blast(sz, 4, false);
+        bench_aig_blast(sz, 4, true);
+    }
+}
+
 void tst_bit_blaster() {
     ast_manager m;
     reg_decl_plugins(m);
@@ -238,4 +334,7 @@ void tst_bit_blaster() {
     tst_le(m, 4);
     tst_eqs(m, 8);
     tst_sh(m, 4);
+    tst_aig_blast(8, 1);
+    tst_aig_blast(16, 3);
+    tst_aig_blast(64, 2);
 }
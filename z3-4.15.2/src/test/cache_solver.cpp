@@ -0,0 +1,148 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cache_solver.cpp
+
+Abstract:
+
+    Test the cache solver against an uncached solver.
+
+--*/
+#include "ast/reg_decl_plugins.h"
+#include "solver/solver.h"
+#include "solver/cache_solver.h"
+#include "smt/smt_solver.h"
+#include <cstring>
+
+static unsigned get_stat(solver& s, char const* key) {
+    statistics st;
+    s.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static ref<solver> mk_solver(ast_manager& m) {
+    params_ref p;
+    p.set_bool("cache", true);
+    ref<solver> s = mk_cache_solver(mk_smt_solver(m, p, symbol::null));
+    return s;
+}
+
+static void tst_hits() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    ref<solver> s = mk_solver(m);
+    expr_ref a(m.mk_const("a", m.mk_bool_sort()), m);
+    expr_ref b(m.mk_const("b", m.mk_bool_sort()), m);
+    expr_ref c(m.mk_const("c", m.mk_bool_sort()), m);
+    expr_ref na(m.mk_not(a), m), nb(m.mk_not(b), m);
+    s->assert_expr(m.mk_or(a, b));
+
+    expr_ref_vector asms(m);
+    asms.push_back(na);
+    asms.push_back(nb);
+    ENSURE(s->check_sat(asms) == l_false);
+    ENSURE(get_stat(*s, "cache misses") == 1);
+    // a superset of a core is answered from the cache.
+    asms.push_back(c);
+    ENSURE(s->check_sat(asms) == l_false);
+    ENSURE(get_stat(*s, "cache core hits") == 1);
+    expr_ref_vector core(m);
+    s->get_unsat_core(core);
+    ENSURE(core.size() == 2 && core.contains(na) && core.contains(nb));
+
+    asms.reset();
+    asms.push_back(a);
+    ENSURE(s->check_sat(asms) == l_true);
+    ENSURE(s->check_sat(asms) == l_true);
+    ENSURE(get_stat(*s, "cache model hits") == 1);
+    model_ref mdl;
+    s->get_model(mdl);
+    ENSURE(mdl && mdl->is_true(a));
+
+    // the cached model does not satisfy the new assertion.
+    s->push();
+    s->assert_expr(na);
+    ENSURE(s->check_sat(asms) == l_false);
+    ENSURE(get_stat(*s, "cache model hits") == 1);
+    ENSURE(s->check_sat(asms) == l_false);
+    ENSURE(get_stat(*s, "cache core hits") == 2);
+    // cores found in a scope are popped with it, models are kept.
+    s->pop(1);
+    ENSURE(s->check_sat(asms) == l_true);
+    ENSURE(get_stat(*s, "cache model hits") == 2);
+}
+
+static void tst_random(unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    ref<solver> s = mk_solver(m);
+    ref<solver> r = mk_smt_solver(m, p, symbol::null);
+    random_gen rand(seed);
+    unsigned const n = 6;
+    expr_ref_vector vars(m);
+    for (unsigned i = 0; i < n; ++i)
+        vars.push_back(m.mk_fresh_const("x", m.mk_bool_sort()));
+    auto lit = [&]() {
+        expr* v = vars.get(rand(n));
+        return expr_ref(rand(2) ? v : m.mk_not(v), m);
+    };
+    unsigned level = 0;
+    for (unsigned round = 0; round < 300; ++round) {
+        switch (rand(6)) {
+        case 0:
+            s->push();
+            r->push();
+            ++level;
+            break;
+        case 1:
+            if (level > 0) {
+                s->pop(1);
+                r->pop(1);
+                --level;
+            }
+            break;
+        case 2: {
+            expr_ref cl(m.mk_or(lit(), lit(), lit()), m);
+            s->assert_expr(cl);
+            r->assert_expr(cl);
+            break;
+        }
+        default: {
+            expr_ref_vector asms(m);
+            for (unsigned i = rand(4); i-- > 0; )
+                asms.push_back(lit());
+            lbool res = s->check_sat(asms);
+            ENSURE(res == r->check_sat(asms));
+            if (res == l_true) {
+                model_ref mdl;
+                s->get_model(mdl);
+                for (expr* f : asms)
+                    ENSURE(mdl->is_true(f));
+                for (unsigned i = 0; i < s->get_num_assertions(); ++i)
+                    ENSURE(mdl->is_true(s->get_assertion(i)));
+            }
+            else if (res == l_false) {
+                expr_ref_vector core(m);
+                s->get_unsat_core(core);
+                for (expr* c : core)
+                    ENSURE(asms.contains(c));
+                ENSURE(r->check_sat(core) == l_false);
+            }
+            break;
+        }
+        }
+    }
+    ENSURE(get_stat(*s, "cache core hits") + get_stat(*s, "cache model hits") > 0);
+}
+
+void tst_cache_solver() {
+    tst_hits();
+    for (unsigned seed = 0; seed < 10; ++seed)
+        tst_random(seed);
+}
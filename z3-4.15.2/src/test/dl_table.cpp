@@ -6,6 +6,10 @@ Copyright (c) 2015 Microsoft Corporation
 #include "muz/rel/dl_table.h"
 #include "muz/fp/dl_register_engine.h"
 #include "muz/rel/dl_relation_manager.h"
+#include "muz/rel/dl_table_relation.h"
+#include "muz/rel/rel_context.h"
+#include "util/stopwatch.h"
+#include <algorithm>
 #include <iostream>
 
 typedef datalog::table_base* (*mk_table_fn)(datalog::relation_manager& m, datalog::table_signature& sig);
@@ -92,10 +96,326 @@ static void test_table(mk_table_fn mk_table) {
 
 }
 
+static datalog::table_base* mk_columnar_table(datalog::relation_manager& m, datalog::table_signature& sig) {
+    datalog::table_plugin * p = m.get_table_plugin(symbol("columnar"));
+    ENSURE(p);
+    return p->mk_empty(sig);
+}
+
 void test_dl_bitvector_table() {
     test_table(mk_bv_table);
 }
 
+typedef std::vector<std::vector<uint64_t>> table_rows;
+
+static table_rows get_rows(datalog::table_base const& t) {
+    table_rows result;
+    datalog::table_fact f;
+    for (auto const& row : t) {
+        row.get_fact(f);
+        result.push_back(std::vector<uint64_t>(f.begin(), f.end()));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// fill a sparse and a columnar table with the same random rows.
+static void mk_random_tables(datalog::relation_manager& m, datalog::table_signature const& sig, unsigned num_rows,
+                             random_gen& rand, datalog::table_base*& sparse, datalog::table_base*& columnar) {
+    sparse = m.get_table_plugin(symbol("sparse"))->mk_empty(sig);
+    columnar = m.get_table_plugin(symbol("columnar"))->mk_empty(sig);
+    datalog::table_fact f;
+    f.resize(sig.size());
+    for (unsigned i = 0; i < num_rows; ++i) {
+        for (unsigned j = 0; j < sig.size(); ++j)
+            f[j] = rand(static_cast<unsigned>(sig[j]));
+        sparse->add_fact(f);
+        columnar->add_fact(f);
+    }
+}
+
+static unsigned_vector mk_cols(std::initializer_list<unsigned> cols) {
+    unsigned_vector result;
+    for (unsigned c : cols)
+        result.push_back(c);
+    return result;
+}
+
+// compare the operations of columnar tables with the ones of sparse tables.
+static void test_columnar_operations() {
+    smt_params params;
+    ast_manager ast_m;
+    reg_decl_plugins(ast_m);
+    datalog::register_engine re;
+    datalog::context ctx(ast_m, re, params);
+    datalog::relation_manager & m = ctx.get_rel_context()->get_rmanager();
+    datalog::table_signature sig;
+    sig.push_back(4);
+    sig.push_back(6);
+    sig.push_back(300);
+    random_gen rand(0);
+
+    auto same = [&](datalog::table_base* s, datalog::table_base* c) {
+        ENSURE(&c->get_plugin() == m.get_table_plugin(symbol("columnar")));
+        ENSURE(get_rows(*s) == get_rows(*c));
+        s->deallocate();
+        c->deallocate();
+    };
+
+    // sizes below and above the threshold for radix sorting
+    for (unsigned num_rows : { 0, 10, 600, 3000 }) {
+        datalog::table_base *s1, *c1, *s2, *c2;
+        mk_random_tables(m, sig, num_rows, rand, s1, c1);
+        mk_random_tables(m, sig, num_rows / 2, rand, s2, c2);
+        ENSURE(get_rows(*s1) == get_rows(*c1));
+        ENSURE(c1->get_size_estimate_rows() == s1->get_size_estimate_rows() || !c1->knows_exact_size());
+
+        unsigned_vector prefix = mk_cols({ 0, 1 }), swapped = mk_cols({ 1, 0 }), last = mk_cols({ 2 });
+        auto join = [&](unsigned_vector const& cols1, unsigned_vector const& cols2, unsigned_vector const& removed) {
+            scoped_ptr<datalog::table_join_fn> js = m.mk_join_project_fn(*s1, *s2, cols1, cols2, removed);
+            scoped_ptr<datalog::table_join_fn> jc = m.mk_join_project_fn(*c1, *c2, cols1, cols2, removed);
+            same((*js)(*s1, *s2), (*jc)(*c1, *c2));
+        };
+        join(prefix, prefix, unsigned_vector());
+        join(last, last, mk_cols({ 0, 3 }));
+        join(swapped, prefix, mk_cols({ 1, 2, 3 }));
+
+        for (unsigned_vector removed : { mk_cols({ 2 }), mk_cols({ 0 }), mk_cols({ 0, 2 }) }) {
+            scoped_ptr<datalog::table_transformer_fn> ps = m.mk_project_fn(*s1, removed);
+            scoped_ptr<datalog::table_transformer_fn> pc = m.mk_project_fn(*c1, removed);
+            same((*ps)(*s1), (*pc)(*c1));
+        }
+
+        unsigned cycle[3] = { 0, 2, 1 };
+        scoped_ptr<datalog::table_transformer_fn> rs = m.mk_rename_fn(*s1, 3, cycle);
+        scoped_ptr<datalog::table_transformer_fn> rc = m.mk_rename_fn(*c1, 3, cycle);
+        same((*rs)(*s1), (*rc)(*c1));
+
+        for (unsigned col : { 0, 1, 2 }) {
+            scoped_ptr<datalog::table_transformer_fn> ss = m.mk_select_equal_and_project_fn(*s1, 1, col);
+            scoped_ptr<datalog::table_transformer_fn> sc = m.mk_select_equal_and_project_fn(*c1, 1, col);
+            same((*ss)(*s1), (*sc)(*c1));
+
+            datalog::table_base* fs = s1->clone();
+            datalog::table_base* fc = c1->clone();
+            scoped_ptr<datalog::table_mutator_fn> es = m.mk_filter_equal_fn(*fs, 3, col);
+            scoped_ptr<datalog::table_mutator_fn> ec = m.mk_filter_equal_fn(*fc, 3, col);
+            (*es)(*fs);
+            (*ec)(*fc);
+            same(fs, fc);
+        }
+
+        {
+            datalog::table_base* fs = s1->clone();
+            datalog::table_base* fc = c1->clone();
+            scoped_ptr<datalog::table_mutator_fn> is = m.mk_filter_identical_fn(*fs, prefix);
+            scoped_ptr<datalog::table_mutator_fn> ic = m.mk_filter_identical_fn(*fc, prefix);
+            (*is)(*fs);
+            (*ic)(*fc);
+            same(fs, fc);
+        }
+
+        for (auto const& cols : { std::make_pair(prefix, prefix), std::make_pair(last, last),
+                                  std::make_pair(prefix, mk_cols({ 0, 0 })) }) {
+            datalog::table_base* fs = s1->clone();
+            datalog::table_base* fc = c1->clone();
+            scoped_ptr<datalog::table_intersection_filter_fn> ns = m.mk_filter_by_negation_fn(*fs, *s2, cols.first, cols.second);
+            scoped_ptr<datalog::table_intersection_filter_fn> nc = m.mk_filter_by_negation_fn(*fc, *c2, cols.first, cols.second);
+            (*ns)(*fs, *s2);
+            (*nc)(*fc, *c2);
+            same(fs, fc);
+        }
+
+        {
+            datalog::table_base* us = s1->clone();
+            datalog::table_base* uc = c1->clone();
+            datalog::table_base* ds = m.get_table_plugin(symbol("sparse"))->mk_empty(sig);
+            datalog::table_base* dc = m.get_table_plugin(symbol("columnar"))->mk_empty(sig);
+            scoped_ptr<datalog::table_union_fn> fs = m.mk_union_fn(*us, *s2, ds);
+            scoped_ptr<datalog::table_union_fn> fc = m.mk_union_fn(*uc, *c2, dc);
+            (*fs)(*us, *s2, ds);
+            (*fc)(*uc, *c2, dc);
+            same(ds, dc);
+            // a second union adds nothing
+            ds = m.get_table_plugin(symbol("sparse"))->mk_empty(sig);
+            dc = m.get_table_plugin(symbol("columnar"))->mk_empty(sig);
+            (*fc)(*uc, *c2, dc);
+            ENSURE(dc->empty());
+            same(ds, dc);
+            same(us, uc);
+        }
+
+        {
+            // remove every other row and check membership of the remaining ones
+            table_rows rows = get_rows(*s1);
+            datalog::table_fact f;
+            for (unsigned i = 0; i < rows.size(); i += 2) {
+                f.reset();
+                f.append(rows[i].size(), rows[i].data());
+                s1->remove_fact(f);
+                c1->remove_fact(f);
+            }
+            for (unsigned i = 0; i < rows.size(); ++i) {
+                f.reset();
+                f.append(rows[i].size(), rows[i].data());
+                ENSURE(c1->contains_fact(f) == (i % 2 == 1));
+            }
+            same(s1, c1);
+        }
+        s2->deallocate();
+        c2->deallocate();
+    }
+}
+
+// run a program whose relations are selected by datalog.columnar_relations.
+static table_rows columnar_closure(char const* columnar_relations) {
+    smt_params params;
+    ast_manager ast_m;
+    reg_decl_plugins(ast_m);
+    datalog::register_engine re;
+    datalog::context ctx(ast_m, re, params);
+    params_ref p;
+    p.set_sym("datalog.columnar_relations", symbol(columnar_relations));
+    ctx.updt_params(p);
+    datalog::dl_decl_util & dl = ctx.get_decl_util();
+    sort_ref n(dl.mk_sort(symbol("N"), 40), ast_m);
+    ctx.register_finite_sort(n, datalog::context::SK_SYMBOL);
+    sort* n2[2] = { n, n };
+    func_decl_ref edge(ast_m.mk_func_decl(symbol("edge"), 2, n2, ast_m.mk_bool_sort()), ast_m);
+    func_decl_ref node(ast_m.mk_func_decl(symbol("node"), 1, n2, ast_m.mk_bool_sort()), ast_m);
+    func_decl_ref path(ast_m.mk_func_decl(symbol("path"), 2, n2, ast_m.mk_bool_sort()), ast_m);
+    func_decl_ref far(ast_m.mk_func_decl(symbol("far"), 2, n2, ast_m.mk_bool_sort()), ast_m);
+    for (func_decl* f : { edge.get(), node.get(), path.get(), far.get() })
+        ctx.register_predicate(f, true);
+    expr_ref_vector vars(ast_m);
+    for (unsigned i = 0; i < 3; ++i)
+        vars.push_back(ast_m.mk_var(i, n));
+    expr* x = vars.get(0), * y = vars.get(1), * z = vars.get(2);
+    auto rule = [&](expr* body, expr* head) {
+        expr_ref r(ast_m.mk_implies(body, head), ast_m);
+        ctx.add_rule(r, symbol::null);
+    };
+    rule(ast_m.mk_app(edge.get(), x, y), ast_m.mk_app(node.get(), x));
+    rule(ast_m.mk_app(edge.get(), x, y), ast_m.mk_app(path.get(), x, y));
+    rule(ast_m.mk_and(ast_m.mk_app(edge.get(), x, y), ast_m.mk_app(path.get(), y, z)), ast_m.mk_app(path.get(), x, z));
+    rule(ast_m.mk_and(ast_m.mk_app(node.get(), x), ast_m.mk_app(node.get(), y), ast_m.mk_not(ast_m.mk_app(path.get(), x, y))), ast_m.mk_app(far.get(), x, y));
+    random_gen rand(0);
+    for (unsigned i = 0; i < 45; ++i) {
+        datalog::relation_fact f(ast_m);
+        f.push_back(dl.mk_numeral(rand(40), n));
+        f.push_back(dl.mk_numeral(rand(40), n));
+        ctx.add_fact(edge, f);
+    }
+    ctx.set_output_predicate(path);
+    ctx.set_output_predicate(far);
+    ctx.get_rel_context()->saturate();
+    datalog::relation_manager & m = ctx.get_rel_context()->get_rmanager();
+    datalog::relation_base & path_rel = m.get_relation(path);
+    datalog::relation_base & far_rel = m.get_relation(far);
+    ENSURE(path_rel.from_table() && far_rel.from_table());
+    datalog::table_base const& path_table = static_cast<datalog::table_relation&>(path_rel).get_table();
+    datalog::table_base const& far_table = static_cast<datalog::table_relation&>(far_rel).get_table();
+    // far is computed from columnar tables, so only path is known to follow the parameter
+    ENSURE((path_table.get_plugin().get_name() == symbol("columnar")) == (*columnar_relations != 0));
+    ENSURE(*columnar_relations != 0 || far_table.get_plugin().get_name() != symbol("columnar"));
+    table_rows result = get_rows(path_table);
+    table_rows far_rows = get_rows(far_table);
+    result.insert(result.end(), far_rows.begin(), far_rows.end());
+    return result;
+}
+
+static void test_columnar_relations() {
+    table_rows expected = columnar_closure("");
+    ENSURE(!expected.empty());
+    ENSURE(expected == columnar_closure("edge, path,node"));
+}
+
+// compose two random binary relations in sparse tables.
+static std::vector<std::pair<uint64_t, uint64_t>> compose_random(unsigned num_threads, unsigned num_rows, unsigned domain, double & seconds) {
+    datalog::table_signature sig;
+    sig.push_back(domain);
+    sig.push_back(domain);
+    smt_params params;
+    ast_manager ast_m;
+    reg_decl_plugins(ast_m);
+    datalog::register_engine re;
+    datalog::context ctx(ast_m, re, params);
+    params_ref p;
+    p.set_uint("datalog.threads", num_threads);
+    ctx.updt_params(p);
+    datalog::relation_manager & m = ctx.get_rel_context()->get_rmanager();
+    datalog::table_plugin * plugin = m.get_table_plugin(symbol("sparse"));
+    ENSURE(plugin);
+    datalog::table_base * t1 = plugin->mk_empty(sig);
+    datalog::table_base * t2 = plugin->mk_empty(sig);
+    random_gen rand(0);
+    datalog::table_fact f;
+    f.resize(2);
+    for (unsigned i = 0; i < num_rows; ++i) {
+        f[0] = rand(domain);
+        f[1] = rand(domain);
+        t1->add_fact(f);
+        f[0] = rand(domain);
+        f[1] = rand(domain);
+        t2->add_fact(f);
+    }
+    // r(x, z) :- t1(x, y), t2(y, z).
+    unsigned cols1[1] = { 1 };
+    unsigned cols2[1] = { 0 };
+    unsigned removed[2] = { 1, 2 };
+    datalog::table_join_fn * join = m.mk_join_project_fn(*t1, *t2, 1, cols1, cols2, 2, removed);
+    stopwatch sw;
+    sw.start();
+    datalog::table_base * r = (*join)(*t1, *t2);
+    sw.stop();
+    seconds = sw.get_seconds();
+    std::vector<std::pair<uint64_t, uint64_t>> result;
+    datalog::table_base::iterator it = r->begin();
+    datalog::table_base::iterator end = r->end();
+    for (; it != end; ++it) {
+        it->get_fact(f);
+        result.push_back({ f[0], f[1] });
+    }
+    std::sort(result.begin(), result.end());
+    dealloc(join);
+    t1->deallocate();
+    t2->deallocate();
+    r->deallocate();
+    return result;
+}
+
+static void test_parallel_join() {
+    double t;
+    for (unsigned domain : { 100, 5000, 20000 }) {
+        auto expected = compose_random(1, 20000, domain, t);
+        ENSURE(!expected.empty());
+        for (unsigned num_threads : { 2, 3, 8 })
+            ENSURE(expected == compose_random(num_threads, 20000, domain, t));
+    }
+}
+
 void tst_dl_table() {
     test_dl_bitvector_table();
+    test_table(mk_columnar_table);
+    test_columnar_operations();
+    test_columnar_relations();
+    test_parallel_join();
+}
+
+void tst_dl_join_bench(char** argv, int argc, int& i) {
+    unsigned num_rows = 1000000, domain = 1000000;
+    if (i + 1 < argc && argv[i + 1][0] != '/') {
+        num_rows = atoi(argv[i + 1]);
+        ++i;
+    }
+    if (i + 1 < argc && argv[i + 1][0] != '/') {
+        domain = atoi(argv[i + 1]);
+        ++i;
+    }
+    for (unsigned num_threads : { 1, 2, 4, 8 }) {
+        double t;
+        auto result = compose_random(num_threads, num_rows, domain, t);
+        std::cout << "rows: " << num_rows << " domain: " << domain << " threads: " << num_threads
+                  << " result: " << result.size() << " time: " << t << "s\n";
+    }
 }
@@ -0,0 +1,74 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ematching.cpp
+
+Abstract:
+
+    Test that parallel E-matching finds the same instances as sequential E-matching.
+
+--*/
+#include "api/z3.h"
+#include "util/debug.h"
+#include <cstring>
+#include <sstream>
+#include <string>
+
+static unsigned get_stat(Z3_context ctx, Z3_stats st, char const* key) {
+    for (unsigned i = 0; i < Z3_stats_size(ctx, st); ++i)
+        if (Z3_stats_is_uint(ctx, st, i) && strcmp(Z3_stats_get_key(ctx, st, i), key) == 0)
+            return Z3_stats_get_uint_value(ctx, st, i);
+    return 0;
+}
+
+// a chain of quantified definitions f0 .. f{k-1} over many ground terms.
+static std::string mk_benchmark(unsigned num_funs, unsigned num_terms, bool sat) {
+    std::ostringstream out;
+    for (unsigned j = 0; j <= num_funs; ++j)
+        out << "(declare-fun f" << j << " (Int) Int)\n";
+    for (unsigned j = 0; j < num_funs; ++j)
+        out << "(assert (forall ((x Int)) (! (= (f" << j << " x) (+ (f" << j + 1 << " x) 1)) :pattern ((f" << j << " x)))))\n";
+    for (unsigned i = 0; i < num_terms; ++i) {
+        out << "(declare-const c" << i << " Int)\n";
+        out << "(assert (> (f0 c" << i << ") " << i << "))\n";
+    }
+    out << "(assert (= (f0 c0) (+ (f" << num_funs << " c0) " << (sat ? num_funs : num_funs + 1) << ")))\n";
+    return out.str();
+}
+
+static void check(unsigned num_threads, unsigned& num_instances, Z3_lbool& result, bool sat) {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_solver s = Z3_mk_simple_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_params p = Z3_mk_params(ctx);
+    Z3_params_inc_ref(ctx, p);
+    Z3_params_set_uint(ctx, p, Z3_mk_string_symbol(ctx, "ematching.threads"), num_threads);
+    Z3_params_set_bool(ctx, p, Z3_mk_string_symbol(ctx, "mbqi"), false);
+    Z3_solver_set_params(ctx, s, p);
+    Z3_solver_from_string(ctx, s, mk_benchmark(6, 200, sat).c_str());
+    result = Z3_solver_check(ctx, s);
+    Z3_stats st = Z3_solver_get_statistics(ctx, s);
+    Z3_stats_inc_ref(ctx, st);
+    num_instances = get_stat(ctx, st, "quant instantiations");
+    Z3_stats_dec_ref(ctx, st);
+    Z3_params_dec_ref(ctx, p);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_context(ctx);
+}
+
+void tst_ematching() {
+    for (bool sat : { false, true }) {
+        unsigned n1 = 0, n4 = 0;
+        Z3_lbool r1, r4;
+        check(1, n1, r1, sat);
+        check(4, n4, r4, sat);
+        ENSURE(r1 == r4);
+        ENSURE(sat || r1 == Z3_L_FALSE);
+        ENSURE(n1 == n4);
+        ENSURE(n1 > 0);
+    }
+}
@@ -469,6 +469,8 @@ bool contains(std::string const &s, char const *pattern) {
 
 void setup_args_parser(argument_parser &parser) {
     parser.add_option_with_help_string("-add_rows", "test add_rows of static matrix");
+    parser.add_option_with_help_string("-row_ops", "test row operations of static matrix on small integers");
+    parser.add_option_with_help_string("-pivot_bench", "report the pivot throughput of static matrix");
     parser.add_option_with_help_string("-monics", "test emonics");
     parser.add_option_with_help_string("-nex_order", "test nex order");
     parser.add_option_with_help_string("-nla_cn", "test cross nornmal form");
@@ -1759,7 +1761,95 @@ void test_gomory_cut() {
         SASSERT(matrix.get_elem(1, 1) == 0); // 4 - 2*2
         SASSERT(matrix.get_elem(1, 2) == 4); // unchanged
     }
-    
+
+    // row operations on small integers use machine arithmetic; check them
+    // against rational arithmetic on values at the boundaries of int.
+    void test_row_ops() {
+        int const vals[] = { 0, 1, -1, 2, -3, 46341, -46341, INT_MAX, INT_MIN, INT_MAX - 1, INT_MIN + 1 };
+        for (int a : vals) {
+            for (int b : vals) {
+                for (int c : vals) {
+                    if (b == 0 || c == 0)
+                        continue;
+                    lp::static_matrix<mpq, mpq> matrix(2, 3);
+                    matrix.set(0, 0, mpq(b));
+                    matrix.set(0, 1, mpq(b));
+                    if (a != 0)
+                        matrix.set(1, 0, mpq(a));
+                    matrix.add_rows(mpq(c), 0, 1);
+                    ENSURE(matrix.get_elem(1, 0) == mpq(a) + mpq(b) * mpq(c));
+                    ENSURE(matrix.get_elem(1, 1) == mpq(b) * mpq(c));
+                    matrix.add_rows(mpq(1, 2), 0, 1);
+                    ENSURE(matrix.get_elem(1, 0) == mpq(a) + mpq(b) * mpq(c) + mpq(b) / mpq(2));
+                    ENSURE(matrix.is_correct());
+                }
+            }
+        }
+    }
+
+    // Pivots a random sparse matrix the way pivot_column_tableau does and
+    // reports the throughput. Pivots prefer unit coefficients, as slack
+    // rows of LRA problems have, so most cells stay small integers.
+    void test_pivot_bench(unsigned m, unsigned n, unsigned pivots) {
+        lp::static_matrix<mpq, mpq> A(m, n);
+        for (unsigned i = 0; i < m; i++) {
+            A.set(i, i, mpq(1));
+            for (unsigned k = 0; k < 4; k++) {
+                unsigned j = m + my_random() % (n - m);
+                int v = static_cast<int>(my_random() % 7) - 3;
+                if (A.get_elem(i, j).is_zero())
+                    A.set(i, j, mpq(v == 0 ? 1 : v));
+            }
+        }
+        unsigned num_pivots = 0, num_cells = 0;
+        stopwatch sw;
+        sw.start();
+        for (unsigned p = 0; p < pivots; p++) {
+            unsigned r = my_random() % m;
+            auto const & row = A.m_rows[r];
+            if (row.empty())
+                continue;
+            unsigned piv = row[my_random() % row.size()].var();
+            for (auto const & c : row)
+                if (c.coeff().is_one() || c.coeff().is_minus_one())
+                    piv = c.var();
+            A.divide_row(r, A.get_elem(r, piv));
+            auto & column = A.m_columns[piv];
+            for (unsigned k = 0; k < column.size(); k++) {
+                if (column[k].var() != r)
+                    continue;
+                std::swap(column[0], column[k]);
+                A.m_rows[r][column[0].offset()].offset() = 0;
+                A.m_rows[column[k].var()][column[k].offset()].offset() = k;
+                break;
+            }
+            while (column.size() > 1) {
+                num_cells += A.m_rows[column.back().var()].size();
+                A.pivot_row_to_row_given_cell(r, column.back(), piv);
+            }
+            num_pivots++;
+        }
+        sw.stop();
+        unsigned num_small = 0, num_nz = 0;
+        for (auto const & row : A.m_rows) {
+            for (auto const & c : row) {
+                num_nz++;
+                if (c.coeff().is_int() && c.coeff().is_int32())
+                    num_small++;
+            }
+        }
+        ENSURE(A.is_correct());
+        double secs = std::max(sw.get_seconds(), 1e-9);
+        std::cout << m << "x" << n << ": " << num_pivots / secs << " pivots/s, "
+                  << num_cells / secs / 1e6 << " M row cells/s, "
+                  << (num_nz ? 100 * num_small / num_nz : 0) << "% small integer cells\n";
+    }
+
+    void test_pivot_bench() {
+        test_pivot_bench(100, 300, 2000);
+        test_pivot_bench(400, 1200, 2000);
+    }
+
 void test_nla_order_lemma() { nla::test_order_lemma(); }
 
 void test_lp_local(int argn, char **argv) {
@@ -1780,6 +1870,14 @@ void test_lp_local(int argn, char **argv) {
         test_add_rows();
         return finalize(0);
     }
+    if (args_parser.option_is_used("-row_ops")) {
+        test_row_ops();
+        return finalize(0);
+    }
+    if (args_parser.option_is_used("-pivot_bench")) {
+        test_pivot_bench();
+        return finalize(0);
+    }
     if (args_parser.option_is_used("-monics")) {
         nla::test_monics();
         return finalize(0);
@@ -155,7 +155,10 @@ int main(int argc, char ** argv) {
     TST(rational);
     TST(inf_rational);
     TST(ast);
+    TST(ast_serialize);
+    TST_ARGV(ast_serialize_bench);
     TST(optional);
+    TST(opt_parallel);
     TST(bit_vector);
     TST(fixed_bit_vector);
     TST(tbv);
@@ -168,12 +171,17 @@ int main(int argc, char ** argv) {
     TST_ARGV(expr_rand);
     TST(list);
     TST(small_object_allocator);
+    TST_ARGV(memory_stress);
     TST(timeout);
+    TST(profiler);
     TST(proof_checker);
     TST(simplifier);
+    TST(simplifier_solver);
     TST(bit_blaster);
+    TST_ARGV(bit_blaster_bench);
     TST(var_subst);
     TST(simple_parser);
+    TST(qi_log);
     TST(api);
     TST(cube_clause);
     TST(old_interval);
@@ -183,9 +191,12 @@ int main(int argc, char ** argv) {
     TST(object_allocator);
     TST(mpz);
     TST(mpq);
+    TST(mus);
+    TST_ARGV(mpz_bench);
     TST(mpf);
     TST(total_order);
     TST(dl_table);
+    TST_ARGV(dl_join_bench);
     TST(dl_context);
     TST(dlist);
     TST(dl_util);
@@ -201,13 +212,19 @@ int main(int argc, char ** argv) {
     TST(nlarith_util);
     TST(api_bug);
     TST(arith_rewriter);
+    TST(th_rewriter);
     TST(check_assumptions);
+    TST(cache_solver);
     TST(smt_context);
+    TST(theory_bv);
     TST(theory_dl);
     TST(model_retrieval);
     TST(model_based_opt);
     TST(factor_rewriter);
     TST(smt2print_parse);
+    TST(smt2_scanner);
+    TST_ARGV(smt2_parse_bench);
+    TST_ARGV(simplifier_solver_bench);
     TST(substitution);
     TST(polynomial);
     TST(upolynomial);
@@ -218,6 +235,7 @@ int main(int argc, char ** argv) {
     TST(zstring);
     if (test_all) return 0;
     TST(ext_numeral);
+    TST(ematching);
     TST(interval);
     TST(value_generator);
     TST(value_sweep);
@@ -248,9 +266,12 @@ int main(int argc, char ** argv) {
     TST(theory_pb);
     TST(simplex);
     TST(sat_user_scope);
+    TST(sat_vivify);
+    TST(sat_bva);
     TST_ARGV(ddnf);
     TST(ddnf1);
     TST(model_evaluator);
+    TST(model_tape);
     TST(get_consequences);
     TST(pb2bv);
     TST_ARGV(sat_lookahead);
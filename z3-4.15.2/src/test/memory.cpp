@@ -6,9 +6,15 @@ Copyright (c) 2015 Microsoft Corporation
 
 #include "api/z3.h"
 #include "api/z3_private.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <thread>
 #include "util/util.h"
 #include "util/trace.h"
+#include "util/memory_manager.h"
+#include "util/vector.h"
 
 static bool oom = false;
 
@@ -58,3 +64,125 @@ void tst_memory() {
     Z3_reset_memory();
 
 }
+
+namespace {
+
+    struct block {
+        unsigned char * m_data;
+        size_t          m_size;
+        unsigned char   m_tag;
+    };
+
+    void fill(block const & b) {
+        memset(b.m_data, b.m_tag, b.m_size);
+    }
+
+    void check(block const & b) {
+        for (size_t i = 0; i < b.m_size; ++i)
+            ENSURE(b.m_data[i] == b.m_tag);
+    }
+
+    size_t random_size(random_gen & r) {
+        // mostly small blocks, some above the small size limit.
+        return r(8) == 0 ? 1 + r(8192) : 1 + r(1024);
+    }
+}
+
+// Multi-threaded stress test for memory::allocate, reallocate and deallocate.
+// Blocks are freed by other threads than the ones that allocated them, which
+// exercises the remote free lists of the sharded allocator (Z3_SHARDED_ALLOCATOR).
+// Run with: test-z3 memory_stress [num_threads] [num_rounds]
+void tst_memory_stress(char ** argv, int argc, int & i) {
+    unsigned num_threads = 8, num_rounds = 200000;
+    if (i + 1 < argc && argv[i + 1][0] != '/') {
+        num_threads = atoi(argv[i + 1]);
+        ++i;
+    }
+    if (i + 1 < argc && argv[i + 1][0] != '/') {
+        num_rounds = atoi(argv[i + 1]);
+        ++i;
+    }
+    unsigned long long before = memory::get_allocation_size();
+
+    // blocks handed over to the next thread, which frees them.
+    std::mutex mux;
+    vector<svector<block>> mailbox(num_threads);
+
+    auto worker = [&](unsigned id) {
+        random_gen r(id);
+        svector<block> live;
+        for (unsigned k = 0; k < num_rounds; ++k) {
+            switch (r(8)) {
+            case 0: case 1: case 2: {
+                block b;
+                b.m_size = random_size(r);
+                b.m_data = static_cast<unsigned char*>(memory::allocate(b.m_size));
+                b.m_tag = static_cast<unsigned char>(r(256));
+                fill(b);
+                live.push_back(b);
+                break;
+            }
+            case 3:
+                if (!live.empty()) {
+                    // grow or shrink; the common prefix must survive.
+                    block & b = live[r(live.size())];
+                    size_t sz = random_size(r);
+                    b.m_data = static_cast<unsigned char*>(memory::reallocate(b.m_data, sz));
+                    for (size_t j = 0; j < std::min(sz, b.m_size); ++j)
+                        ENSURE(b.m_data[j] == b.m_tag);
+                    b.m_size = sz;
+                    fill(b);
+                }
+                break;
+            case 4: case 5:
+                if (!live.empty()) {
+                    unsigned j = r(live.size());
+                    check(live[j]);
+                    memory::deallocate(live[j].m_data);
+                    live[j] = live.back();
+                    live.pop_back();
+                }
+                break;
+            case 6:
+                if (!live.empty()) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    mailbox[(id + 1) % num_threads].push_back(live.back());
+                    live.pop_back();
+                }
+                break;
+            default: {
+                svector<block> inbox;
+                {
+                    std::lock_guard<std::mutex> lock(mux);
+                    inbox.swap(mailbox[id]);
+                }
+                for (block const & b : inbox) {
+                    check(b);
+                    memory::deallocate(b.m_data);
+                }
+                break;
+            }
+            }
+        }
+        for (block const & b : live) {
+            check(b);
+            memory::deallocate(b.m_data);
+        }
+    };
+
+    vector<std::thread> threads(num_threads);
+    for (unsigned t = 0; t < num_threads; ++t)
+        threads[t] = std::thread([&, t]() { worker(t); });
+    for (auto & th : threads)
+        th.join();
+    for (auto & box : mailbox)
+        for (block const & b : box) {
+            check(b);
+            memory::deallocate(b.m_data);
+        }
+
+    // threads publish their counters in chunks, so a small residue per thread remains.
+    long long diff = static_cast<long long>(memory::get_allocation_size()) - static_cast<long long>(before);
+    std::cout << "allocation size difference: " << diff << ", max used: " << memory::get_max_used_memory() << "\n";
+    ENSURE(std::abs(diff) <= static_cast<long long>(num_threads) * 2 * 100000);
+}
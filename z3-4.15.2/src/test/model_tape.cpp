@@ -0,0 +1,165 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    model_tape.cpp
+
+Abstract:
+
+    Compare compiled model evaluation against model_evaluator.
+
+--*/
+#include "model/model.h"
+#include "model/model_tape.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/ast_pp.h"
+#include "util/util.h"
+#include <iostream>
+
+namespace {
+
+    struct term_gen {
+        ast_manager & m;
+        arith_util    a;
+        bv_util       bv;
+        array_util    ar;
+        random_gen    rand;
+        func_decl_ref f;
+        expr_ref      A;
+        expr_ref_vector bvs, ints, bools;
+
+        term_gen(ast_manager & m, unsigned seed):
+            m(m), a(m), bv(m), ar(m), rand(seed), f(m), A(m), bvs(m), ints(m), bools(m) {
+            sort * b8 = bv.mk_sort(8);
+            f = m.mk_func_decl(symbol("f"), b8, b8);
+            A = m.mk_const(symbol("A"), ar.mk_array_sort(b8, b8));
+            for (char const * n : { "x", "y", "z" })
+                bvs.push_back(m.mk_const(symbol(n), b8));
+            bvs.push_back(bv.mk_numeral(rational(0), 8));
+            bvs.push_back(bv.mk_numeral(rational(200), 8));
+            for (char const * n : { "i", "j" })
+                ints.push_back(m.mk_const(symbol(n), a.mk_int()));
+            ints.push_back(a.mk_int(3));
+            ints.push_back(a.mk_int(-7));
+            bools.push_back(m.mk_const(symbol("p"), m.mk_bool_sort()));
+        }
+
+        expr * pick(expr_ref_vector const & v) { return v.get(rand(v.size())); }
+
+        void grow() {
+            expr * x = pick(bvs), * y = pick(bvs), * z = pick(bvs);
+            expr * i = pick(ints), * j = pick(ints);
+            expr * p = pick(bools), * q = pick(bools);
+            switch (rand(12)) {
+            case 0: bvs.push_back(bv.mk_bv_add(x, y)); break;
+            case 1: bvs.push_back(bv.mk_bv_mul(x, y)); break;
+            case 2: bvs.push_back(bv.mk_bv_ashr(x, y)); break;
+            case 3: bvs.push_back(bv.mk_bv_urem_i(x, y)); break;
+            case 4: bvs.push_back(m.mk_app(f, x)); break;
+            case 5: bvs.push_back(ar.mk_select(A, x)); break;
+            case 6: bvs.push_back(bv.mk_concat(bv.mk_extract(3, 0, x), bv.mk_extract(7, 4, y))); break;
+            case 7: ints.push_back(a.mk_add(i, a.mk_mul(j, bv.mk_ubv2int(x)))); break;
+            case 8: ints.push_back(a.mk_mod(i, j)); break;
+            case 9: bools.push_back(m.mk_or(bv.mk_slt(x, y), m.mk_not(a.mk_le(i, j)))); break;
+            case 10: bools.push_back(m.mk_and(p, m.mk_eq(x, z), q)); break;
+            default: bvs.push_back(m.mk_ite(p, x, bv.mk_bv_not(y))); break;
+            }
+        }
+
+        model_ref mk_model() {
+            model_ref mdl = alloc(model, m);
+            for (expr * e : bvs)
+                if (is_uninterp_const(e))
+                    mdl->register_decl(to_app(e)->get_decl(), bv.mk_numeral(rational(rand(256)), 8));
+            for (expr * e : ints)
+                if (is_uninterp_const(e))
+                    mdl->register_decl(to_app(e)->get_decl(), a.mk_int(static_cast<int>(rand(41)) - 20));
+            mdl->register_decl(to_app(bools.get(0))->get_decl(), m.mk_bool_val(rand(2) == 0));
+            func_interp * fi = alloc(func_interp, m, 1);
+            for (unsigned k = 0; k < 20; ++k) {
+                expr * arg = bv.mk_numeral(rational(rand(256)), 8);
+                if (!fi->get_entry(&arg))
+                    fi->insert_entry(&arg, bv.mk_numeral(rational(rand(256)), 8));
+            }
+            fi->set_else(bv.mk_numeral(rational(rand(256)), 8));
+            mdl->register_decl(f, fi);
+            expr_ref arr(ar.mk_const_array(A->get_sort(), bv.mk_numeral(rational(7), 8)), m);
+            for (unsigned k = 0; k < 10; ++k) {
+                expr * args[3] = { arr, bv.mk_numeral(rational(rand(256)), 8), bv.mk_numeral(rational(rand(256)), 8) };
+                arr = ar.mk_store(3, args);
+            }
+            mdl->register_decl(to_app(A)->get_decl(), arr);
+            return mdl;
+        }
+    };
+}
+
+static void tst_random(unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    term_gen gen(m, seed);
+    for (unsigned k = 0; k < 300; ++k)
+        gen.grow();
+    model_tape tape(m);
+    expr_ref_vector roots(m);
+    roots.append(gen.bvs);
+    roots.append(gen.ints);
+    roots.append(gen.bools);
+    for (expr * e : roots)
+        ENSURE(tape.add(e));
+    unsigned num_undef = 0;
+    for (unsigned round = 0; round < 10; ++round) {
+        model_ref mdl = gen.mk_model();
+        tape(*mdl, true);
+        for (unsigned i = 0; i < roots.size(); ++i) {
+            expr_ref v1(m), v2(m);
+            v2 = (*mdl)(roots.get(i));
+            if (!tape.get_value(i, v1)) {
+                ++num_undef;
+                continue;
+            }
+            if (v1 != v2) {
+                std::cout << mk_pp(roots.get(i), m) << "\n" << v1 << " != " << v2 << "\n";
+                ENSURE(false);
+            }
+        }
+    }
+    // only integer modulus by zero is left to the evaluator.
+    std::cout << "undefined: " << num_undef << " of " << 10 * roots.size() << "\n";
+}
+
+static void tst_fallback() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    bv_util bv(m);
+    model mdl(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_real()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    expr_ref s(m.mk_const(symbol("s"), m.mk_uninterpreted_sort(symbol("S"))), m);
+    expr_ref w(m.mk_const(symbol("w"), bv.mk_sort(128)), m);
+    model_tape tape(m);
+    // terms outside of the fragment are not compiled
+    ENSURE(!tape.add(m.mk_eq(s, s)));
+    ENSURE(!tape.add(bv.mk_ule(w, w)));
+    // division by zero is left to the model
+    ENSURE(tape.add(a.mk_div(x, a.mk_real(0))));
+    ENSURE(tape.add(a.mk_gt(y, a.mk_int(2))));
+    mdl.register_decl(to_app(x)->get_decl(), a.mk_real(1));
+    tape(mdl, false);
+    expr_ref r(m);
+    ENSURE(!tape.get_value(0, r));
+    ENSURE(!tape.get_value(2, r));
+    // without model completion y has no value
+    ENSURE(!tape.get_value(3, r));
+    tape(mdl, true);
+    ENSURE(tape.get_value(3, r) && m.is_false(r));
+    ENSURE(mdl.get_const_interp(to_app(y)->get_decl()) != nullptr);
+}
+
+void tst_model_tape() {
+    for (unsigned seed = 0; seed < 5; ++seed)
+        tst_random(seed);
+    tst_fallback();
+}
@@ -21,6 +21,7 @@ Revision History:
 #include "util/rational.h"
 #include "util/timeit.h"
 #include "util/scoped_numeral.h"
+#include "util/stopwatch.h"
 #include <iostream>
 
 static void tst1() {
@@ -504,9 +505,70 @@ static void tst_pw2() {
     }
 }
 
+// Compare operations on values of at most 64 bits, which use machine
+// arithmetic, with the same operations on the values scaled by 2^64,
+// which use the multi-precision algorithms.
+static void tst_i64_fast_path(unsynch_mpz_manager & m, int64_t x, int64_t y) {
+    scoped_mpz a(m), b(m), sa(m), sb(m), r(m), sr(m), q(m), sq(m);
+    m.set(a, x);
+    m.set(b, y);
+    m.mul2k(a, 64, sa);
+    m.mul2k(b, 64, sb);
+
+    m.add(a, b, r);
+    m.add(sa, sb, sr);
+    m.mul2k(r, 64);
+    ENSURE(m.eq(r, sr));
+
+    m.sub(a, b, r);
+    m.sub(sa, sb, sr);
+    m.mul2k(r, 64);
+    ENSURE(m.eq(r, sr));
+
+    m.mul(a, b, r);
+    m.mul(sa, sb, sr);
+    m.mul2k(r, 128);
+    ENSURE(m.eq(r, sr));
+
+    m.gcd(a, b, r);
+    m.gcd(sa, sb, sr);
+    m.mul2k(r, 64);
+    ENSURE(m.eq(r, sr));
+
+    if (y != 0) {
+        m.machine_div_rem(a, b, q, r);
+        m.machine_div_rem(sa, sb, sq, sr);
+        ENSURE(m.eq(q, sq));
+        m.mul2k(r, 64);
+        ENSURE(m.eq(r, sr));
+        m.machine_div(a, b, q);
+        ENSURE(m.eq(q, sq));
+        m.rem(a, b, r);
+        m.mul2k(r, 64);
+        ENSURE(m.eq(r, sr));
+    }
+}
+
+static void tst_i64_fast_path() {
+    unsynch_mpz_manager m;
+    int64_t const special[] = { 0, 1, -1, 2, -2, INT_MAX, INT_MIN, static_cast<int64_t>(INT_MAX) + 1,
+                                static_cast<int64_t>(INT_MIN) - 1, static_cast<int64_t>(UINT_MAX), 
+                                INT64_MAX, INT64_MIN + 1, INT64_MAX / 2, -(INT64_MAX / 2), 3037000499ll, -3037000500ll };
+    for (int64_t x : special)
+        for (int64_t y : special)
+            tst_i64_fast_path(m, x, y);
+    for (unsigned i = 0; i < 10000; ++i) {
+        unsigned sx = rand() % 64, sy = rand() % 64;
+        int64_t x = static_cast<int64_t>((static_cast<uint64_t>(rand()) << 32 | rand()) >> sx);
+        int64_t y = static_cast<int64_t>((static_cast<uint64_t>(rand()) << 32 | rand()) >> sy);
+        tst_i64_fast_path(m, rand() % 2 ? x : -x, rand() % 2 ? y : -y);
+    }
+}
+
 void tst_mpz() {
     disable_trace("mpz");
     enable_trace("mpz_2k");
+    tst_i64_fast_path();
     tst_pw2();
     tst5();
     tst_div2k_bug();
@@ -527,3 +589,97 @@ void tst_mpz() {
     tst2();
     tst2b();
 }
+
+static void bench_numbers(unsynch_mpz_manager & m, unsigned bits, unsigned n, vector<mpz> & nums) {
+    for (unsigned i = 0; i < n; ++i) {
+        mpz v;
+        m.set(v, rand() % 2 ? 1 : -1);
+        for (unsigned b = 0; b < bits; b += 15)
+            m.addmul(mpz(rand() & 0x7fff), v, mpz(1 << 15), v);
+        m.machine_div2k(v, (bits + 14) / 15 * 15 - bits);
+        if (m.is_zero(v))
+            m.set(v, 3);
+        nums.push_back(std::move(v));
+    }
+}
+
+static double mops(double ops, stopwatch const & sw) {
+    return ops / std::max(sw.get_seconds(), 1e-9);
+}
+
+static void bench_mpz(unsigned bits, unsigned reps) {
+    unsynch_mpz_manager m;
+    unsigned const n = 1024;
+    vector<mpz> xs, ys;
+    bench_numbers(m, bits, n, xs);
+    bench_numbers(m, bits, n, ys);
+    scoped_mpz r(m);
+    stopwatch add_sw, mul_sw, div_sw, gcd_sw;
+    add_sw.start();
+    for (unsigned k = 0; k < reps; ++k)
+        for (unsigned i = 0; i < n; ++i)
+            m.add(xs[i], ys[i], r);
+    add_sw.stop();
+    mul_sw.start();
+    for (unsigned k = 0; k < reps; ++k)
+        for (unsigned i = 0; i < n; ++i)
+            m.mul(xs[i], ys[(i + k) % n], r);
+    mul_sw.stop();
+    div_sw.start();
+    for (unsigned k = 0; k < reps; ++k)
+        for (unsigned i = 0; i < n; ++i)
+            m.machine_div(xs[i], ys[(i + k) % n], r);
+    div_sw.stop();
+    gcd_sw.start();
+    for (unsigned k = 0; k < reps; ++k)
+        for (unsigned i = 0; i < n; ++i)
+            m.gcd(xs[i], ys[(i + k) % n], r);
+    gcd_sw.stop();
+    double ops = static_cast<double>(n) * reps / 1e6;
+    std::cout << "mpz " << bits << " bits (Mops/s): add " << mops(ops, add_sw)
+              << ", mul " << mops(ops, mul_sw) << ", div " << mops(ops, div_sw)
+              << ", gcd " << mops(ops, gcd_sw) << "\n";
+    for (mpz & x : xs) m.del(x);
+    for (mpz & y : ys) m.del(y);
+}
+
+static void bench_rational(unsigned bits, unsigned reps) {
+    unsynch_mpz_manager m;
+    unsigned const n = 1024;
+    vector<mpz> xs, ys;
+    bench_numbers(m, bits, n, xs);
+    bench_numbers(m, bits / 2, n, ys);
+    vector<rational> qs;
+    for (unsigned i = 0; i < n; ++i)
+        qs.push_back(rational(m.to_string(xs[i]).c_str()) / rational(m.to_string(ys[i]).c_str()));
+    rational sum, prod(1);
+    stopwatch add_sw, mul_sw;
+    add_sw.start();
+    for (unsigned k = 0; k < reps; ++k)
+        for (unsigned i = 0; i < n; ++i)
+            sum = qs[i] + qs[(i + k) % n];
+    add_sw.stop();
+    mul_sw.start();
+    for (unsigned k = 0; k < reps; ++k)
+        for (unsigned i = 0; i < n; ++i)
+            prod = qs[i] * qs[(i + k) % n];
+    mul_sw.stop();
+    double ops = static_cast<double>(n) * reps / 1e6;
+    std::cout << "rational " << bits << "/" << bits / 2 << " bits (Mops/s): add " << mops(ops, add_sw)
+              << ", mul " << mops(ops, mul_sw) << "\n";
+    for (mpz & x : xs) m.del(x);
+    for (mpz & y : ys) m.del(y);
+}
+
+// test-z3 mpz_bench [repetitions]
+void tst_mpz_bench(char ** argv, int argc, int & i) {
+    unsigned reps = 1000;
+    if (i + 1 < argc && argv[i + 1][0] != '/') {
+        reps = atoi(argv[i + 1]);
+        ++i;
+    }
+    for (unsigned bits : { 30, 48, 62, 96, 160 })
+        bench_mpz(bits, reps);
+    for (unsigned bits : { 30, 48, 62, 96 })
+        bench_rational(bits, reps / 4 + 1);
+}
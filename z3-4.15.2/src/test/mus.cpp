@@ -0,0 +1,123 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    mus.cpp
+
+Abstract:
+
+    Test MUS extraction and MUS/MCS enumeration against brute force.
+
+--*/
+#include "ast/reg_decl_plugins.h"
+#include "solver/solver.h"
+#include "solver/mus.h"
+#include "smt/smt_solver.h"
+#include <algorithm>
+
+static unsigned to_mask(expr_ref_vector const& soft, expr_ref_vector const& s) {
+    unsigned mask = 0;
+    for (expr* e : s) {
+        unsigned i = 0;
+        while (soft.get(i) != e)
+            ++i;
+        mask |= 1u << i;
+    }
+    return mask;
+}
+
+static bool is_sat(solver& s, expr_ref_vector const& soft, unsigned mask) {
+    expr_ref_vector asms(soft.get_manager());
+    for (unsigned i = 0; i < soft.size(); ++i)
+        if (mask & (1u << i))
+            asms.push_back(soft.get(i));
+    lbool r = s.check_sat(asms);
+    ENSURE(r != l_undef);
+    return r == l_true;
+}
+
+static void tst_random(unsigned seed, unsigned num_threads) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    p.set_uint("mus.threads", num_threads);
+    ref<solver> s = mk_smt_solver(m, p, symbol::null);
+    random_gen rand(seed);
+    unsigned const n = 6;
+    expr_ref_vector vars(m), soft(m);
+    for (unsigned i = 0; i < n; ++i)
+        vars.push_back(m.mk_fresh_const("x", m.mk_bool_sort()));
+    auto lit = [&](unsigned i) {
+        expr* v = vars.get(i);
+        return expr_ref(rand(2) ? v : m.mk_not(v), m);
+    };
+    for (unsigned i = 0; i < 4; ++i)
+        s->assert_expr(m.mk_or(lit(rand(n)), lit(rand(n)), lit(rand(n))));
+    for (unsigned i = 0; i < n; ++i)
+        soft.push_back(lit(i));
+
+    unsigned const full = (1u << n) - 1;
+    bool_vector sat(full + 1, false);
+    for (unsigned mask = 0; mask <= full; ++mask)
+        sat[mask] = is_sat(*s, soft, mask);
+    auto is_mus = [&](unsigned mask) {
+        if (sat[mask])
+            return false;
+        for (unsigned i = 0; i < n; ++i)
+            if ((mask & (1u << i)) && !sat[mask & ~(1u << i)])
+                return false;
+        return true;
+    };
+    auto is_mss = [&](unsigned mask) {
+        if (!sat[mask])
+            return false;
+        for (unsigned i = 0; i < n; ++i)
+            if (!(mask & (1u << i)) && sat[mask | (1u << i)])
+                return false;
+        return true;
+    };
+
+    if (!sat[full]) {
+        mus ms(*s);
+        ms.add_soft(soft.size(), soft.data());
+        expr_ref_vector core(m);
+        ENSURE(ms.get_mus(core) == l_true);
+        ENSURE(is_mus(to_mask(soft, core)));
+    }
+
+    mus ms(*s);
+    ms.add_soft(soft.size(), soft.data());
+    vector<expr_ref_vector> muses, mcses;
+    ENSURE(ms.enumerate(0, muses, mcses) == l_true);
+    unsigned_vector found_muses, found_mcses, expected_muses, expected_mcses;
+    for (auto const& e : muses)
+        found_muses.push_back(to_mask(soft, e));
+    for (auto const& e : mcses)
+        found_mcses.push_back(to_mask(soft, e));
+    for (unsigned mask = 0; mask <= full; ++mask) {
+        if (is_mus(mask))
+            expected_muses.push_back(mask);
+        if (is_mss(mask))
+            expected_mcses.push_back(full & ~mask);
+    }
+    std::sort(found_muses.begin(), found_muses.end());
+    std::sort(found_mcses.begin(), found_mcses.end());
+    std::sort(expected_mcses.begin(), expected_mcses.end());
+    ENSURE(found_muses == expected_muses);
+    ENSURE(found_mcses == expected_mcses);
+
+    if (muses.size() + mcses.size() > 1) {
+        mus ms2(*s);
+        ms2.add_soft(soft.size(), soft.data());
+        ENSURE(ms2.enumerate(1, muses, mcses) == l_undef);
+        ENSURE(muses.size() + mcses.size() == 1);
+    }
+}
+
+void tst_mus() {
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        tst_random(seed, 1);
+        tst_random(seed, 4);
+    }
+}
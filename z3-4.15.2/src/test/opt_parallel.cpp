@@ -0,0 +1,63 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    opt_parallel.cpp
+
+Abstract:
+
+    Test the parallel MaxSMT portfolio and box mode against a single thread.
+
+--*/
+#include "ast/reg_decl_plugins.h"
+#include "opt/opt_context.h"
+
+static expr_ref_vector solve(ast_manager& m, expr_ref_vector const& hard, expr_ref_vector const& soft,
+                             unsigned_vector const& weights, unsigned num_objectives, unsigned num_threads, char const* priority) {
+    opt::context ctx(m);
+    params_ref p;
+    p.set_uint("threads", num_threads);
+    p.set_sym("priority", symbol(priority));
+    ctx.updt_params(p);
+    for (expr* h : hard)
+        ctx.add_hard_constraint(h);
+    for (unsigned i = 0; i < soft.size(); ++i)
+        ctx.add_soft_constraint(soft.get(i), rational(weights[i]), symbol(std::to_string(i % num_objectives).c_str()));
+    expr_ref_vector asms(m);
+    ENSURE(ctx.optimize(asms) == l_true);
+    expr_ref_vector r(m);
+    for (unsigned i = 0; i < num_objectives; ++i) {
+        ENSURE(ctx.get_lower(i) == ctx.get_upper(i));
+        r.push_back(ctx.get_lower(i));
+    }
+    return r;
+}
+
+static void tst_random(unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    random_gen rand(seed);
+    unsigned const n = 8;
+    expr_ref_vector vars(m), hard(m), soft(m);
+    unsigned_vector weights;
+    for (unsigned i = 0; i < n; ++i)
+        vars.push_back(m.mk_fresh_const("x", m.mk_bool_sort()));
+    auto lit = [&]() {
+        expr* v = vars.get(rand(n));
+        return expr_ref(rand(2) ? v : m.mk_not(v), m);
+    };
+    for (unsigned i = 0; i < 6; ++i)
+        hard.push_back(m.mk_or(lit(), lit(), lit()));
+    for (unsigned i = 0; i < 12; ++i) {
+        soft.push_back(m.mk_or(lit(), lit()));
+        weights.push_back(1 + rand(4));
+    }
+    ENSURE(solve(m, hard, soft, weights, 1, 1, "lex") == solve(m, hard, soft, weights, 1, 4, "lex"));
+    ENSURE(solve(m, hard, soft, weights, 3, 1, "box") == solve(m, hard, soft, weights, 3, 2, "box"));
+}
+
+void tst_opt_parallel() {
+    for (unsigned seed = 0; seed < 10; ++seed)
+        tst_random(seed);
+}
@@ -0,0 +1,114 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    profiler.cpp
+
+Abstract:
+
+    Test the folded-stack output of the hierarchical profiler.
+
+--*/
+#include "util/profiler.h"
+#include "util/memory_manager.h"
+#include "util/debug.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+
+static char const * g_file = "profiler_test.folded";
+
+static std::map<std::string, unsigned long long> read_profile() {
+    std::map<std::string, unsigned long long> r;
+    std::ifstream in(g_file);
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t sp = line.rfind(' ');
+        ENSURE(sp != std::string::npos);
+        r[line.substr(0, sp)] += std::stoull(line.substr(sp + 1));
+    }
+    return r;
+}
+
+static void pause(unsigned ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static void allocate(unsigned n) {
+    for (unsigned i = 0; i < n; ++i)
+        memory::deallocate(memory::allocate(16));
+}
+
+static void tst_time() {
+    set_profile_file(g_file);
+    ENSURE(is_profiling());
+    for (unsigned i = 0; i < 3; ++i) {
+        scoped_profile outer("outer");
+        pause(2);
+        scoped_profile inner("inner");
+        pause(2);
+    }
+    {
+        scoped_profile outer("outer");
+        // a phase with the same name below itself is a separate path.
+        scoped_profile nested("outer");
+        pause(1);
+    }
+    flush_profile();
+    auto p = read_profile();
+    ENSURE(p.size() == 3);
+    ENSURE(p["outer"] >= 6000);
+    ENSURE(p["outer;inner"] >= 6000);
+    ENSURE(p["outer;outer"] >= 1000);
+    set_profile_file("");
+    ENSURE(!is_profiling());
+}
+
+static void tst_allocations() {
+    set_profile_file(g_file, true);
+    {
+        scoped_profile outer("outer");
+        allocate(100);
+        scoped_profile inner("inner");
+        allocate(1000);
+    }
+    set_profile_file("");
+    auto p = read_profile();
+    ENSURE(p["outer"] >= 100 && p["outer"] < 1000);
+    ENSURE(p["outer;inner"] >= 1000);
+    // phases entered while profiling is off are not recorded.
+    {
+        scoped_profile ignored("ignored");
+        allocate(10);
+    }
+    set_profile_file(g_file, true);
+    set_profile_file("");
+    ENSURE(read_profile().empty());
+}
+
+static void tst_threads() {
+    set_profile_file(g_file, true);
+    {
+        scoped_profile main_phase("main");
+        std::thread t1([]() { scoped_profile w("worker"); allocate(500); });
+        std::thread t2([]() { scoped_profile w("worker"); allocate(500); });
+        t1.join();
+        t2.join();
+    }
+    set_profile_file("");
+    auto p = read_profile();
+    // stacks are per thread: the workers' phases are merged at the top level.
+    ENSURE(p["worker"] >= 1000);
+    ENSURE(p.count("main;worker") == 0);
+}
+
+void tst_profiler() {
+    tst_time();
+    tst_allocations();
+    tst_threads();
+    std::remove(g_file);
+}
@@ -0,0 +1,82 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_log.cpp
+
+Abstract:
+
+    Test the binary quantifier instantiation log on a matching loop.
+
+--*/
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "smt/smt_solver.h"
+#include "smt/qi_log.h"
+#include "solver/solver.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+void tst_qi_log() {
+    // the first log of the process with a given name is written to that file
+    static unsigned num_runs = 0;
+    std::string file_name = "tst_qi_log" + std::to_string(num_runs++) + ".qilog";
+    {
+        ast_manager m;
+        reg_decl_plugins(m);
+        arith_util a(m);
+        sort* int_s = a.mk_int();
+        func_decl_ref f(m.mk_func_decl(symbol("f"), int_s, int_s), m);
+        func_decl_ref g(m.mk_func_decl(symbol("g"), int_s, int_s), m);
+        expr_ref c(m.mk_const("c", int_s), m);
+        expr_ref x(m.mk_var(0, int_s), m);
+        // f(x) < f(g(x)) with pattern f(x) is a matching loop
+        app_ref fx(m.mk_app(f, x.get()), m);
+        expr_ref body(a.mk_lt(fx, m.mk_app(f, m.mk_app(g, x.get()))), m);
+        expr* pat = m.mk_pattern(fx);
+        symbol name("x");
+        expr_ref q(m.mk_forall(1, &int_s, &name, body, 0, symbol("loop"), symbol::null, 1, &pat), m);
+
+        params_ref p;
+        p.set_str("qi.log", file_name.c_str());
+        p.set_uint("qi.max_instances", 20);
+        ref<solver> s = mk_smt_solver(m, p, symbol::null);
+        s->assert_expr(q);
+        s->assert_expr(m.mk_eq(m.mk_app(f, c.get()), a.mk_int(0)));
+        s->check_sat();
+    }
+    std::ifstream in(file_name, std::ios::binary);
+    ENSURE(in.good());
+    smt::qi_log_reader reader(in);
+    smt::qi_log_instance inst;
+    std::unordered_map<unsigned, unsigned> creator;
+    unsigned num_instances = 0, max_depth = 0;
+    unsigned_vector depth;
+    while (reader.next(inst)) {
+        ENSURE(inst.m_bindings.size() == 1);
+        ENSURE(inst.m_source == smt::qi_source::ematching);
+        unsigned d = 1;
+        auto it = creator.find(inst.m_bindings[0]);
+        if (it != creator.end())
+            d = depth[it->second] + 1;
+        depth.push_back(d);
+        max_depth = std::max(max_depth, d);
+        for (unsigned t : inst.m_created)
+            creator[t] = num_instances;
+        ++num_instances;
+    }
+    ENSURE(reader.ok());
+    ENSURE(num_instances > 5);
+    // each instance binds a term created by the previous one
+    ENSURE(max_depth > 5);
+    ENSURE(reader.quantifiers().size() == 1);
+    for (auto const& kv : reader.quantifiers()) {
+        ENSURE(kv.m_value.m_name == "loop");
+        ENSURE(kv.m_value.m_num_decls == 1);
+    }
+    in.close();
+    std::remove(file_name.c_str());
+}
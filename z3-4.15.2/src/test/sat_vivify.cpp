@@ -0,0 +1,140 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_vivify.cpp
+
+Abstract:
+
+    Check that vivification and bounded variable addition preserve
+    satisfiability and models on small CNFs.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "util/util.h"
+#include "util/statistics.h"
+#include <cstring>
+#include <iostream>
+
+typedef vector<sat::literal_vector> cnf_t;
+
+static void mk_random_3cnf(random_gen & r, unsigned num_vars, unsigned num_clauses, cnf_t & cnf) {
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        sat::literal_vector c;
+        for (unsigned j = 0; j < 3; ++j)
+            c.push_back(sat::literal(r(num_vars), r(2) == 0));
+        cnf.push_back(c);
+    }
+}
+
+// pigeon i sits in hole j is variable i*h + j; pairwise at-most-one per hole.
+static void mk_pigeonhole(unsigned n, unsigned h, cnf_t & cnf) {
+    for (unsigned i = 0; i < n; ++i) {
+        sat::literal_vector c;
+        for (unsigned j = 0; j < h; ++j)
+            c.push_back(sat::literal(i * h + j, false));
+        cnf.push_back(c);
+    }
+    for (unsigned j = 0; j < h; ++j)
+        for (unsigned i = 0; i < n; ++i)
+            for (unsigned k = i + 1; k < n; ++k) {
+                sat::literal_vector c;
+                c.push_back(sat::literal(i * h + j, true));
+                c.push_back(sat::literal(k * h + j, true));
+                cnf.push_back(c);
+            }
+}
+
+static unsigned num_vars(cnf_t const & cnf) {
+    unsigned n = 0;
+    for (auto const & c : cnf)
+        for (sat::literal l : c)
+            n = std::max(n, l.var() + 1);
+    return n;
+}
+
+static unsigned get_stat(sat::solver const & s, char const * key) {
+    statistics st;
+    s.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+// solve cnf under p and check the model against the original clauses.
+static lbool solve(cnf_t const & cnf, params_ref const & p, char const * key, unsigned & num) {
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    unsigned n = num_vars(cnf);
+    for (unsigned v = 0; v < n; ++v)
+        s.mk_var();
+    for (auto const & c : cnf)
+        s.mk_clause(c.size(), c.data());
+    lbool r = s.check();
+    if (r == l_true) {
+        sat::model const & mdl = s.get_model();
+        for (auto const & c : cnf) {
+            bool sat = false;
+            for (sat::literal l : c)
+                sat |= mdl[l.var()] == (l.sign() ? l_false : l_true);
+            ENSURE(sat);
+        }
+    }
+    num = get_stat(s, key);
+    return r;
+}
+
+static void check(cnf_t const & cnf, char const * option, char const * key, unsigned & num) {
+    params_ref off, on;
+    // run in-processing early and often, so that the small instances reach it.
+    for (params_ref * p : { &off, &on }) {
+        p->set_uint("next_simplify", 300);
+        p->set_uint("vivify.delay", 0);
+        p->set_uint("bva.delay", 0);
+    }
+    off.set_bool(option, false);
+    on.set_bool(option, true);
+    unsigned dummy;
+    lbool r1 = solve(cnf, off, key, dummy);
+    lbool r2 = solve(cnf, on, key, num);
+    ENSURE(r1 == r2);
+}
+
+void tst_sat_vivify() {
+    random_gen r(0);
+    unsigned num_vivified = 0;
+    for (unsigned i = 0; i < 20; ++i) {
+        cnf_t cnf;
+        mk_random_3cnf(r, 150, 639, cnf);
+        unsigned num = 0;
+        check(cnf, "vivify", "sat vivify clauses", num);
+        num_vivified += num;
+    }
+    std::cout << "vivified clauses: " << num_vivified << "\n";
+    ENSURE(num_vivified > 0);
+}
+
+void tst_sat_bva() {
+    unsigned num_bva_vars = 0;
+    for (unsigned n : { 5, 6, 7 }) {
+        for (unsigned h : { n - 1, n }) {
+            cnf_t cnf;
+            mk_pigeonhole(n, h, cnf);
+            unsigned num = 0;
+            check(cnf, "bva", "sat bva vars", num);
+            num_bva_vars += num;
+        }
+    }
+    random_gen r(1);
+    for (unsigned i = 0; i < 10; ++i) {
+        cnf_t cnf;
+        mk_random_3cnf(r, 40, 160, cnf);
+        unsigned num = 0;
+        check(cnf, "bva", "sat bva vars", num);
+    }
+    std::cout << "bva variables: " << num_bva_vars << "\n";
+    ENSURE(num_bva_vars > 0);
+}
@@ -60,5 +60,29 @@ void tst_simple_parser() {
     TRACE(simple_parser, 
           tout << mk_pp(r, m) << "\n";
           tout << "val: " << eval(r, 2, vals) << "\n";);
+
+    // compiled cost functions agree with the interpreter
+    char const* fmls[] = {
+        "(+ x (* y x))",
+        "(- (* 10 y) x)",
+        "(/ x 4)",
+        "(ite (and (> x 3) (<= y 4)) 2 10)",
+        "(ite (or (> x 3) (<= y 4)) (+ x 1) (- 0 y))",
+        "(ite (implies (< x y) (= x 2)) (/ y x) 7)",
+        "(ite (not (>= x y)) x y)",
+    };
+    float points[4][2] = { { 2.0f, 3.0f }, { 5.0f, 1.0f }, { 0.5f, 0.5f }, { 4.0f, 4.0f } };
+    for (char const* f : fmls) {
+        VERIFY(p.parse_string(f, r));
+        compiled_cost_function c;
+        c.compile(m, r);
+        for (auto const& pt : points)
+            ENSURE(c(2, pt) == eval(r, 2, pt));
+    }
+    // variables are indexed from the end of the arguments, so x = 3 and y = 2
+    VERIFY(p.parse_string("(+ x y x)", r));
+    compiled_cost_function c;
+    c.compile(m, r);
+    ENSURE(c(2, vals) == 8.0f);
 }
 
@@ -0,0 +1,127 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    simplifier_solver.cpp
+
+Abstract:
+
+    Test incremental pre-processing across push and pop.
+
+--*/
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "solver/solver.h"
+#include "solver/simplifier_solver.h"
+#include "smt/smt_solver.h"
+#include "util/stopwatch.h"
+#include <iostream>
+
+static ref<solver> mk_solver(ast_manager& m, bool incremental) {
+    params_ref p;
+    p.set_bool("preprocess.incremental", incremental);
+    ref<solver> s = mk_simplifier_solver(mk_smt_solver(m, p, symbol::null), nullptr);
+    s->updt_params(p);
+    return s;
+}
+
+// x0 = 0, x1 = x0 + 1, ..., x{n-1} = x{n-2} + 1 is eliminated by solve-eqs
+static void mk_chain(ast_manager& m, unsigned n, expr_ref_vector& xs, expr_ref_vector& fmls) {
+    arith_util a(m);
+    for (unsigned i = 0; i < n; ++i)
+        xs.push_back(m.mk_fresh_const("x", a.mk_int()));
+    fmls.push_back(m.mk_eq(xs.get(0), a.mk_int(0)));
+    for (unsigned i = 1; i < n; ++i)
+        fmls.push_back(m.mk_eq(xs.get(i), a.mk_add(xs.get(i - 1), a.mk_int(1))));
+}
+
+static void tst_scopes(bool incremental) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    ref<solver> s = mk_solver(m, incremental);
+    ref<solver> r = mk_smt_solver(m, params_ref(), symbol::null);
+    expr_ref_vector xs(m), fmls(m);
+    mk_chain(m, 10, xs, fmls);
+    for (expr* f : fmls) {
+        s->assert_expr(f);
+        r->assert_expr(f);
+    }
+    ENSURE(s->check_sat() == l_true);
+    random_gen rand(incremental ? 1 : 2);
+    for (unsigned round = 0; round < 200; ++round) {
+        unsigned depth = 1 + rand(3);
+        for (unsigned d = 0; d < depth; ++d) {
+            s->push();
+            r->push();
+            unsigned i = rand(xs.size());
+            expr_ref f(rand(2) ? a.mk_le(xs.get(i), a.mk_int(rand(12))) : a.mk_ge(xs.get(i), a.mk_int(rand(12))), m);
+            s->assert_expr(f);
+            r->assert_expr(f);
+            lbool res = s->check_sat();
+            ENSURE(res == r->check_sat());
+            if (res == l_true) {
+                model_ref mdl;
+                s->get_model(mdl);
+                for (expr* g : fmls)
+                    ENSURE(mdl->is_true(g));
+                ENSURE(mdl->is_true(f));
+            }
+        }
+        s->pop(depth);
+        r->pop(depth);
+    }
+    // the eliminated equations are restored after pop.
+    s->push();
+    s->assert_expr(a.mk_le(xs.get(9), a.mk_int(8)));
+    ENSURE(s->check_sat() == l_false);
+    s->pop(1);
+    s->assert_expr(a.mk_ge(xs.get(5), a.mk_int(6)));
+    ENSURE(s->check_sat() == l_false);
+}
+
+void tst_simplifier_solver() {
+    tst_scopes(true);
+    tst_scopes(false);
+}
+
+static double bench_scopes(unsigned n, unsigned num_scopes, bool incremental) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    ref<solver> s = mk_solver(m, incremental);
+    expr_ref_vector xs(m), fmls(m);
+    mk_chain(m, n, xs, fmls);
+    for (expr* f : fmls)
+        s->assert_expr(f);
+    VERIFY(s->check_sat() == l_true);
+    random_gen rand(0);
+    stopwatch sw;
+    sw.start();
+    for (unsigned i = 0; i < num_scopes; ++i) {
+        s->push();
+        s->assert_expr(a.mk_le(xs.get(rand(n)), a.mk_int(rand(2 * n))));
+        s->check_sat();
+        s->pop(1);
+    }
+    sw.stop();
+    return sw.get_seconds();
+}
+
+void tst_simplifier_solver_bench(char** argv, int argc, int& i) {
+    unsigned n = 1000, num_scopes = 10000;
+    if (i + 1 < argc && argv[i + 1][0] != '/') {
+        n = atoi(argv[i + 1]);
+        ++i;
+    }
+    if (i + 1 < argc && argv[i + 1][0] != '/') {
+        num_scopes = atoi(argv[i + 1]);
+        ++i;
+    }
+    for (bool incremental : { false, true }) {
+        double t = bench_scopes(n, num_scopes, incremental);
+        std::cout << "vars: " << n << " scopes: " << num_scopes << (incremental ? " incremental" : " replay-all")
+                  << " time: " << t << "s latency: " << 1000000 * t / num_scopes << "us\n";
+    }
+}
@@ -0,0 +1,212 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt2_scanner.cpp
+
+Abstract:
+
+    Test the in-memory SMT-LIB2 scanner against the stream based scanner
+    and measure parser throughput on stream and memory mapped input.
+
+    test-z3 smt2_parse_bench [file-or-directory] [repetitions]
+
+--*/
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "util/mapped_file.h"
+#include "util/stopwatch.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2scanner.h"
+#include "parsers/smt2/smt2parser.h"
+
+static void check_same_tokens(char const* input) {
+    cmd_context ctx;
+    std::istringstream in(input);
+    smt2::scanner s1(ctx, in);
+    smt2::scanner s2(ctx, input, input + strlen(input));
+    while (true) {
+        smt2::scanner::token t1 = s1.scan();
+        smt2::scanner::token t2 = s2.scan();
+        ENSURE(t1 == t2);
+        ENSURE(s1.get_line() == s2.get_line());
+        ENSURE(s1.get_pos() == s2.get_pos());
+        switch (t1) {
+        case smt2::scanner::SYMBOL_TOKEN:
+        case smt2::scanner::KEYWORD_TOKEN:
+            ENSURE(s1.get_id() == s2.get_id());
+            break;
+        case smt2::scanner::STRING_TOKEN:
+            ENSURE(strcmp(s1.get_string(), s2.get_string()) == 0);
+            break;
+        case smt2::scanner::INT_TOKEN:
+        case smt2::scanner::FLOAT_TOKEN:
+            ENSURE(s1.get_number() == s2.get_number());
+            break;
+        case smt2::scanner::BV_TOKEN:
+            ENSURE(s1.get_number() == s2.get_number());
+            ENSURE(s1.get_bv_size() == s2.get_bv_size());
+            break;
+        default:
+            break;
+        }
+        if (t1 == smt2::scanner::EOF_TOKEN)
+            break;
+    }
+}
+
+static void check_number(char const* input, rational const& expected, unsigned bv_size = UINT_MAX) {
+    cmd_context ctx;
+    smt2::scanner s(ctx, input, input + strlen(input));
+    s.scan();
+    ENSURE(s.get_number() == expected);
+    ENSURE(bv_size == UINT_MAX || s.get_bv_size() == bv_size);
+}
+
+// the parser reports the same error positions for stream and in-memory input.
+static void check_same_errors(char const* input) {
+    std::string msgs[2];
+    for (unsigned k = 0; k < 2; ++k) {
+        cmd_context ctx;
+        std::ostringstream out;
+        ctx.set_regular_stream(out);
+        ctx.set_diagnostic_stream(out);
+        std::istringstream in(input);
+        if (k == 0)
+            parse_smt2_commands(ctx, in);
+        else
+            parse_smt2_commands(ctx, input, input + strlen(input));
+        msgs[k] = out.str();
+    }
+    ENSURE(msgs[0].find("(error \"line ") != std::string::npos);
+    ENSURE(msgs[0] == msgs[1]);
+}
+
+void tst_smt2_scanner() {
+    check_same_tokens("(declare-fun x () Int) ; comment\n(assert (> x 10))");
+    check_same_tokens("(assert (= #x00fF #b0101)) (check-sat)");
+    check_same_tokens("(set-info :status sat)\n\t(echo \"a \"\"quoted\"\" string\")\r\n");
+    check_same_tokens("|quoted symbol| |multi\nline| x!1 a.b$c ; comment at end");
+    check_same_tokens("1.5 0.125 123456789012345678901234567890 12345678901234567890.0987654321");
+    check_same_tokens("#x0123456789abcdef0123456789ABCDEF #b1111111111111111111111111111111111111111111111111111111111111111101");
+    check_same_tokens("#| block\n comment |# (push 1) - -1 -x");
+    check_same_tokens("symbol-at-eof");
+    check_same_tokens("42");
+
+    check_number("123456789012345678901234567890", rational("123456789012345678901234567890"));
+    check_number("0.0625", rational(1, 16));
+    check_number("#xffffffffffffffffff", rational::power_of_two(72) - rational(1), 72);
+    check_number("#b10000000000000000000000000000000000000000000000000000000000000000", rational::power_of_two(64), 65);
+
+    check_same_errors("(assert undeclared)");
+    check_same_errors("(declare-const x Int) (assert (> x y))");
+    check_same_errors("(check-sat)\n  (assert (= 1 z))");
+}
+
+static void collect_smt2_files(char const* path, std::vector<std::string>& files) {
+    std::error_code ec;
+    if (std::filesystem::is_directory(path, ec)) {
+        for (auto const& e : std::filesystem::recursive_directory_iterator(path, ec))
+            if (e.is_regular_file() && e.path().extension() == ".smt2")
+                files.push_back(e.path().string());
+    }
+    else if (std::filesystem::is_regular_file(path, ec)) {
+        files.push_back(path);
+    }
+}
+
+static unsigned scan_all(smt2::scanner& s) {
+    unsigned num_tokens = 0;
+    try {
+        while (s.scan() != smt2::scanner::EOF_TOKEN)
+            ++num_tokens;
+    }
+    catch (smt2::scanner_exception& ex) {
+        std::cout << "scanner error: " << ex.what() << "\n";
+    }
+    return num_tokens;
+}
+
+static void parse_all(cmd_context& ctx, char const* begin, char const* end, std::istream* in) {
+    std::ostringstream out;
+    ctx.set_regular_stream(out);
+    ctx.set_diagnostic_stream(out);
+    ctx.set_ignore_check(true);
+    if (in)
+        parse_smt2_commands(ctx, *in);
+    else
+        parse_smt2_commands(ctx, begin, end);
+}
+
+static void display_rate(char const* what, double bytes, double secs) {
+    std::cout << "  " << what << ": " << secs << "s";
+    if (secs > 0)
+        std::cout << " " << (bytes / (1024.0 * 1024.0)) / secs << " MB/s";
+    std::cout << "\n";
+}
+
+void tst_smt2_parse_bench(char** argv, int argc, int& i) {
+    char const* path = "../examples/SMT-LIB2";
+    unsigned reps = 10;
+    if (i + 1 < argc && argv[i + 1][0] != '/') {
+        path = argv[i + 1];
+        ++i;
+    }
+    if (i + 1 < argc && argv[i + 1][0] != '/') {
+        reps = atoi(argv[i + 1]);
+        ++i;
+    }
+    std::vector<std::string> files;
+    collect_smt2_files(path, files);
+    if (files.empty()) {
+        std::cout << "no .smt2 files found in " << path << "\n";
+        return;
+    }
+
+    double total_bytes = 0;
+    stopwatch scan_stream, scan_mapped, parse_stream, parse_mapped;
+    for (std::string const& f : files) {
+        mapped_file mf;
+        if (!mf.open(f.c_str()))
+            continue;
+        total_bytes += static_cast<double>(mf.size()) * reps;
+        for (unsigned r = 0; r < reps; ++r) {
+            cmd_context ctx;
+            unsigned n1, n2;
+            {
+                std::ifstream in(f);
+                scoped_watch _w(scan_stream);
+                smt2::scanner s(ctx, in);
+                n1 = scan_all(s);
+            }
+            {
+                scoped_watch _w(scan_mapped);
+                smt2::scanner s(ctx, mf.begin(), mf.end());
+                n2 = scan_all(s);
+            }
+            ENSURE(n1 == n2);
+        }
+        for (unsigned r = 0; r < reps; ++r) {
+            {
+                cmd_context ctx;
+                std::ifstream in(f);
+                scoped_watch _w(parse_stream);
+                parse_all(ctx, nullptr, nullptr, &in);
+            }
+            {
+                cmd_context ctx;
+                scoped_watch _w(parse_mapped);
+                parse_all(ctx, mf.begin(), mf.end(), nullptr);
+            }
+        }
+    }
+    std::cout << files.size() << " files, " << total_bytes / reps << " bytes, " << reps << " repetitions\n";
+    display_rate("scan stream", total_bytes, scan_stream.get_seconds());
+    display_rate("scan mapped", total_bytes, scan_mapped.get_seconds());
+    display_rate("parse stream", total_bytes, parse_stream.get_seconds());
+    display_rate("parse mapped", total_bytes, parse_mapped.get_seconds());
+}
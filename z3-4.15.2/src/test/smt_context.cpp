@@ -6,8 +6,10 @@ Copyright (c) 2015 Microsoft Corporation
 
 #include "smt/smt_context.h"
 #include "ast/reg_decl_plugins.h"
+#include <cstring>
+#include <string>
 
-void tst_smt_context()
+static void tst_basic()
 {
     smt_params params;
 
@@ -35,3 +37,59 @@ void tst_smt_context()
 
     ctx.check();
 }
+
+// p(i, j): pigeon i sits in hole j. Every pigeon sits in a hole, no hole holds two pigeons.
+static void mk_pigeonhole(ast_manager & m, unsigned n, unsigned h, expr * guard, expr_ref_vector & fmls) {
+    expr_ref_vector p(m);
+    for (unsigned i = 0; i < n; ++i)
+        for (unsigned j = 0; j < h; ++j)
+            p.push_back(m.mk_const(symbol(("p" + std::to_string(i) + "_" + std::to_string(j)).c_str()), m.mk_bool_sort()));
+    for (unsigned i = 0; i < n; ++i) {
+        expr_ref_vector holes(m);
+        for (unsigned j = 0; j < h; ++j)
+            holes.push_back(p.get(i * h + j));
+        fmls.push_back(m.mk_implies(guard, m.mk_or(holes)));
+    }
+    for (unsigned j = 0; j < h; ++j)
+        for (unsigned i = 0; i < n; ++i)
+            for (unsigned k = i + 1; k < n; ++k)
+                fmls.push_back(m.mk_or(m.mk_not(p.get(i * h + j)), m.mk_not(p.get(k * h + j))));
+}
+
+static void tst_cube_and_conquer(unsigned n, unsigned h, lbool expected) {
+    smt_params params;
+    params.m_threads = 4;
+    params.m_threads_cube_and_conquer = true;
+    params.m_threads_max_conflicts = 20;
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt::context ctx(m, params);
+    expr_ref guard(m.mk_const(symbol("guard"), m.mk_bool_sort()), m);
+    expr_ref_vector fmls(m);
+    mk_pigeonhole(m, n, h, guard, fmls);
+    for (expr * f : fmls)
+        ctx.assert_expr(f);
+    expr * asms[1] = { guard.get() };
+    lbool r = ctx.check(1, asms);
+    ENSURE(r == expected);
+    if (r == l_false) {
+        // the instance is hard enough to leave the sequential warm-up.
+        statistics st;
+        ctx.collect_statistics(st);
+        bool has_cubes = false;
+        for (unsigned i = 0; i < st.size(); ++i)
+            if (strcmp(st.get_key(i), "parallel cubes solved") == 0)
+                has_cubes = st.get_uint_value(i) > 0;
+        ENSURE(has_cubes);
+    }
+    if (r == l_false)
+        ENSURE(ctx.get_unsat_core_size() == 1 && ctx.get_unsat_core_expr(0) == guard);
+    // the context remains usable after the parallel search.
+    ENSURE(ctx.check() == l_true);
+}
+
+void tst_smt_context() {
+    tst_basic();
+    tst_cube_and_conquer(7, 6, l_false);
+    tst_cube_and_conquer(6, 6, l_true);
+}
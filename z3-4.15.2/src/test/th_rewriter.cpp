@@ -0,0 +1,137 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    th_rewriter.cpp
+
+Abstract:
+
+    Test the rewrite cache that th_rewriter keeps across calls.
+
+--*/
+#include <cstring>
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "util/gparams.h"
+#include "util/statistics.h"
+
+static unsigned get_stat(th_rewriter const & rw, char const * key) {
+    statistics st;
+    rw.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static params_ref cache_params(unsigned max_size) {
+    params_ref p;
+    p.set_uint("persistent_cache", max_size);
+    return p;
+}
+
+// (x_i + 0) * 1 + i <= x_{i+1} + (2 * 3), sharing the left hand sides.
+static void mk_atoms(ast_manager & m, unsigned n, expr_ref_vector & atoms) {
+    arith_util a(m);
+    expr_ref_vector xs(m);
+    for (unsigned i = 0; i <= n; ++i)
+        xs.push_back(m.mk_const(symbol(("x" + std::to_string(i)).c_str()), a.mk_int()));
+    for (unsigned i = 0; i < n; ++i) {
+        expr_ref lhs(a.mk_add(a.mk_mul(a.mk_add(xs.get(i), a.mk_int(0)), a.mk_int(1)), a.mk_int(i)), m);
+        expr_ref rhs(a.mk_add(xs.get(i + 1), a.mk_mul(a.mk_int(2), a.mk_int(3))), m);
+        atoms.push_back(a.mk_le(lhs, rhs));
+        atoms.push_back(m.mk_not(a.mk_ge(lhs, rhs)));
+    }
+}
+
+static void tst_same_results() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector atoms(m);
+    mk_atoms(m, 200, atoms);
+    th_rewriter plain(m), cached(m, cache_params(100000));
+    expr_ref r1(m), r2(m);
+    for (unsigned round = 0; round < 3; ++round) {
+        for (expr * e : atoms) {
+            plain(e, r1);
+            cached(e, r2);
+            ENSURE(r1 == r2);
+            // the reset between calls does not clear the persistent cache.
+            cached.reset();
+        }
+    }
+    ENSURE(get_stat(cached, "rewriter cache hits") >= 2 * atoms.size());
+    ENSURE(get_stat(plain, "rewriter cache hits") == 0);
+}
+
+static void tst_params_fingerprint() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref e(m.mk_eq(a.mk_add(x, a.mk_int(1)), a.mk_int(3)), m);
+    th_rewriter rw(m, cache_params(100000));
+    expr_ref r1(m), r2(m);
+    rw(e, r1);
+    ENSURE(get_stat(rw, "rewriter cache hits") == 0);
+    // results computed under other parameters are not reused.
+    params_ref p = cache_params(100000);
+    p.set_bool("arith_lhs", true);
+    rw.updt_params(p);
+    th_rewriter ref(m, p);
+    rw(e, r1);
+    ref(e, r2);
+    ENSURE(r1 == r2);
+    ENSURE(get_stat(rw, "rewriter cache hits") == 0);
+    rw(e, r1);
+    ENSURE(r1 == r2);
+    ENSURE(get_stat(rw, "rewriter cache hits") > 0);
+}
+
+static void tst_global_params_fingerprint() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref e(m.mk_eq(a.mk_add(x, a.mk_int(1)), a.mk_int(3)), m);
+    th_rewriter rw(m, cache_params(100000));
+    expr_ref r1(m), r2(m);
+    rw(e, r1);
+    // a global rewriter parameter changes the configuration as well.
+    gparams::set("rewriter.arith_lhs", "true");
+    rw.updt_params(params_ref());
+    th_rewriter ref(m, cache_params(0));
+    rw(e, r1);
+    ref(e, r2);
+    gparams::reset();
+    ENSURE(r1 == r2);
+    ENSURE(get_stat(rw, "rewriter cache hits") == 0);
+}
+
+static void tst_eviction() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector atoms(m);
+    mk_atoms(m, 20000, atoms);
+    th_rewriter rw(m, cache_params(1000));
+    expr_ref r(m);
+    for (expr * e : atoms)
+        rw(e, r);
+    unsigned size = get_stat(rw, "rewriter cache size");
+    ENSURE(size == 1000);
+    ENSURE(get_stat(rw, "rewriter cache evictions") > 0);
+    // disabling the cache releases the entries.
+    unsigned num_asts = m.get_num_asts();
+    rw.updt_params(cache_params(0));
+    ENSURE(m.get_num_asts() < num_asts);
+    ENSURE(get_stat(rw, "rewriter cache size") == 0);
+}
+
+void tst_th_rewriter() {
+    tst_same_results();
+    tst_params_fingerprint();
+    tst_global_params_fingerprint();
+    tst_eviction();
+}
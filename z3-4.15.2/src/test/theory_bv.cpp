@@ -0,0 +1,122 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    theory_bv.cpp
+
+Abstract:
+
+    Test lazy bit-blasting of multiplication and division in theory_bv.
+
+--*/
+#include <cstring>
+#include "ast/reg_decl_plugins.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/ast_pp.h"
+#include "smt/smt_context.h"
+#include "model/model.h"
+#include "util/statistics.h"
+#include <iostream>
+
+static unsigned get_stat(smt::context & ctx, char const * key) {
+    statistics st;
+    ctx.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static lbool check(ast_manager & m, expr * fml, bool lazy, unsigned & num_blasted, unsigned & num_unblasted) {
+    smt_params params;
+    params.m_model = true;
+    params.m_bv_lazy_blast = lazy;
+    // keep the solver from folding the operators away before theory_bv sees them.
+    params.m_preprocess = false;
+    smt::context ctx(m, params);
+    ctx.assert_expr(fml);
+    lbool r = ctx.check();
+    if (r == l_true) {
+        model_ref mdl;
+        ctx.get_model(mdl);
+        if (!mdl->is_true(fml)) {
+            std::cout << mk_pp(fml, m) << "\n" << *mdl << "\n";
+            ENSURE(false);
+        }
+    }
+    num_blasted = get_stat(ctx, "bv lazy blasted");
+    num_unblasted = get_stat(ctx, "bv lazy unblasted");
+    return r;
+}
+
+static void tst_lazy_counters() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    expr_ref x(m.mk_const(symbol("x"), bv.mk_sort(16)), m);
+    expr_ref y(m.mk_const(symbol("y"), bv.mk_sort(16)), m);
+    expr_ref one(bv.mk_numeral(rational(1), 16), m);
+    expr_ref zero(bv.mk_numeral(rational(0), 16), m);
+    unsigned b, u;
+    // x = 0 and x*y = 0 and y%x = y are satisfied by the cheap axioms alone.
+    expr_ref_vector fmls(m);
+    fmls.push_back(m.mk_eq(x, zero));
+    fmls.push_back(m.mk_eq(bv.mk_bv_mul(x, y), zero));
+    fmls.push_back(m.mk_eq(bv.mk_bv_urem_i(y, x), y));
+    expr_ref fml(m.mk_and(fmls), m);
+    ENSURE(check(m, fml, true, b, u) == l_true);
+    ENSURE(b == 0 && u == 2);
+    // factoring 143 requires the multiplier circuit.
+    fmls.reset();
+    fmls.push_back(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(rational(143), 16)));
+    fmls.push_back(m.mk_not(m.mk_eq(x, one)));
+    fmls.push_back(m.mk_not(m.mk_eq(y, one)));
+    fmls.push_back(bv.mk_ule(x, bv.mk_numeral(rational(255), 16)));
+    fmls.push_back(bv.mk_ule(y, bv.mk_numeral(rational(255), 16)));
+    fml = m.mk_and(fmls);
+    ENSURE(check(m, fml, true, b, u) == l_true);
+    ENSURE(b == 1 && u == 0);
+    ENSURE(check(m, fml, false, b, u) == l_true);
+    ENSURE(b == 0 && u == 0);
+}
+
+static void tst_lazy_random(unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    random_gen rand(seed);
+    expr_ref_vector vars(m), terms(m), fmls(m);
+    for (char const * n : { "x", "y", "z" })
+        vars.push_back(m.mk_const(symbol(n), bv.mk_sort(6)));
+    auto pick = [&](expr_ref_vector const & v) { return v.get(rand(v.size())); };
+    terms.append(vars);
+    for (unsigned i = 0; i < 6; ++i) {
+        expr * a = pick(terms), * b = pick(terms);
+        switch (rand(4)) {
+        case 0: terms.push_back(bv.mk_bv_mul(a, b)); break;
+        case 1: terms.push_back(bv.mk_bv_udiv_i(a, b)); break;
+        case 2: terms.push_back(bv.mk_bv_urem_i(a, b)); break;
+        default: terms.push_back(bv.mk_bv_add(a, b)); break;
+        }
+    }
+    for (unsigned i = 0; i < 3; ++i) {
+        expr * a = pick(terms);
+        expr * b = rand(2) ? pick(terms) : bv.mk_numeral(rational(rand(64)), 6);
+        fmls.push_back(rand(3) ? m.mk_eq(a, b) : bv.mk_ule(a, b));
+    }
+    expr_ref fml(m.mk_and(fmls), m);
+    unsigned b, u;
+    lbool r1 = check(m, fml, false, b, u);
+    lbool r2 = check(m, fml, true, b, u);
+    if (r1 != r2) {
+        std::cout << mk_pp(fml, m) << "\n" << r1 << " " << r2 << "\n";
+        ENSURE(false);
+    }
+}
+
+void tst_theory_bv() {
+    tst_lazy_counters();
+    for (unsigned seed = 0; seed < 200; ++seed)
+        tst_lazy_random(seed);
+}
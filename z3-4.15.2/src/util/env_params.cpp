@@ -21,6 +21,7 @@ Notes:
 #include "util/gparams.h"
 #include "util/util.h"
 #include "util/memory_manager.h"
+#include "util/profiler.h"
 
 void env_params::updt_params() {
     params_ref const& p = gparams::get_ref();
@@ -32,6 +33,8 @@ void env_params::updt_params() {
     unsigned mb = p.get_uint("memory_high_watermark_mb", 0);
     if (mb > 0)
         memory::set_high_watermark(megabytes_to_bytes(mb));    
+    params_ref prof = gparams::get_module("profile");
+    set_profile_file(prof.get_str("file", ""), prof.get_bool("allocations", false));
 }
 
 void env_params::collect_param_descrs(param_descrs & d) {
@@ -42,3 +45,8 @@ void env_params::collect_param_descrs(param_descrs & d) {
     d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in bytes), if 0 then there is no limit", "0");
     d.insert("memory_high_watermark_mb", CPK_UINT, "set high watermark for memory consumption (in megabytes), if 0 then there is no limit", "0");
 }
+
+void env_params::collect_profile_param_descrs(param_descrs & d) {
+    d.insert("file", CPK_STRING, "write a profile of nested solver phases in folded-stack format, usable by flamegraph tools, to the given file; profiling is off if it is empty", "");
+    d.insert("allocations", CPK_BOOL, "weight the profile by allocation counts instead of time (in microseconds)", "false");
+}
@@ -23,8 +23,11 @@ class param_descrs;
 struct env_params {
     static void updt_params();
     static void collect_param_descrs(param_descrs & p);
+    static void collect_profile_param_descrs(param_descrs & p);
     /*
       REG_PARAMS('env_params::collect_param_descrs')
+      REG_MODULE_PARAMS('profile', 'env_params::collect_profile_param_descrs')
+      REG_MODULE_DESCRIPTION('profile', 'hierarchical profiling of solver phases')
     */
 };
 
@@ -0,0 +1,116 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    mapped_file.cpp
+
+Abstract:
+
+    Read-only memory mapped view of a file.
+
+--*/
+#include "util/mapped_file.h"
+
+#ifdef _WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static char const s_empty[1] = { 0 };
+
+#ifdef _WINDOWS
+
+bool mapped_file::open(char const * path) {
+    close();
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        m_data = s_empty;
+        m_size = 0;
+        return true;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void * data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file    = file;
+    m_mapping = mapping;
+    m_data    = static_cast<char const *>(data);
+    m_size    = static_cast<size_t>(size.QuadPart);
+    m_mapped  = true;
+    return true;
+}
+
+void mapped_file::close() {
+    if (m_mapped) {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+        CloseHandle(m_file);
+    }
+    m_file    = nullptr;
+    m_mapping = nullptr;
+    m_data    = nullptr;
+    m_size    = 0;
+    m_mapped  = false;
+}
+
+#else
+
+bool mapped_file::open(char const * path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        m_data = s_empty;
+        m_size = 0;
+        return true;
+    }
+    void * data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed.
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+#ifdef MADV_SEQUENTIAL
+    madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+#endif
+    m_data   = static_cast<char const *>(data);
+    m_size   = static_cast<size_t>(st.st_size);
+    m_mapped = true;
+    return true;
+}
+
+void mapped_file::close() {
+    if (m_mapped)
+        munmap(const_cast<char *>(m_data), m_size);
+    m_data   = nullptr;
+    m_size   = 0;
+    m_mapped = false;
+}
+
+#endif
@@ -0,0 +1,43 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    mapped_file.h
+
+Abstract:
+
+    Read-only memory mapped view of a file.
+
+    The contents are exposed as a contiguous range [begin(), end()).
+    Where the platform does not support mapping the file (pipes,
+    character devices), open() fails and callers are expected to fall
+    back to stream based input.
+
+--*/
+#pragma once
+
+#include <cstddef>
+
+class mapped_file {
+    char const * m_data = nullptr;
+    size_t       m_size = 0;
+    bool         m_mapped = false;
+#ifdef _WINDOWS
+    void *       m_file = nullptr;
+    void *       m_mapping = nullptr;
+#endif
+public:
+    mapped_file() = default;
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+    ~mapped_file() { close(); }
+
+    bool open(char const * path);
+    void close();
+
+    bool is_open() const { return m_data != nullptr; }
+    char const * begin() const { return m_data; }
+    char const * end() const { return m_data + m_size; }
+    size_t size() const { return m_size; }
+};
@@ -7,6 +7,7 @@ Copyright (c) 2015 Microsoft Corporation
 #include<iostream>
 #include<stdlib.h>
 #include<climits>
+#include<cstring>
 #include "util/mutex.h"
 #include "util/trace.h"
 #include "util/memory_manager.h"
@@ -248,6 +249,10 @@ void * memory::allocate(char const* file, int line, char const* obj, size_t s) {
 thread_local long long g_memory_thread_alloc_size    = 0;
 thread_local long long g_memory_thread_alloc_count   = 0;
 
+unsigned long long memory::get_thread_allocation_count() {
+    return g_memory_thread_alloc_count;
+}
+
 static void synchronize_counters(bool allocating) {
 #ifdef PROFILE_MEMORY
     g_synch_counter++;
@@ -275,6 +280,217 @@ static void synchronize_counters(bool allocating) {
     }
 }
 
+#ifdef Z3_SHARDED_ALLOCATOR
+// ==================================
+// SHARDED ALLOCATOR
+// ==================================
+// Small blocks are served from per-thread free lists, one per size class.
+// Every block starts with a header that records its usable size and the heap that owns it.
+// A block freed by a thread other than its owner is pushed onto the owner's
+// lock-free remote list, which the owner drains when one of its free lists runs empty.
+// Heaps of terminated threads are parked and adopted by new threads.
+// Chunks backing small blocks are retained for the lifetime of the process.
+// Large blocks go directly to the system allocator.
+
+#define SHARDED_GRANULARITY  16
+#define SHARDED_MAX_SMALL    1024
+#define SHARDED_NUM_CLASSES  (SHARDED_MAX_SMALL / SHARDED_GRANULARITY)
+#define SHARDED_CHUNK_SIZE   (64 * 1024)
+
+namespace {
+
+    struct thread_heap;
+
+    struct block_header {
+        thread_heap* m_heap;    // owning heap, nullptr for large blocks
+        size_t       m_size;    // usable size of the block
+    };
+
+    static_assert(sizeof(block_header) == SHARDED_GRANULARITY, "block header must preserve alignment");
+
+    inline block_header* get_header(void* p) { return static_cast<block_header*>(p) - 1; }
+    inline void*& next_block(void* p) { return *static_cast<void**>(p); }
+    inline unsigned size_class(size_t s) { return s == 0 ? 0 : static_cast<unsigned>((s - 1) / SHARDED_GRANULARITY); }
+
+    struct thread_heap {
+        void*              m_free[SHARDED_NUM_CLASSES] = {};   // accessed only by the owning thread
+        std::atomic<void*> m_remote { nullptr };               // blocks released by other threads
+        char*              m_chunk_pos { nullptr };
+        char*              m_chunk_end { nullptr };
+        thread_heap*       m_next_parked { nullptr };
+
+        void remote_free(void* p) {
+            void* head = m_remote.load(std::memory_order_relaxed);
+            do {
+                next_block(p) = head;
+            }
+            while (!m_remote.compare_exchange_weak(head, p, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        void drain_remote() {
+            void* p = m_remote.exchange(nullptr, std::memory_order_acquire);
+            while (p) {
+                void* n = next_block(p);
+                unsigned c = size_class(get_header(p)->m_size);
+                next_block(p) = m_free[c];
+                m_free[c] = p;
+                p = n;
+            }
+        }
+
+        void* carve(unsigned c) {
+            size_t block_size = sizeof(block_header) + (c + 1) * SHARDED_GRANULARITY;
+            if (m_chunk_pos + block_size > m_chunk_end) {
+                char* chunk = static_cast<char*>(malloc(SHARDED_CHUNK_SIZE));
+                if (!chunk)
+                    return nullptr;
+                m_chunk_pos = chunk;
+                m_chunk_end = chunk + SHARDED_CHUNK_SIZE;
+            }
+            block_header* h = reinterpret_cast<block_header*>(m_chunk_pos);
+            m_chunk_pos += block_size;
+            h->m_heap = this;
+            h->m_size = (c + 1) * SHARDED_GRANULARITY;
+            return h + 1;
+        }
+
+        void* allocate(unsigned c) {
+            void* r = m_free[c];
+            if (!r) {
+                drain_remote();
+                r = m_free[c];
+            }
+            if (!r) 
+                return carve(c);
+            m_free[c] = next_block(r);
+            return r;
+        }
+
+        void deallocate(void* p, unsigned c) {
+            next_block(p) = m_free[c];
+            m_free[c] = p;
+        }
+    };
+
+    static mutex         g_parked_heaps_mux;
+    static thread_heap*  g_parked_heaps = nullptr;
+
+    // heap of the current thread, released to the parked list when the thread exits.
+    thread_local thread_heap* g_thread_heap = nullptr;
+    thread_local bool         g_thread_heap_released = false;
+
+    struct thread_heap_releaser {
+        ~thread_heap_releaser() {
+            if (!g_thread_heap)
+                return;
+            lock_guard lock(g_parked_heaps_mux);
+            g_thread_heap->m_next_parked = g_parked_heaps;
+            g_parked_heaps = g_thread_heap;
+            g_thread_heap = nullptr;
+            g_thread_heap_released = true;
+        }
+    };
+    thread_local thread_heap_releaser g_thread_heap_releaser;
+
+    thread_heap* get_thread_heap() {
+        if (g_thread_heap || g_thread_heap_released)
+            return g_thread_heap;
+        {
+            lock_guard lock(g_parked_heaps_mux);
+            if (g_parked_heaps) {
+                g_thread_heap = g_parked_heaps;
+                g_parked_heaps = g_parked_heaps->m_next_parked;
+                g_thread_heap->m_next_parked = nullptr;
+            }
+        }
+        if (!g_thread_heap) {
+            void* mem = malloc(sizeof(thread_heap));
+            if (!mem)
+                return nullptr;
+            g_thread_heap = new (mem) thread_heap();
+        }
+        // the first use of the thread local releaser registers its destructor.
+        (void)&g_thread_heap_releaser;
+        return g_thread_heap;
+    }
+
+    void* sharded_malloc(size_t s) {
+        if (s <= SHARDED_MAX_SMALL) {
+            thread_heap* h = get_thread_heap();
+            if (h)
+                return h->allocate(size_class(s));
+        }
+        block_header* h = static_cast<block_header*>(malloc(sizeof(block_header) + s));
+        if (!h)
+            return nullptr;
+        h->m_heap = nullptr;
+        h->m_size = s;
+        return h + 1;
+    }
+
+    void sharded_free(void* p) {
+        block_header* h = get_header(p);
+        if (!h->m_heap) 
+            free(h);
+        else if (h->m_heap == g_thread_heap) 
+            h->m_heap->deallocate(p, size_class(h->m_size));
+        else 
+            h->m_heap->remote_free(p);
+    }
+
+    size_t sharded_usable_size(void* p) {
+        return get_header(p)->m_size;
+    }
+}
+
+void memory::deallocate(void * p) {
+    if (p == nullptr)
+        return;
+    size_t sz = sharded_usable_size(p);
+    g_memory_thread_alloc_size -= sz;
+    sharded_free(p);
+    if (g_memory_thread_alloc_size < -SYNCH_THRESHOLD) {
+        synchronize_counters(false);
+    }
+}
+
+void * memory::allocate(size_t s) {
+    g_memory_thread_alloc_size += s;
+    g_memory_thread_alloc_count += 1;
+    if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
+        synchronize_counters(true);
+    }
+    void * r = sharded_malloc(s);
+    if (r == nullptr) {
+        throw_out_of_memory();
+        return nullptr;
+    }
+    g_memory_thread_alloc_size += sharded_usable_size(r) - s;
+    return r;
+}
+
+void* memory::reallocate(void *p, size_t s) {
+    size_t sz = sharded_usable_size(p);
+    if (sz >= s)
+        return p;
+    g_memory_thread_alloc_size += s - sz;
+    g_memory_thread_alloc_count += 1;
+    if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
+        synchronize_counters(true);
+    }
+    void * r = sharded_malloc(s);
+    if (r == nullptr) {
+        throw_out_of_memory();
+        return nullptr;
+    }
+    memcpy(r, p, sz);
+    sharded_free(p);
+    g_memory_thread_alloc_size += sharded_usable_size(r) - s;
+    return r;
+}
+
+#else
+
 void memory::deallocate(void * p) {
 #ifdef HAS_MALLOC_USABLE_SIZE
     size_t sz      = malloc_usable_size(p);
@@ -347,6 +563,8 @@ void* memory::reallocate(void *p, size_t s) {
 #endif
 }
 
+#endif
+
 #else
 // ==================================
 // ==================================
@@ -355,6 +573,10 @@ void* memory::reallocate(void *p, size_t s) {
 // ==================================
 // allocate & deallocate without locking
 
+unsigned long long memory::get_thread_allocation_count() {
+    return g_memory_alloc_count;
+}
+
 void memory::deallocate(void * p) {
 #ifdef HAS_MALLOC_USABLE_SIZE
     size_t sz      = malloc_usable_size(p);
@@ -128,6 +128,40 @@ uint64_t u64_gcd(uint64_t u, uint64_t v) {
 
 
 
+static inline bool add_overflow(int64_t a, int64_t b, int64_t & r) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_add_overflow(a, b, &r);
+#else
+    if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b))
+        return true;
+    r = a + b;
+    return false;
+#endif
+}
+
+static inline bool sub_overflow(int64_t a, int64_t b, int64_t & r) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_sub_overflow(a, b, &r);
+#else
+    if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b))
+        return true;
+    r = a - b;
+    return false;
+#endif
+}
+
+static inline bool mul_overflow(int64_t a, int64_t b, int64_t & r) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_mul_overflow(a, b, &r);
+#else
+    // conservative: only products of 32-bit operands are computed directly.
+    if (a < INT_MIN || a > INT_MAX || b < INT_MIN || b > INT_MAX)
+        return true;
+    r = a * b;
+    return false;
+#endif
+}
+
 template<bool SYNCH>
 mpz_manager<SYNCH>::mpz_manager():
     m_allocator("mpz_manager") {
@@ -252,9 +286,13 @@ void mpz_manager<SYNCH>::del(mpz_manager<SYNCH>* m, mpz & a) {
 template<bool SYNCH>
 void mpz_manager<SYNCH>::add(mpz const & a, mpz const & b, mpz & c) {
     STRACE(mpz, tout << "[mpz] " << to_string(a) << " + " << to_string(b) << " == ";); 
+    int64_t x, y, r;
     if (is_small(a) && is_small(b)) {
         set_i64(c, i64(a) + i64(b));
     }
+    else if (get_i64_fast(a, x) && get_i64_fast(b, y) && !add_overflow(x, y, r)) {
+        set_i64(c, r);
+    }
     else {
         big_add(a, b, c);
     }
@@ -264,9 +302,13 @@ void mpz_manager<SYNCH>::add(mpz const & a, mpz const & b, mpz & c) {
 template<bool SYNCH>
 void mpz_manager<SYNCH>::sub(mpz const & a, mpz const & b, mpz & c) {
     STRACE(mpz, tout << "[mpz] " << to_string(a) << " - " << to_string(b) << " == ";); 
+    int64_t x, y, r;
     if (is_small(a) && is_small(b)) {
         set_i64(c, i64(a) - i64(b));
     }
+    else if (get_i64_fast(a, x) && get_i64_fast(b, y) && !sub_overflow(x, y, r)) {
+        set_i64(c, r);
+    }
     else {
         big_sub(a, b, c);
     }
@@ -508,9 +550,13 @@ void mpz_manager<SYNCH>::set_digits(mpz & target, unsigned sz, digit_t const * d
 template<bool SYNCH>
 void mpz_manager<SYNCH>::mul(mpz const & a, mpz const & b, mpz & c) {
     STRACE(mpz, tout << "[mpz] " << to_string(a) << " * " << to_string(b) << " == ";); 
+    int64_t x, y, r;
     if (is_small(a) && is_small(b)) {
         set_i64(c, i64(a) * i64(b));
     }
+    else if (get_i64_fast(a, x) && get_i64_fast(b, y) && !mul_overflow(x, y, r)) {
+        set_i64(c, r);
+    }
     else {
         big_mul(a, b, c);
     }
@@ -556,12 +602,17 @@ void mpz_manager<SYNCH>::submul(mpz const & a, mpz const & b, mpz const & c, mpz
 template<bool SYNCH>
 void mpz_manager<SYNCH>::machine_div_rem(mpz const & a, mpz const & b, mpz & q, mpz & r) {
     STRACE(mpz, tout << "[mpz-ext] divrem(" << to_string(a) << ",  " << to_string(b) << ") == ";); 
+    int64_t x, y;
     if (is_small(a) && is_small(b)) {
         int64_t _a = i64(a);
         int64_t _b = i64(b);
         set_i64(q, _a / _b);
         set_i64(r, _a % _b);
     }
+    else if (get_i64_fast(a, x) && get_i64_fast(b, y) && y != 0) {
+        set_i64(q, x / y);
+        set_i64(r, x % y);
+    }
     else {
         big_div_rem(a, b, q, r);
     }
@@ -574,8 +625,11 @@ void mpz_manager<SYNCH>::machine_div(mpz const & a, mpz const & b, mpz & c) {
     if (is_small(b) && i64(b) == 0)
         throw default_exception("division by 0"); 
 
+    int64_t x, y;
     if (is_small(a) && is_small(b)) 
         set_i64(c, i64(a) / i64(b));
+    else if (get_i64_fast(a, x) && get_i64_fast(b, y) && y != 0)
+        set_i64(c, x / y);
     else 
         big_div(a, b, c);
     STRACE(mpz, tout << to_string(c) << "\n";);
@@ -590,9 +644,13 @@ void mpz_manager<SYNCH>::reset(mpz & a) {
 template<bool SYNCH>
 void mpz_manager<SYNCH>::rem(mpz const & a, mpz const & b, mpz & c) {
     STRACE(mpz, tout << "[mpz-ext] rem(" << to_string(a) << ",  " << to_string(b) << ") == ";); 
+    int64_t x, y;
     if (is_small(a) && is_small(b)) {
         set_i64(c, i64(a) % i64(b));
     }
+    else if (get_i64_fast(a, x) && get_i64_fast(b, y) && y != 0) {
+        set_i64(c, x % y);
+    }
     else {
         big_rem(a, b, c);
     }
@@ -893,6 +951,9 @@ void mpz_manager<SYNCH>::gcd(mpz const & a, mpz const & b, mpz & c) {
         unsigned r = u_gcd(_a, _b);
         set(c, r);
     }
+    else if (int64_t x, y; get_i64_fast(a, x) && get_i64_fast(b, y)) {
+        set(c, u64_gcd(x < 0 ? -x : x, y < 0 ? -y : y));
+    }
     else {
 #ifdef _MP_GMP
         ensure_mpz_t a1(a), b1(b);
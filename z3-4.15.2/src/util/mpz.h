@@ -256,6 +256,34 @@ class mpz_manager {
 
     static int64_t i64(mpz const & a) { return static_cast<int64_t>(a.value()); }
 
+    /**
+       \brief Store the value of \c a in \c v if \c a is small or a cell of
+       at most 64 bits whose magnitude is below 2^63. Operations on such
+       values use machine arithmetic with overflow checks before falling
+       back to the multi-precision algorithms.
+    */
+    bool get_i64_fast(mpz const & a, int64_t & v) const {
+        if (is_small(a)) {
+            v = a.m_val;
+            return true;
+        }
+#ifndef _MP_GMP
+        static_assert(sizeof(digit_t) == sizeof(uint32_t), "digit size");
+        unsigned sz = size(a);
+        if (sz > 2)
+            return false;
+        uint64_t u = digits(a)[0];
+        if (sz == 2)
+            u |= static_cast<uint64_t>(digits(a)[1]) << 32;
+        if (u > static_cast<uint64_t>(INT64_MAX))
+            return false;
+        v = a.m_val < 0 ? -static_cast<int64_t>(u) : static_cast<int64_t>(u);
+        return true;
+#else
+        return false;
+#endif
+    }
+
     void set_big_i64(mpz & c, int64_t v);
 
     void set_i64(mpz & c, int64_t v) {
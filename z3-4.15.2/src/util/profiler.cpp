@@ -0,0 +1,164 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    profiler.cpp
+
+Abstract:
+
+    Hierarchical profiling of solver phases.
+
+--*/
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "util/profiler.h"
+#include "util/debug.h"
+#include "util/memory_manager.h"
+#include "util/warning.h"
+
+atomic<bool> g_profiling(false);
+
+namespace {
+
+    typedef std::chrono::steady_clock profile_clock;
+
+    // A call path. Nodes are allocated outside of the memory manager so
+    // that the profiler neither counts its own allocations nor depends on
+    // the manager being initialized when a thread exits.
+    struct profile_node {
+        std::string                                m_name;
+        profile_node *                             m_parent = nullptr;
+        std::vector<std::unique_ptr<profile_node>> m_children;
+        unsigned long long                         m_nanos  = 0;
+        unsigned long long                         m_allocs = 0;
+        // start of the call that is in progress.
+        profile_clock::time_point                  m_start;
+        unsigned long long                         m_start_allocs = 0;
+
+        profile_node * child(char const * name) {
+            for (auto & c : m_children)
+                if (c->m_name == name)
+                    return c.get();
+            m_children.push_back(std::make_unique<profile_node>());
+            profile_node * c = m_children.back().get();
+            c->m_name   = name;
+            c->m_parent = this;
+            return c;
+        }
+
+        void merge(profile_node const & other) {
+            m_nanos  += other.m_nanos;
+            m_allocs += other.m_allocs;
+            for (auto const & c : other.m_children)
+                child(c->m_name.c_str())->merge(*c);
+        }
+
+        // keeps the nodes, since some of them can be on the call stack.
+        void reset() {
+            m_nanos  = 0;
+            m_allocs = 0;
+            for (auto & c : m_children)
+                c->reset();
+        }
+    };
+
+    struct thread_profile;
+
+    mutex                         g_profile_mux;
+    std::string                   g_profile_file;
+    bool                          g_profile_allocations = false;
+    // call trees of threads that terminated.
+    profile_node                  g_finished;
+    std::vector<thread_profile *> g_threads;
+
+    struct thread_profile {
+        profile_node   m_root;
+        profile_node * m_curr = &m_root;
+
+        thread_profile() {
+            lock_guard lock(g_profile_mux);
+            g_threads.push_back(this);
+        }
+
+        ~thread_profile() {
+            lock_guard lock(g_profile_mux);
+            g_finished.merge(m_root);
+            std::erase(g_threads, this);
+        }
+    };
+
+    thread_local thread_profile g_thread_profile;
+
+    void display_folded(std::ostream & out, profile_node const & n, std::string const & path, bool allocations) {
+        unsigned long long self = allocations ? n.m_allocs : n.m_nanos;
+        for (auto const & c : n.m_children)
+            self -= std::min(self, allocations ? c->m_allocs : c->m_nanos);
+        if (!allocations)
+            self /= 1000;
+        if (self > 0)
+            out << path << " " << self << "\n";
+        for (auto const & c : n.m_children)
+            display_folded(out, *c, path + ";" + c->m_name, allocations);
+    }
+
+    void flush_profile_core() {
+        if (g_profile_file.empty())
+            return;
+        profile_node all;
+        all.merge(g_finished);
+        for (thread_profile * tp : g_threads)
+            all.merge(tp->m_root);
+        std::ofstream out(g_profile_file);
+        if (!out) {
+            warning_msg("could not open profile file '%s'", g_profile_file.c_str());
+            return;
+        }
+        for (auto const & c : all.m_children)
+            display_folded(out, *c, c->m_name, g_profile_allocations);
+    }
+}
+
+void set_profile_file(char const * file, bool allocations) {
+    std::string f(file ? file : "");
+    lock_guard lock(g_profile_mux);
+    if (f == g_profile_file && allocations == g_profile_allocations)
+        return;
+    flush_profile_core();
+    g_finished.m_children.clear();
+    for (thread_profile * tp : g_threads)
+        tp->m_root.reset();
+    g_profile_file        = f;
+    g_profile_allocations = allocations;
+    g_profiling           = !f.empty();
+}
+
+void flush_profile() {
+    lock_guard lock(g_profile_mux);
+    flush_profile_core();
+}
+
+void finalize_profile() {
+    flush_profile();
+}
+
+void profile_enter(char const * name) {
+    thread_profile & tp = g_thread_profile;
+    profile_node * n = tp.m_curr->child(name);
+    tp.m_curr = n;
+    n->m_start_allocs = memory::get_thread_allocation_count();
+    n->m_start = profile_clock::now();
+}
+
+void profile_leave() {
+    thread_profile & tp = g_thread_profile;
+    profile_node * n = tp.m_curr;
+    SASSERT(n->m_parent);
+    n->m_nanos  += std::chrono::duration_cast<std::chrono::nanoseconds>(profile_clock::now() - n->m_start).count();
+    n->m_allocs += memory::get_thread_allocation_count() - n->m_start_allocs;
+    tp.m_curr = n->m_parent;
+}
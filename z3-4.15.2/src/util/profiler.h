@@ -0,0 +1,66 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    profiler.h
+
+Abstract:
+
+    Hierarchical profiling of solver phases.
+
+    A scoped_profile marks a phase. While profiling is enabled, each
+    thread records a call tree of the phases it enters, with the time
+    spent in each phase and the number of allocations made in it.
+    The trees of all threads are merged and written in folded-stack
+    format: one line per call path followed by its self time in
+    microseconds, or by its self allocation count. Flamegraph tools
+    read this format directly.
+
+    Profiling is enabled by setting the global parameter profile.file.
+    Disabled, a scoped_profile costs a load and a branch.
+
+--*/
+#pragma once
+
+#include "util/mutex.h"
+
+extern atomic<bool> g_profiling;
+
+inline bool is_profiling() { return g_profiling; }
+
+/**
+   \brief Start profiling into the given file, or stop profiling if it is
+   empty. A profile collected into another file is written and discarded
+   first. When allocations is set, call paths are weighted by allocation
+   counts instead of time.
+*/
+void set_profile_file(char const * file, bool allocations = false);
+
+/**
+   \brief Write the profile collected so far.
+   Other threads must not be in a profiled phase during the call.
+*/
+void flush_profile();
+
+void finalize_profile();
+/*
+  ADD_FINALIZER('finalize_profile();')
+*/
+
+void profile_enter(char const * name);
+
+void profile_leave();
+
+class scoped_profile {
+    bool m_active;
+public:
+    scoped_profile(char const * name): m_active(is_profiling()) {
+        if (m_active)
+            profile_enter(name);
+    }
+    ~scoped_profile() {
+        if (m_active)
+            profile_leave();
+    }
+};
@@ -74,6 +74,15 @@ void small_object_allocator::reset() {
 
 
 void small_object_allocator::deallocate(size_t size, void * p) {
+    if (m_mux) {
+        lock_guard lock(*m_mux);
+        deallocate_core(size, p);
+    }
+    else
+        deallocate_core(size, p);
+}
+
+void small_object_allocator::deallocate_core(size_t size, void * p) {
     if (size == 0) return;
 
 #if defined(Z3DEBUG) && !defined(_WINDOWS)
@@ -99,6 +108,14 @@ void small_object_allocator::deallocate(size_t size, void * p) {
 
 
 void * small_object_allocator::allocate(size_t size) {
+    if (m_mux) {
+        lock_guard lock(*m_mux);
+        return allocate_core(size);
+    }
+    return allocate_core(size);
+}
+
+void * small_object_allocator::allocate_core(size_t size) {
     if (size == 0) 
         return nullptr;
 
@@ -22,6 +22,7 @@ Revision History:
 #include "util/machine.h"
 #include "util/debug.h"
 #include "util/trace.h"
+#include "util/mutex.h"
 
 class small_object_allocator {
     static const unsigned CHUNK_SIZE     = (8192 - sizeof(void*)*2);
@@ -35,9 +36,12 @@ class small_object_allocator {
     chunk *     m_chunks[NUM_SLOTS];
     void  *     m_free_list[NUM_SLOTS];
     size_t      m_alloc_size;
+    mutex *     m_mux = nullptr;
 #ifdef Z3DEBUG
     char const * m_id;
 #endif
+    void * allocate_core(size_t size);
+    void deallocate_core(size_t size, void * p);
 public:
     small_object_allocator(char const * id = "unknown");
     ~small_object_allocator();
@@ -48,6 +52,11 @@ public:
     size_t get_wasted_size() const;
     size_t get_num_free_objs() const;
     void consolidate();
+    /**
+       \brief Serialize allocate and deallocate on the given mutex.
+       Passing nullptr restores unsynchronized operation.
+    */
+    void set_mutex(mutex * mux) { m_mux = mux; }
 };
 
 inline void * operator new(size_t s, small_object_allocator & r) { return r.allocate(s); }